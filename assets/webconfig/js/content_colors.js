@@ -2,6 +2,7 @@ $(document).ready( function() {
 	performTranslation();
 	var editor_color = null;
 	var editor_smoothing = null;
+	var editor_output = null;
 	var editor_blackborder = null;
 	
 	if(window.showOptHelp)
@@ -16,6 +17,14 @@ $(document).ready( function() {
 		$('#conf_cont_smoothing').append(createOptPanel('fa-photo', $.i18n("edt_conf_smooth_heading_title"), 'editor_container_smoothing', 'btn_submit_smoothing'));
 		$('#conf_cont_smoothing').append(createHelpTable(window.schema.smoothing.properties, $.i18n("edt_conf_smooth_heading_title")));
 		
+		//output
+		if(storedAccess != 'default')
+		{
+			$('#conf_cont').append(createRow('conf_cont_output'));
+			$('#conf_cont_output').append(createOptPanel('fa-clock-o', $.i18n("edt_conf_output_heading_title"), 'editor_container_output', 'btn_submit_output'));
+			$('#conf_cont_output').append(createHelpTable(window.schema.output.properties, $.i18n("edt_conf_output_heading_title")));
+		}
+		
 		//blackborder
 		$('#conf_cont').append(createRow('conf_cont_blackborder'));
 		$('#conf_cont_blackborder').append(createOptPanel('fa-photo', $.i18n("edt_conf_bb_heading_title"), 'editor_container_blackborder', 'btn_submit_blackborder'));
@@ -26,6 +35,8 @@ $(document).ready( function() {
 		$('#conf_cont').addClass('row');
 		$('#conf_cont').append(createOptPanel('fa-photo', $.i18n("edt_conf_color_heading_title"), 'editor_container_color', 'btn_submit_color'));
 		$('#conf_cont').append(createOptPanel('fa-photo', $.i18n("edt_conf_smooth_heading_title"), 'editor_container_smoothing', 'btn_submit_smoothing'));
+		if(storedAccess != 'default')
+			$('#conf_cont').append(createOptPanel('fa-clock-o', $.i18n("edt_conf_output_heading_title"), 'editor_container_output', 'btn_submit_output'));
 		$('#conf_cont').append(createOptPanel('fa-photo', $.i18n("edt_conf_bb_heading_title"), 'editor_container_blackborder', 'btn_submit_blackborder'));
 	}
 	
@@ -55,6 +66,22 @@ $(document).ready( function() {
 		requestWriteConfig(editor_smoothing.getValue());
 	});
 
+	//output
+	if(storedAccess != 'default')
+	{
+		editor_output = createJsonEditor('editor_container_output', {
+			output             : window.schema.output
+		}, true, true);
+
+		editor_output.on('change',function() {
+			editor_output.validate().length ? $('#btn_submit_output').attr('disabled', true) : $('#btn_submit_output').attr('disabled', false);
+		});
+
+		$('#btn_submit_output').off().on('click',function() {
+			requestWriteConfig(editor_output.getValue());
+		});
+	}
+
 	//blackborder
 	editor_blackborder = createJsonEditor('editor_container_blackborder', {
 		blackborderdetector: window.schema.blackborderdetector
@@ -76,6 +103,8 @@ $(document).ready( function() {
 	{
 		createHint("intro", $.i18n('conf_colors_color_intro'), "editor_container_color");
 		createHint("intro", $.i18n('conf_colors_smoothing_intro'), "editor_container_smoothing");
+		if(storedAccess != 'default')
+			createHint("intro", $.i18n('conf_colors_output_intro'), "editor_container_output");
 		createHint("intro", $.i18n('conf_colors_blackborder_intro'), "editor_container_blackborder");
 	}
 	
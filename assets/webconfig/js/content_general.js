@@ -25,6 +25,26 @@ $(document).ready( function() {
 		requestWriteConfig(conf_editor.getValue());
 	});
 
+	// thread scheduling
+	if(storedAccess == 'expert')
+	{
+		$('#conf_cont').append(createOptPanel('fa-tachometer', $.i18n("edt_conf_sched_heading_title"), 'editor_container_sched', 'btn_submit_sched'));
+		if(window.showOptHelp)
+			$('#conf_cont').append(createHelpTable(window.schema.scheduling.properties, $.i18n("edt_conf_sched_heading_title")));
+
+		var conf_editor_sched = createJsonEditor('editor_container_sched', {
+			scheduling: window.schema.scheduling
+		}, true, true);
+
+		conf_editor_sched.on('change',function() {
+			conf_editor_sched.validate().length ? $('#btn_submit_sched').attr('disabled', true) : $('#btn_submit_sched').attr('disabled', false);
+		});
+
+		$('#btn_submit_sched').off().on('click',function() {
+			requestWriteConfig(conf_editor_sched.getValue());
+		});
+	}
+
 	// Instance handling
 	function handleInstanceRename(e)
 	{
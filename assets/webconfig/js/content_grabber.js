@@ -3,6 +3,7 @@ $(document).ready( function() {
 	var conf_editor_v4l2 = null;
 	var conf_editor_fg = null;
 	var conf_editor_instCapt = null;
+	var conf_editor_gov = null;
 
 	function hideEl(el)
 	{
@@ -28,6 +29,14 @@ $(document).ready( function() {
 		$('#conf_cont').append(createRow('conf_cont_v4l'));
 		$('#conf_cont_v4l').append(createOptPanel('fa-camera', $.i18n("edt_conf_v4l2_heading_title"), 'editor_container_v4l2', 'btn_submit_v4l2'));
 		$('#conf_cont_v4l').append(createHelpTable(window.schema.grabberV4L2.properties, $.i18n("edt_conf_v4l2_heading_title")));
+
+		//governor
+		if(storedAccess != 'default')
+		{
+			$('#conf_cont').append(createRow('conf_cont_gov'));
+			$('#conf_cont_gov').append(createOptPanel('fa-tachometer', $.i18n("edt_conf_gov_heading_title"), 'editor_container_gov', 'btn_submit_gov'));
+			$('#conf_cont_gov').append(createHelpTable(window.schema.captureGovernor.properties, $.i18n("edt_conf_gov_heading_title")));
+		}
 	}
 	else
 	{
@@ -35,6 +44,8 @@ $(document).ready( function() {
 		$('#conf_cont').append(createOptPanel('fa-camera', $.i18n("edt_conf_instCapture_heading_title"), 'editor_container_instCapt', 'btn_submit_instCapt'));
 		$('#conf_cont').append(createOptPanel('fa-camera', $.i18n("edt_conf_fg_heading_title"), 'editor_container_fg', 'btn_submit_fg'));
 		$('#conf_cont').append(createOptPanel('fa-camera', $.i18n("edt_conf_v4l2_heading_title"), 'editor_container_v4l2', 'btn_submit_v4l2'));
+		if(storedAccess != 'default')
+			$('#conf_cont').append(createOptPanel('fa-tachometer', $.i18n("edt_conf_gov_heading_title"), 'editor_container_gov', 'btn_submit_gov'));
 	}
 	//instCapt
 	conf_editor_instCapt = createJsonEditor('editor_container_instCapt', {
@@ -76,6 +87,22 @@ $(document).ready( function() {
 		requestWriteConfig(conf_editor_v4l2.getValue());
 	});
 
+	//governor
+	if(storedAccess != 'default')
+	{
+		conf_editor_gov = createJsonEditor('editor_container_gov', {
+			captureGovernor : window.schema.captureGovernor
+		}, true, true);
+
+		conf_editor_gov.on('change',function() {
+			conf_editor_gov.validate().length ? $('#btn_submit_gov').attr('disabled', true) : $('#btn_submit_gov').attr('disabled', false);
+		});
+
+		$('#btn_submit_gov').off().on('click',function() {
+			requestWriteConfig(conf_editor_gov.getValue());
+		});
+	}
+
 	//create introduction
 	if(window.showOptHelp)
 	{
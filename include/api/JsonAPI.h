@@ -10,6 +10,7 @@
 #include <QJsonObject>
 #include <QMutex>
 #include <QString>
+#include <QStringList>
 
 // HyperionInstanceManager
 #include <hyperion/HyperionIManager.h>
@@ -33,6 +34,7 @@ public:
 	/// @param noListener  if true, this instance won't listen for hyperion push events
 	///
 	JsonAPI(QString peerAddress, Logger* log, const bool& localConnection, QObject* parent, bool noListener = false);
+	~JsonAPI();
 
 	///
 	/// Handle an incoming JSON message
@@ -41,6 +43,14 @@ public:
 	///
 	void handleMessage(const QString & message, const QString& httpAuthHeader = "");
 
+	///
+	/// Handle an incoming JSON message in its raw form. Image commands are decoded from it directly,
+	/// all other messages are handled like the string form
+	///
+	/// @param message the incoming message as UTF-8 data
+	///
+	void handleMessage(const QByteArray & message, const QString& httpAuthHeader = "");
+
 public slots:
 	///
 	/// @brief is called whenever the current Hyperion instance pushes new led raw values (if enabled)
@@ -80,12 +90,25 @@ private slots:
 	///
 	void handleInstanceStateChange(const instanceState& state, const quint8& instance, const QString& name = QString());
 
+	///
+	/// @brief Forward the updates of the subscription hub this client subscribed for
+	/// @param command  The subscription command of the message
+	/// @param data     The serialized message
+	///
+	void handleSubscriptionCallback(const QString& command, const QByteArray& data);
+
 signals:
 	///
 	/// Signal emits with the reply message provided with handleMessage()
 	///
 	void callbackMessage(QJsonObject);
 
+	///
+	/// Signal emits with a serialized subscription update (compact json terminated by a newline).
+	/// The buffer is shared by all clients subscribed to the same update
+	///
+	void callbackData(const QByteArray& data);
+
 	///
 	/// Signal emits whenever a jsonmessage should be forwarded
 	///
@@ -117,9 +140,15 @@ private:
 	/// Hyperion instance
 	Hyperion* _hyperion;
 
-	// The JsonCB instance which handles data subscription/notifications
+	/// The buffer of received images, reused for every image command
+	Image<ColorRgb> _imageBuffer;
+
+	// The JsonCB hub which handles data subscription/notifications, shared with other clients
 	JsonCB* _jsonCB;
 
+	/// The subscriptions of this client
+	QStringList _subscribedCommands;
+
 	// streaming buffers
 	QJsonObject _streaming_leds_reply;
 	QJsonObject _streaming_image_reply;
@@ -162,6 +191,16 @@ private:
 	///
 	void handleImageCommand(const QJsonObject & message, const QString &command, const int tan);
 
+	///
+	/// Set the image buffer as input of the priority and send the reply
+	///
+	/// @param priority  The priority
+	/// @param duration  The duration in ms, -1 for endless
+	/// @param command   The command to reply to
+	/// @param tan       The tan of the command
+	///
+	void setImageInput(const int priority, const int duration, const QString& command, const int tan);
+
 	///
 	/// Handle an incoming JSON Effect message
 	///
@@ -3,6 +3,9 @@
 // qt incl
 #include <QObject>
 #include <QJsonObject>
+#include <QByteArray>
+#include <QMap>
+#include <QStringList>
 
 // components def
 #include <utils/Components.h>
@@ -18,36 +21,57 @@ class ComponentRegister;
 class BonjourBrowserWrapper;
 class PriorityMuxer;
 
+///
+/// @brief The subscription hub of a Hyperion instance. It's shared by all clients (JsonAPI) of a thread which are
+///        connected to the instance, so each update is built and serialized once and the same buffer is handed to
+///        every client. The clients filter the updates by their own subscriptions
+///
 class JsonCB : public QObject
 {
 	Q_OBJECT
 
 public:
-	JsonCB(Hyperion* hyperion, QObject* parent);
+	///
+	/// @brief Get the hub of a Hyperion instance for the calling thread, it's created with the first client
+	/// @param hyperion  The Hyperion instance
+	/// @return          The hub, give it back with release()
+	///
+	static JsonCB* acquire(Hyperion* hyperion);
+
+	///
+	/// @brief Give back a hub together with the subscriptions of the client, it's deleted with the last client
+	/// @param hub            The hub returned by acquire()
+	/// @param subscriptions  The commands the client has subscribed for
+	///
+	static void release(JsonCB* hub, const QStringList& subscriptions);
 
 	///
-	/// @brief Subscribe to future data updates given by cmd
+	/// @brief Subscribe to future data updates given by cmd, the updates are built for all clients of the hub as long as
+	///        one of them is subscribed. A client subscribes only once for each command
 	/// @param cmd   The cmd which will be subscribed for
 	/// @return      True on success, false if not found
 	///
 	bool subscribeFor(const QString& cmd);
 
 	///
-	/// @brief Get all possible commands to subscribe for
-	/// @return  The list of commands
+	/// @brief Remove a subscription of subscribeFor(), the updates aren't built anymore once the last subscriber is gone
+	/// @param cmd   The cmd which has been subscribed for
 	///
-	QStringList getCommands() { return _availableCommands; };
+	void unsubscribeFor(const QString& cmd);
+
 	///
-	/// @brief Get all subscribed commands
+	/// @brief Get all possible commands to subscribe for
 	/// @return  The list of commands
 	///
-	QStringList getSubscribedCommands() { return _subscribedCommands; };
+	static QStringList getCommands();
+
 signals:
 	///
 	/// @brief Emits whenever a new json mesage callback is ready to send
-	/// @param The JsonObject message
+	/// @param command  The subscription command of the message
+	/// @param data     The serialized message (compact json terminated by a newline), shared by all clients
 	///
-	void newCallback(QJsonObject);
+	void newCallback(const QString& command, const QByteArray& data);
 
 private slots:
 	///
@@ -107,6 +131,24 @@ private slots:
 	void handleInstanceChange();
 
 private:
+	JsonCB(Hyperion* hyperion);
+
+	///
+	/// @brief Connect or disconnect the signal which triggers the updates of a command
+	/// @param cmd     The command
+	/// @param enable  True to connect, false to disconnect
+	///
+	void connectUpdates(const QString& cmd, const bool& enable);
+
+	template <typename Sender, typename Signal, typename Slot>
+	void connectUpdate(const Sender* sender, Signal signal, Slot slot, const bool& enable)
+	{
+		if(enable)
+			connect(sender, signal, this, slot, Qt::UniqueConnection);
+		else
+			disconnect(sender, signal, this, slot);
+	}
+
 	/// pointer of Hyperion instance
 	Hyperion* _hyperion;
 	/// pointer of comp register
@@ -115,10 +157,10 @@ private:
 	BonjourBrowserWrapper* _bonjour;
 	/// priority muxer instance
 	PriorityMuxer* _prioMuxer;
-	/// contains all available commands
-	QStringList _availableCommands;
-	/// contains active subscriptions
-	QStringList _subscribedCommands;
+	/// count of the clients which share this hub
+	int _clients;
+	/// count of the clients per subscribed command
+	QMap<QString, int> _subscribers;
 	/// construct callback msg
 	void doCallback(const QString& cmd, const QVariant& data);
 };
@@ -3,6 +3,8 @@
 
 // Utils includes
 #include <utils/Image.h>
+#include <utils/ImageView.h>
+#include <utils/ImageReduce.h>
 
 namespace hyperion
 {
@@ -64,8 +66,8 @@ namespace hyperion
 
 		///
 		/// default detection mode (3lines 4side detection)
-		template <typename Pixel_T>
-		BlackBorder process(const Image<Pixel_T> & image)
+		template <typename Image_T>
+		BlackBorder process(const Image_T & image)
 		{
 			// test center and 33%, 66% of width/heigth
 			// 33 and 66 will check left and top
@@ -86,28 +88,22 @@ namespace hyperion
 			width--; // remove 1 pixel to get end pixel index
 			height--;
 
-			// find first X pixel of the image
-			for (int x = 0; x < width33percent; ++x)
+			// find first X pixel of the image, each line is only searched up to the first hit of the previous ones
+			int x = firstNonBlack(image, width, yCenter, -1, 0, width33percent);
+			x = firstNonBlack(image, 0, height33percent, 1, 0, x);
+			x = firstNonBlack(image, 0, height66percent, 1, 0, x);
+			if (x < width33percent)
 			{
-				if (!isBlack(image((width - x), yCenter))
-					|| !isBlack(image(x, height33percent))
-				 	|| !isBlack(image(x, height66percent)))
-				{
-					firstNonBlackXPixelIndex = x;
-					break;
-				}
+				firstNonBlackXPixelIndex = x;
 			}
 
 			// find first Y pixel of the image
-			for (int y = 0; y < height33percent; ++y)
+			int y = firstNonBlack(image, xCenter, height, 0, -1, height33percent);
+			y = firstNonBlack(image, width33percent, 0, 0, 1, y);
+			y = firstNonBlack(image, width66percent, 0, 0, 1, y);
+			if (y < height33percent)
 			{
-				if (!isBlack(image(xCenter, (height - y)))
-					|| !isBlack(image(width33percent, y)) 
-					|| !isBlack(image(width66percent, y)))
-				{
-					firstNonBlackYPixelIndex = y;
-					break;
-				}
+				firstNonBlackYPixelIndex = y;
 			}
 
 			// Construct result
@@ -121,8 +117,8 @@ namespace hyperion
 
 		///
 		/// classic detection mode (topleft single line mode)
-		template <typename Pixel_T>
-		BlackBorder process_classic(const Image<Pixel_T> & image)
+		template <typename Image_T>
+		BlackBorder process_classic(const Image_T & image)
 		{
 			// only test the topleft third of the image
 			int width = image.width() /3;
@@ -138,7 +134,7 @@ namespace hyperion
 				int x = std::min(i, width);
 				int y = std::min(i, height);
 
-				const Pixel_T & color = image(x, y);
+				const auto & color = image(x, y);
 				if (!isBlack(color))
 				{
 					firstNonBlackXPixelIndex = x;
@@ -150,7 +146,7 @@ namespace hyperion
 			// expand image to the left
 			for(; firstNonBlackXPixelIndex > 0; --firstNonBlackXPixelIndex)
 			{
-				const Pixel_T & color = image(firstNonBlackXPixelIndex-1, firstNonBlackYPixelIndex);
+				const auto & color = image(firstNonBlackXPixelIndex-1, firstNonBlackYPixelIndex);
 				if (isBlack(color))
 				{
 					break;
@@ -160,7 +156,7 @@ namespace hyperion
 			// expand image to the top
 			for(; firstNonBlackYPixelIndex > 0; --firstNonBlackYPixelIndex)
 			{
-				const Pixel_T & color = image(firstNonBlackXPixelIndex, firstNonBlackYPixelIndex-1);
+				const auto & color = image(firstNonBlackXPixelIndex, firstNonBlackYPixelIndex-1);
 				if (isBlack(color))
 				{
 					break;
@@ -178,8 +174,8 @@ namespace hyperion
 
 		///
 		/// osd detection mode (find x then y at detected x to avoid changes by osd overlays)
-		template <typename Pixel_T>
-		BlackBorder process_osd(const Image<Pixel_T> & image)
+		template <typename Image_T>
+		BlackBorder process_osd(const Image_T & image)
 		{
 			// find X position at height33 and height66 we check from the left side, Ycenter will check from right side
 			// then we try to find a pixel at this X position from top and bottom and right side from top
@@ -197,32 +193,24 @@ namespace hyperion
 			width--; // remove 1 pixel to get end pixel index
 			height--;
 
-			// find first X pixel of the image
-			int x;
-			for (x = 0; x < width33percent; ++x)
+			// find first X pixel of the image, each line is only searched up to the first hit of the previous ones
+			int x = firstNonBlack(image, width, yCenter, -1, 0, width33percent);
+			x = firstNonBlack(image, 0, height33percent, 1, 0, x);
+			x = firstNonBlack(image, 0, height66percent, 1, 0, x);
+			if (x < width33percent)
 			{
-				if (!isBlack(image((width - x), yCenter)) 
-					|| !isBlack(image(x, height33percent))
-					|| !isBlack(image(x, height66percent)))
-				{
-					firstNonBlackXPixelIndex = x;
-					break;
-				}
+				firstNonBlackXPixelIndex = x;
 			}
 
 			// find first Y pixel of the image
-			for (int y = 0; y < height33percent; ++y)
+			// left side top + left side bottom + right side top  +  right side bottom
+			int y = firstNonBlack(image, x, 0, 0, 1, height33percent);
+			y = firstNonBlack(image, x, height, 0, -1, y);
+			y = firstNonBlack(image, width - x, 0, 0, 1, y);
+			y = firstNonBlack(image, width - x, height, 0, -1, y);
+			if (y < height33percent)
 			{
-				// left side top + left side bottom + right side top  +  right side bottom
-				if (!isBlack(image(x, y)) 
-					|| !isBlack(image(x, (height - y)))
-					|| !isBlack(image((width - x), y)) 
-					|| !isBlack(image((width - x), (height - y))))
-				{
-//					std::cout << "y " << y << " lt " << int(isBlack(color1)) << " lb " << int(isBlack(color2)) << " rt " << int(isBlack(color3)) << " rb " << int(isBlack(color4)) << std::endl;
-					firstNonBlackYPixelIndex = y;
-					break;
-				}
+				firstNonBlackYPixelIndex = y;
 			}
 
 			// Construct result
@@ -237,6 +225,31 @@ namespace hyperion
 
 	private:
 
+		///
+		/// Finds the first non black pixel along a row (dx = +-1) or a column (dy = +-1)
+		///
+		/// @param[in] image  The image to search
+		/// @param[in] x      The x index of the first pixel
+		/// @param[in] y      The y index of the first pixel
+		/// @param[in] dx     The direction along a row
+		/// @param[in] dy     The direction along a column
+		/// @param[in] count  The number of pixels to check
+		///
+		/// @return The index of the first non black pixel along the line, count if there is none
+		///
+		template <typename Image_T>
+		int firstNonBlack(const Image_T & image, int x, int y, int dx, int dy, int count) const
+		{
+			if (count <= 0)
+			{
+				return count;
+			}
+
+			const auto & first = image(x, y);
+			const ptrdiff_t step = dx * ptrdiff_t(sizeof(first)) + dy * ptrdiff_t(image.stride());
+			return ImageReduce::firstNonBlack(&first, count, step, _blackborderThreshold);
+		}
+
 		///
 		/// Checks if a given color is considered black and therefor could be part of the border.
 		///
@@ -56,12 +56,12 @@ namespace hyperion
 		/// updates the current border accordingly. If the current border is updated the method call
 		/// will return true else false
 		///
-		/// @param image The image to process
+		/// @param image The image to process, an Image or an ImageView
 		///
 		/// @return True if a different border was detected than the current else false
 		///
-		template <typename Pixel_T>
-		bool process(const Image<Pixel_T> & image)
+		template <typename Image_T>
+		bool process(const Image_T & image)
 		{
 			// get the border for the single image
 			BlackBorder imageBorder;
@@ -117,6 +117,25 @@ public:
 	///
 	bool deleteTable(const QString& table) const;
 
+	///
+	/// @brief Start a transaction on the database connection of the calling thread.
+	///        Batch multiple write actions between startTransaction() and commitTransaction() to persist them at once
+	/// @return             True on success else false
+	///
+	bool startTransaction() const;
+
+	///
+	/// @brief Commit the transaction started with startTransaction()
+	/// @return             True on success else false
+	///
+	bool commitTransaction() const;
+
+	///
+	/// @brief Rollback the transaction started with startTransaction()
+	/// @return             True on success else false
+	///
+	bool rollbackTransaction() const;
+
 private:
 
 	Logger* _log;
@@ -127,4 +146,12 @@ private:
 
 	/// addBindValue to query given by QVariantList
 	void doAddBindValue(QSqlQuery& query, const QVariantList& variants) const;
+
+	///
+	/// @brief Get a prepared query for the given statement. Prepared queries are cached per thread (like the database connection) and reused on subsequent calls
+	/// @param[in]  statement  The SQL statement with placeholders
+	/// @param[out] query      The prepared query
+	/// @return                True on success else false
+	///
+	bool getPreparedQuery(const QString& statement, QSqlQuery& query) const;
 };
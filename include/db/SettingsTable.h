@@ -78,23 +78,6 @@ public:
 		return QJsonDocument::fromJson(results["config"].toByteArray());
 	}
 
-	///
-	/// @brief Get 'config' column of settings entry as QString
-	/// @param[in]  type   The settings type
-	/// @return            The QString
-	///
-	inline QString getSettingsRecordString(const QString& type) const
-	{
-		QVariantMap results;
-		VectorPair cond;
-		cond.append(CPair("type",type));
-		// when a setting is not global we are searching also for the instance
-		if(!isSettingGlobal(type))
-			cond.append(CPair("AND hyperion_inst",_hyperion_inst));
-		getRecord(cond, results, QStringList("config"));
-		return results["config"].toString();
-	}
-
 	///
 	/// @brief Delete all settings entries associated with this instance, called from InstanceTable of HyperionIManager
 	///
@@ -108,13 +91,13 @@ public:
 	inline bool isSettingGlobal(const QString& type) const
 	{
 		// list of global settings
-		QStringList list;
+		static const QStringList list = QStringList()
 		// server port services
-		list << "jsonServer" << "protoServer" << "flatbufServer" << "forwarder" << "webConfig" << "network"
+		<< "jsonServer" << "protoServer" << "flatbufServer" << "forwarder" << "webConfig" << "network"
 		// capture
-		<< "framegrabber" << "grabberV4L2"
+		<< "framegrabber" << "grabberV4L2" << "captureGovernor"
 		// other
-		<< "logger" << "general";
+		<< "logger" << "general" << "scheduling";
 
 		return list.contains(type);
 	}
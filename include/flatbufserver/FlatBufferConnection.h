@@ -7,12 +7,15 @@
 #include <QTcpSocket>
 #include <QTimer>
 #include <QMap>
+#include <QSize>
+#include <QElapsedTimer>
 
 // hyperion util
 #include <utils/Image.h>
 #include <utils/ColorRgb.h>
 #include <utils/VideoMode.h>
 #include <utils/Logger.h>
+#include <utils/ImageResampler.h>
 
 // flatbuffer FBS
 #include "hyperion_reply_generated.h"
@@ -76,7 +79,8 @@ public:
 
 public slots:
 	///
-	/// @brief Set the leds according to the given image
+	/// @brief Set the leds according to the given image. When the server asked for an image size and frame rate,
+	/// the image is downscaled to it and frames above the rate are skipped
 	/// @param image The image
 	///
 	void setImage(const Image<ColorRgb> &image);
@@ -108,6 +112,12 @@ private:
 	///
 	bool parseReply(const hyperionnet::Reply *reply);
 
+	///
+	/// @brief Send an image as it is
+	/// @param image The image
+	///
+	void sendImage(const Image<ColorRgb> &image);
+
 private:
 	/// The TCP-Socket with the connection to the server
 	QTcpSocket _socket;
@@ -131,4 +141,16 @@ private:
 	flatbuffers::FlatBufferBuilder _builder;
 
 	bool _registered;
+
+	/// the image size and frame rate the server asked for with the registration, invalid or 0 if there are none
+	QSize _targetSize;
+	int _targetFps;
+
+	/// the time the next frame is due at the target frame rate
+	QElapsedTimer _frameClock;
+	qint64 _nextFrameTime;
+
+	/// downscales the images to the target size
+	ImageResampler _resampler;
+	Image<ColorRgb> _scaledImage;
 };
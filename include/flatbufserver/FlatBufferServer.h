@@ -6,6 +6,7 @@
 
 // qt
 #include <QVector>
+#include <QSize>
 
 class QTcpServer;
 class FlatBufferClient;
@@ -33,6 +34,13 @@ public slots:
 
 	void initServer();
 
+	///
+	/// @brief Set the image size and frame rate the clients are asked for, see hyperion::getRemoteImageTargetSize()
+	/// @param size  The target size, invalid if there is none
+	/// @param fps   The target frame rate, 0 if there is no limit
+	///
+	void setImageTarget(const QSize& size, const int fps);
+
 private slots:
 	///
 	/// @brief Is called whenever a new socket wants to connect
@@ -63,6 +71,8 @@ private:
 	int _timeout;
 	quint16 _port;
 	const QJsonDocument _config;
+	QSize _targetSize;
+	int _targetFps;
 
 	QVector<FlatBufferClient*> _openConnections;
 };
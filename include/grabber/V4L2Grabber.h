@@ -8,9 +8,11 @@
 #include <QObject>
 #include <QSocketNotifier>
 #include <QRectF>
+#include <QSize>
 
 // util includes
 #include <utils/PixelFormat.h>
+#include <utils/RawImage.h>
 #include <hyperion/Grabber.h>
 #include <grabber/VideoStandard.h>
 #include <utils/Components.h>
@@ -57,6 +59,11 @@ public:
 	///
 	virtual void setPixelDecimation(int pixelDecimation);
 
+	///
+	/// @brief Get the current pixelDecimation
+	///
+	virtual int getPixelDecimation() const { return _pixelDecimation; };
+
 	///
 	/// @brief  overwrite Grabber.h implementation
 	///
@@ -84,6 +91,34 @@ public:
 	/// 
 	virtual void setDeviceVideoStandard(QString device, VideoStandard videoStandard);
 
+	///
+	/// @brief Enable the negotiation of the capture mode. When enabled the cheapest mode of the device which still covers
+	///        the led layout and the target rate is selected, otherwise the current mode of the device is kept
+	/// @param  enable  Enable the mode negotiation
+	/// @param  fps     The target frame rate
+	///
+	void setModeNegotiation(bool enable, int fps);
+
+	///
+	/// @brief Set the grid size of the led layout, which defines the resolution the mode negotiation has to provide
+	/// @param  gridSize  The number of distinct led columns and rows
+	///
+	void setLedGridSize(const QSize& gridSize);
+
+	///
+	/// @brief Enable the fused led mapping. When enabled YUV and packed RGB frames are handed over as raw frames (see newRawFrame),
+	///        as long as every instance is able to map the leds on them. Otherwise they are converted to an image.
+	///        Packed RGB frames are only handed over without decimation, the instances process them in place as an ImageView
+	/// @param  enable  Enable the fused mapping
+	///
+	void setFusedMapping(bool enable);
+
+	///
+	/// @brief Set the grid of the signal detection. Only every n-th pixel of the converted image in both directions is checked
+	/// @param  step  The distance of the checked pixels, 1 checks every pixel
+	///
+	void setSignalDetectionStep(int step);
+
 public slots:
 
 	bool start();
@@ -94,6 +129,7 @@ public slots:
 
 signals:
 	void newFrame(const Image<ColorRgb> & image);
+	void newRawFrame(const RawImage & raw);
 	void readError(const char* err);
 
 private slots:
@@ -117,6 +153,34 @@ private:
 
 	void init_device(VideoStandard videoStandard, int input);
 
+	/// A capture mode offered by the device, the frame interval is 0/0 if the device doesn't report it
+	struct DeviceMode
+	{
+		uint32_t v4l2Format;
+		unsigned width;
+		unsigned height;
+		unsigned intervalNumerator;
+		unsigned intervalDenominator;
+	};
+
+	///
+	/// @brief Enumerate the formats, frame sizes and frame intervals of the device and select the cheapest mode
+	///        which covers the resolution needed by the led layout at the target rate
+	/// @param  mode  The selected mode
+	/// @return False if the device doesn't offer a usable mode, the current mode of the device is kept then
+	///
+	bool negotiate_mode(DeviceMode& mode);
+
+	///
+	/// @brief Add a mode for each frame interval the device offers for the format and frame size
+	///
+	void enum_frame_intervals(uint32_t v4l2Format, unsigned width, unsigned height, std::vector<DeviceMode>& modes);
+
+	///
+	/// @brief Apply the pixel decimation to the resampler, limited so the decimated image still covers the led layout
+	///
+	void update_pixel_decimation();
+
 	void uninit_device();
 
 	void start_capturing();
@@ -129,6 +193,25 @@ private:
 
 	int xioctl(int request, void *arg);
 
+	///
+	/// @brief Check the sparse grid of the detection area of a frame against the signal threshold, before it's converted
+	/// @return True if no pixel exceeds the threshold
+	///
+	bool probeNoSignal(const uint8_t * data);
+
+	///
+	/// @brief Check every step-th pixel of an area of an image against the signal threshold
+	/// @return True if no pixel exceeds the threshold
+	///
+	bool isBelowSignalThreshold(const Image<ColorRgb> & image, unsigned xMin, unsigned xMax, unsigned yMin, unsigned yMax, unsigned step) const;
+
+	///
+	/// @brief Count the frames without signal and log a lost or recovered signal
+	/// @param  noSignal  The result of the signal detection of the current frame
+	/// @return True if the frame is forwarded
+	///
+	bool updateSignalState(bool noSignal);
+
 	void throw_exception(const QString & error)
 	{
 		Error(_log, "Throws error: %s", QSTRING_CSTR(error));
@@ -184,8 +267,12 @@ private:
 	int                 _fileDescriptor;
 	std::vector<buffer> _buffers;
 
+	/// the pixel format of the current capture mode
 	PixelFormat _pixelFormat;
+	/// the pixel format of the configuration, which restricts the mode negotiation
+	PixelFormat _configuredPixelFormat;
 	int         _pixelDecimation;
+	int         _appliedPixelDecimation;
 	int         _lineLength;
 	int         _frameByteSize;
 
@@ -199,9 +286,20 @@ private:
 	double   _y_frac_min;
 	double   _x_frac_max;
 	double   _y_frac_max;
+	int      _signalDetectionStep;
+	/// The checked pixels of the last frame
+	Image<ColorRgb> _signalProbe;
 
 	QSocketNotifier *_streamNotifier;
 
 	bool _initialized;
 	bool _deviceAutoDiscoverEnabled;
+
+	// mode negotiation
+	bool  _modeNegotiation;
+	int   _targetFps;
+	QSize _ledGridSize;
+	bool  _modeNegotiated;
+
+	bool _fusedMapping;
 };
@@ -25,12 +25,24 @@ public slots:
 	void setSignalDetectionOffset(double verticalMin, double horizontalMin, double verticalMax, double horizontalMax);
 	void setSignalDetectionEnable(bool enable);
 	void setDeviceVideoStandard(QString device, VideoStandard videoStandard);
+	void setModeNegotiation(bool enable, int fps);
+	void setLedGridSize(const QSize& gridSize);
+	void setFusedMapping(bool enable);
+	void setSignalDetectionStep(int step);
+
+	///
+	/// @brief Handle settings update, extends GrabberWrapper with the mode negotiation, the fused mapping and the signal detection grid
+	/// @param type   settingyType from enum
+	/// @param config configuration object
+	///
+	virtual void handleSettingsUpdate(const settings::type& type, const QJsonDocument& config);
 
 signals:
 	void componentStateChanged(const hyperion::Components component, bool enable);
 
 private slots:
 	void newFrame(const Image<ColorRgb> & image);
+	void newRawFrame(const RawImage & raw);
 	void readError(const char* err);
 
 	virtual void action();
@@ -49,6 +49,11 @@ public:
 	///
 	virtual void setPixelDecimation(int pixelDecimation);
 
+	///
+	/// @brief Get the current pixelDecimation
+	///
+	virtual int getPixelDecimation() const { return _pixelDecimation; };
+
 	///
 	/// Set the crop values
 	/// @param  cropLeft    Left pixel crop
@@ -4,9 +4,11 @@
 #include <utils/settings.h>
 #include <utils/Components.h>
 #include <utils/Image.h>
+#include <utils/RawImage.h>
 
 class Hyperion;
 class QTimer;
+class CaptureReceiver;
 
 ///
 /// @brief Capture Control class which is a interface to the HyperionDaemon native capture classes.
@@ -49,6 +51,12 @@ private slots:
 	///
 	void handleV4lImage(const QString& name, const Image<ColorRgb> & image);
 
+	///
+	/// @brief forward raw v4l frame
+	/// @param raw  The raw frame
+	///
+	void handleV4lRawFrame(const QString& name, const RawImage& raw);
+
 	///
 	/// @brief Is called from _v4lInactiveTimer to set source after specific time to inactive
 	///
@@ -60,6 +68,11 @@ private slots:
 	void setSystemInactive();
 
 private:
+	///
+	/// @brief Register the v4l input on a name change and keep it active
+	///
+	void updateV4lInput(const QString& name);
+
 	/// Hyperion instance
 	Hyperion* _hyperion;
 
@@ -68,10 +81,12 @@ private:
 	quint8 _systemCaptPrio;
 	QString _systemCaptName;
 	QTimer* _systemInactiveTimer;
+	CaptureReceiver* _systemReceiver;
 
 	/// Reflect state of v4l capture and prio
 	bool _v4lCaptEnabled;
 	quint8 _v4lCaptPrio;
 	QString _v4lCaptName;
 	QTimer* _v4lInactiveTimer;
+	CaptureReceiver* _v4lReceiver;
 };
@@ -0,0 +1,106 @@
+#pragma once
+
+// STL includes
+#include <cstdint>
+
+// qt
+#include <QString>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QElapsedTimer>
+
+///
+/// @brief Adapts the grab rate and pixel decimation of a grabber to a cpu budget.
+/// The configured capture settings are the best quality the governor may use. When the process exceeds its budget or the frames
+/// take too long for the grab interval the governor first raises the pixel decimation up to a limit and then lowers the grab rate
+/// down to a limit. With enough headroom it restores the grab rate first and then the decimation.
+/// The decisions are published for the API, see getStates()
+///
+class CaptureGovernor
+{
+public:
+	///
+	/// @param name  The name of the grabber
+	///
+	CaptureGovernor(const QString& name);
+	~CaptureGovernor();
+
+	///
+	/// @brief Apply the "captureGovernor" settings, the grabber falls back to its configured quality when disabled
+	/// @param config  The settings
+	///
+	void setConfig(const QJsonObject& config);
+
+	///
+	/// @brief Set the configured quality of the grabber, resets all adjustments
+	/// @param frequency_Hz     The configured grab rate, 0 if the rate is given by the device
+	/// @param pixelDecimation  The configured pixel decimation, 0 if the grabber doesn't support it
+	///
+	void setBaseline(const int& frequency_Hz, const int& pixelDecimation);
+
+	///
+	/// @brief The baseline has been set at least once
+	///
+	bool hasBaseline() const { return _hasBaseline; };
+
+	///
+	/// @brief Account a captured frame and evaluate the load once per evaluation period
+	/// @param frameTimeUs  The time it took to grab and hand over the frame in microseconds, 0 if unknown
+	/// @return True if the grab rate or the pixel decimation has been changed
+	///
+	bool addFrame(const int64_t& frameTimeUs);
+
+	/// The grab rate to use, 0 if the rate is given by the device
+	int frequency() const { return _frequency; };
+
+	/// The pixel decimation to use, 0 if the grabber doesn't support it
+	int pixelDecimation() const { return _pixelDecimation; };
+
+	///
+	/// @brief Get the current state and the last decision of all governors
+	/// @return  One object per grabber
+	///
+	static QJsonArray getStates();
+
+private:
+	///
+	/// @brief Get the cpu time used by the process since it started
+	/// @return The cpu time in microseconds, negative if not available
+	///
+	static int64_t processCpuTimeUs();
+
+	///
+	/// @brief Publish the current state for getStates()
+	///
+	void publishState();
+
+	const QString _name;
+
+	// settings
+	bool _enabled;
+	double _cpuBudget;
+	int _minFrequency;
+	int _maxDecimation;
+
+	// configured quality
+	bool _hasBaseline;
+	int _baseFrequency;
+	int _baseDecimation;
+
+	// current quality
+	int _frequency;
+	int _pixelDecimation;
+
+	// measurements of the running evaluation period
+	QElapsedTimer _period;
+	int64_t _periodCpuUs;
+	int64_t _frameTimeSumUs;
+	int _frames;
+	/// periods to skip after a change until the load settled
+	int _settle;
+
+	// last evaluation
+	double _cpuLoad;
+	double _frameTimeMs;
+	QString _decision;
+};
@@ -45,6 +45,17 @@ public:
 	///
 	virtual void setPixelDecimation(int pixelDecimation) {};
 
+	///
+	/// @brief Get the current pixelDecimation
+	/// @return The pixelDecimation, 0 if the grabber doesn't support it
+	///
+	virtual int getPixelDecimation() const { return 0; };
+
+	///
+	/// @brief Apply the decimation mode of the ImageResampler ("sample" or "average"), ignored by grabbers which scale without it
+	///
+	virtual void setDecimationMode(const QString& mode);
+
 	///
 	/// @brief Apply new signalThreshold (used from v4l)
 	///
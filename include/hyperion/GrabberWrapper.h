@@ -5,6 +5,7 @@
 #include <QJsonArray>
 #include <QString>
 #include <QStringList>
+#include <QElapsedTimer>
 
 #include <utils/Logger.h>
 #include <utils/Components.h>
@@ -14,8 +15,10 @@
 #include <utils/settings.h>
 
 class Grabber;
+class CaptureGovernor;
 class GlobalSignals;
 class QTimer;
+class QThread;
 
 ///
 /// This class will be inherted by FramebufferWrapper and others which contains the real capture interface
@@ -31,12 +34,19 @@ public:
 	///
 	/// Starts the grabber wich produces led values with the specified update rate
 	///
-	virtual bool start();
+	Q_INVOKABLE virtual bool start();
 
 	///
 	/// Stop grabber
 	///
-	virtual void stop();
+	Q_INVOKABLE virtual void stop();
+
+	///
+	/// @brief Move the wrapper together with the grabber it drives to a capture thread.
+	///        Must be called from the thread the wrapper currently lives in, afterwards start()/stop() have to be invoked queued
+	/// @param thread  The capture thread
+	///
+	void moveToCaptureThread(QThread* thread);
 
 	static QStringList availableGrabbers();
 
@@ -51,10 +61,14 @@ public:
 			_image.resize(w, h);
 		}
 
+		QElapsedTimer frameTime;
+		frameTime.start();
+
 		int ret = grabber.grabFrame(_image);
 		if (ret >= 0)
 		{
 			emit systemImage(_grabberName, _image);
+			frameDone(frameTime.nsecsElapsed() / 1000);
 			return true;
 		}
 		return false;
@@ -81,6 +95,12 @@ public slots:
 	///
 	virtual void setCropping(unsigned cropLeft, unsigned cropRight, unsigned cropTop, unsigned cropBottom);
 
+	///
+	/// Set the decimation mode
+	/// @param  mode  "sample" takes one pixel of each block, "average" averages the block
+	///
+	void setDecimationMode(const QString& mode);
+
 	///
 	/// @brief Handle settings update from HyperionDaemon Settingsmanager emit
 	/// @param type   settingyType from enum
@@ -95,6 +115,16 @@ signals:
 	void systemImage(const QString& name, const Image<ColorRgb>& image);
 
 protected:
+	///
+	/// @brief Account a frame at the capture governor and apply its decisions
+	/// @param frameTimeUs  The time it took to grab and hand over the frame in microseconds, 0 if unknown
+	///
+	void frameDone(const int64_t& frameTimeUs);
+
+	///
+	/// @brief Apply grab rate and pixel decimation of the capture governor
+	///
+	void applyGovernor();
 
 	QString _grabberName;
 
@@ -111,4 +141,7 @@ protected:
 
 	/// The image used for grabbing frames
 	Image<ColorRgb> _image;
+
+	/// Adapts grab rate and pixel decimation to the cpu budget
+	CaptureGovernor* _governor;
 };
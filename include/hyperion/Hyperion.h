@@ -2,6 +2,7 @@
 
 // stl includes
 #include <list>
+#include <memory>
 #include <QMap>
 
 // QT includes
@@ -15,6 +16,7 @@
 
 // hyperion-utils includes
 #include <utils/Image.h>
+#include <utils/RawImage.h>
 #include <utils/ColorRgb.h>
 #include <utils/Logger.h>
 #include <utils/Components.h>
@@ -25,6 +27,7 @@
 #include <hyperion/PriorityMuxer.h>
 #include <hyperion/ColorAdjustment.h>
 #include <hyperion/ComponentRegister.h>
+#include <hyperion/LedOutputConfig.h>
 
 // Effect engine includes
 #include <effectengine/EffectDefinition.h>
@@ -39,6 +42,7 @@ class HyperionDaemon;
 class ImageProcessor;
 class MessageForwarder;
 class LinearColorSmoothing;
+class RenderLoop;
 class EffectEngine;
 class MultiColorAdjustment;
 class ColorAdjustment;
@@ -263,6 +267,24 @@ public slots:
 	///
 	bool setInputImage(const int priority, const Image<ColorRgb>& image, const int64_t timeout_ms = -1, const bool& clearEffect = true);
 
+	///
+	/// @brief   Update the current colors of a priority (prev registered with registerInput()) from a raw frame.
+	///          The leds are mapped directly on the frame, it is never converted to an image
+	/// @param  priority     The priority to update
+	/// @param  raw          The raw frame, the data is only accessed during the call
+	/// @return              True on success, false when priority is not found
+	///
+	bool setInputRawImage(const int priority, const RawImage& raw);
+
+	///
+	/// @brief   Check if the leds may be mapped on raw frames, which is the case when nobody needs the image itself:
+	///          no image stream and no forwarding. Packed RGB frames are processed in place as an image, other formats
+	///          also require the black border detection to be disabled
+	/// @param   pixelFormat  The pixel format of the frames
+	/// @return  True if raw frames are accepted
+	///
+	bool canMapRawImage(const PixelFormat& pixelFormat);
+
 	///
 	/// Writes a single color to all the leds for the given time and priority
 	/// Registers comp color or provided type against muxer
@@ -442,7 +464,7 @@ signals:
 public slots:
 	///
 	/// Updates the priority muxer with the current time and (re)writes the led color with applied
-	/// transforms.
+	/// transforms. With the render loop enabled the write is deferred to the next output clock tick.
 	///
 	void update();
 
@@ -470,6 +492,7 @@ private slots:
 private:
 	friend class HyperionDaemon;
 	friend class HyperionIManager;
+	friend class RenderLoop;
 
 	///
 	/// @brief Constructs the Hyperion instance, just accessible for HyperionIManager
@@ -477,6 +500,16 @@ private:
 	///
 	Hyperion(const quint8& instance);
 
+	///
+	/// @brief Build a new snapshot of the frame relevant configuration and publish it for update(). Requires _changes to be locked
+	///
+	void publishOutputConfig();
+
+	///
+	/// @brief Process the current input of the muxer and write it to smoothing or device
+	///
+	void render();
+
 	/// instance index
 	const quint8 _instIndex;
 
@@ -495,12 +528,13 @@ private:
 	/// Image Processor
 	ImageProcessor* _imageProcessor;
 
-	std::vector<ColorOrder> _ledStringColorOrder;
+	/// Current snapshot of the frame relevant configuration, swapped atomically on reconfiguration
+	std::shared_ptr<const LedOutputConfig> _outputConfig;
 
 	/// The priority muxer
 	PriorityMuxer _muxer;
 
-	/// The adjustment from raw colors to led colors
+	/// The adjustment from raw colors to led colors, the editable origin of the adjustment snapshot in _outputConfig
 	MultiColorAdjustment * _raw2ledAdjustment;
 
 	/// The actual LedDeviceWrapper
@@ -534,11 +568,20 @@ private:
 	/// buffer for leds (with adjustment)
 	std::vector<ColorRgb> _ledBuffer;
 
+	/// buffer for the remapped leds, swapped with _ledBuffer to reuse the memory of both
+	std::vector<ColorRgb> _outputBuffer;
+
 	VideoMode _currVideoMode = VIDEO_2D;
 
 	/// Boblight instance
 	BoblightServer* _boblightServer;
 
-	/// mutex
+	/// serializes reconfiguration, never locked by update()
 	QMutex _changes;
+
+	/// serializes render() calls from different threads
+	QMutex _frameLock;
+
+	/// Output clock of the render loop mode
+	RenderLoop* _renderLoop;
 };
@@ -6,6 +6,9 @@
 #include <utils/settings.h>
 #include <utils/Components.h>
 
+// hyperion
+#include <hyperion/OutputClock.h>
+
 // qt
 #include <QMap>
 
@@ -51,6 +54,12 @@ public:
 	///
 	const QVector<QVariantMap> getInstanceData();
 
+	///
+	/// @brief Get the output clock shared by all instances with frame lock enabled, their render loops tick at common frame boundaries
+	/// @return The shared output clock
+	///
+	OutputClock* getOutputClock() { return &_outputClock; };
+
 	///
 	/// @brief Start a Hyperion instance
 	/// @param instance  Instance index
@@ -173,4 +182,6 @@ private:
 	const QString _rootPath;
 	QMap<quint8, Hyperion*> _runningInstances;
 	QList<quint8> _startQueue;
+	/// time base of the frame locked instances
+	OutputClock _outputClock;
 };
@@ -1,9 +1,15 @@
 #pragma once
 
+// STL includes
+#include <atomic>
+#include <memory>
+
 #include <QString>
 
 // Utils includes
 #include <utils/Image.h>
+#include <utils/ImageView.h>
+#include <utils/RawImage.h>
 
 // Hyperion includes
 #include <hyperion/LedString.h>
@@ -49,7 +55,7 @@ public:
 	void setSize(const unsigned width, const unsigned height);
 
 	///
-	/// @brief Update the led string (eg on settings change)
+	/// @brief Update the led string (eg on settings change). The new led string is applied with the next processed image
 	///
 	void setLedString(const LedString& ledString);
 
@@ -89,10 +95,10 @@ public:
 	/// match the given size.
 	/// NB All earlier obtained references will be invalid.
 	///
-	/// @param[in] image   The dimensions taken from image
+	/// @param[in] image   The dimensions taken from image (Image or ImageView)
 	///
-	template <typename Pixel_T>
-	void setSize(const Image<Pixel_T> &image)
+	template <typename Image_T>
+	void setSize(const Image_T &image)
 	{
 		setSize(image.width(), image.height());
 	}
@@ -101,16 +107,19 @@ public:
 	/// Processes the image to a list of led colors. This will update the size of the buffer-image
 	/// if required and call the image-to-leds mapping to determine the mean color per led.
 	///
-	/// @param[in] image  The image to translate to led values
+	/// @param[in] image  The image to translate to led values, an Image or an ImageView which is processed in place
 	///
 	/// @return The color value per led
 	///
-	template <typename Pixel_T>
-	std::vector<ColorRgb> process(const Image<Pixel_T>& image)
+	template <typename Image_T>
+	std::vector<ColorRgb> process(const Image_T& image)
 	{
 		std::vector<ColorRgb> colors;
 		if (image.width()>0 && image.height()>0)
 		{
+			// Apply a changed led string
+			applyLedString();
+
 			// Ensure that the buffer-image is the proper size
 			setSize(image);
 
@@ -136,14 +145,17 @@ public:
 	///
 	/// Determines the led colors of the image in the buffer.
 	///
-	/// @param[in] image  The image to translate to led values
+	/// @param[in] image  The image to translate to led values, an Image or an ImageView which is processed in place
 	/// @param[out] ledColors  The color value per led
 	///
-	template <typename Pixel_T>
-	void process(const Image<Pixel_T>& image, std::vector<ColorRgb>& ledColors)
+	template <typename Image_T>
+	void process(const Image_T& image, std::vector<ColorRgb>& ledColors)
 	{
 		if ( image.width()>0 && image.height()>0)
 		{
+			// Apply a changed led string
+			applyLedString();
+
 			// Ensure that the buffer-image is the proper size
 			setSize(image);
 
@@ -163,6 +175,16 @@ public:
 		}
 	}
 
+	///
+	/// Determines the led colors directly on a raw frame without converting it to an image first.
+	/// Packed RGB frames are processed in place as an ImageView. The black border detection is not applied to
+	/// the YUV formats, so the caller has to make sure it's disabled.
+	///
+	/// @param[in] raw  The raw frame, see RawImage::isMappable() for the supported formats
+	/// @param[out] ledColors  The color value per led
+	///
+	void processRaw(const RawImage& raw, std::vector<ColorRgb>& ledColors);
+
 	///
 	/// Get the hscan and vscan parameters for a single led
 	///
@@ -175,38 +197,47 @@ public:
 	bool getScanParameters(size_t led, double & hscanBegin, double & hscanEnd, double & vscanBegin, double & vscanEnd) const;
 
 private:
+	///
+	/// @brief Take over a led string published with setLedString() and rebuild the mapping
+	///
+	void applyLedString();
+
+	///
+	/// @brief Get the mapping of the current led string for an image size and border. Recently used mappings are cached,
+	/// so sources with different sizes (e.g. an effect and a grabber) or a changing border don't rebuild it on every switch
+	///
+	/// @return The mapping, owned by the cache. It stays valid until the led string changes or LEDS_MAP_CACHE_SIZE other mappings are requested
+	///
+	hyperion::ImageToLedsMap* getLedsMap(const unsigned width, const unsigned height, const unsigned horizontalBorder, const unsigned verticalBorder, const bool indexed = true);
+
 	///
 	/// Performs black-border detection (if enabled) on the given image
 	///
 	/// @param[in] image  The image to perform black-border detection on
 	///
-	template <typename Pixel_T>
-	void verifyBorder(const Image<Pixel_T> & image)
+	template <typename Image_T>
+	void verifyBorder(const Image_T & image)
 	{
 		if (!_borderProcessor->enabled() && ( _imageToLeds->horizontalBorder()!=0 || _imageToLeds->verticalBorder()!=0 ))
 		{
 			Debug(_log, "Reset border");
 			_borderProcessor->process(image);
-			delete _imageToLeds;
-			_imageToLeds = new hyperion::ImageToLedsMap(image.width(), image.height(), 0, 0, _ledString.leds());
+			_imageToLeds = getLedsMap(image.width(), image.height(), 0, 0);
 		}
 
 		if(_borderProcessor->enabled() && _borderProcessor->process(image))
 		{
 			const hyperion::BlackBorder border = _borderProcessor->getCurrentBorder();
 
-			// Clean up the old mapping
-			delete _imageToLeds;
-
 			if (border.unknown)
 			{
-				// Construct a new buffer and mapping
-				_imageToLeds = new hyperion::ImageToLedsMap(image.width(), image.height(), 0, 0, _ledString.leds());
+				// Take the mapping without border
+				_imageToLeds = getLedsMap(image.width(), image.height(), 0, 0);
 			}
 			else
 			{
-				// Construct a new buffer and mapping
-				_imageToLeds = new hyperion::ImageToLedsMap(image.width(), image.height(), border.horizontalSize, border.verticalSize, _ledString.leds());
+				// Take the mapping of the border
+				_imageToLeds = getLedsMap(image.width(), image.height(), border.horizontalSize, border.verticalSize);
 			}
 
 			//Debug(Logger::getInstance("BLACKBORDER"),  "CURRENT BORDER TYPE: unknown=%d hor.size=%d vert.size=%d",
@@ -222,12 +253,28 @@ private:
 	/// The Led-string specification
 	LedString _ledString;
 
+	/// Led string set from a reconfiguration, waiting to be applied by the frame path
+	std::shared_ptr<const LedString> _pendingLedString;
+
+	/// The configured maximum of pixels per led and the one the mappings are built with, 0 means all pixels
+	std::atomic<unsigned> _maxSamplesPerLed;
+	unsigned _appliedMaxSamplesPerLed;
+
 	/// The processor for black border detection
 	hyperion::BlackBorderProcessor * _borderProcessor;
 
+	/// The number of mappings kept in the cache
+	static const size_t LEDS_MAP_CACHE_SIZE = 6;
+
+	/// The recently used mappings of the current led string, the most recently used first
+	std::vector<std::unique_ptr<hyperion::ImageToLedsMap>> _ledsMapCache;
+
 	/// The mapping of image-pixels to leds
 	hyperion::ImageToLedsMap* _imageToLeds;
 
+	/// The mapping of the region of raw frames to leds
+	hyperion::ImageToLedsMap* _rawToLeds;
+
 	/// Type of image 2 led mapping
 	int _mappingType;
 	/// Type of last requested user type
@@ -7,6 +7,9 @@
 
 // hyperion-utils includes
 #include <utils/Image.h>
+#include <utils/ImageView.h>
+#include <utils/ImageReduce.h>
+#include <utils/RawImage.h>
 #include <utils/Logger.h>
 
 // hyperion includes
@@ -35,13 +38,17 @@ namespace hyperion
 		/// @param[in] horizontalBorder The size of the horizontal border (0=no border)
 		/// @param[in] verticalBorder   The size of the vertical border (0=no border)
 		/// @param[in] leds             The list with led specifications
+		/// @param[in] indexed          Create the pixel indices, a map which is only used on raw frames just needs the led areas
+		/// @param[in] maxSamplesPerLed Leds with a larger area take their color from a stratified subset of this many pixels (0=all pixels)
 		///
 		ImageToLedsMap(
 				const unsigned width,
 				const unsigned height,
 				const unsigned horizontalBorder,
 				const unsigned verticalBorder,
-				const std::vector<Led> & leds);
+				const std::vector<Led> & leds,
+				const bool indexed = true,
+				const unsigned maxSamplesPerLed = 0);
 
 		///
 		/// Returns the width of the indexed image
@@ -57,21 +64,31 @@ namespace hyperion
 		///
 		unsigned height() const;
 
-		unsigned horizontalBorder() { return _horizontalBorder; };
-		unsigned verticalBorder() { return _verticalBorder; };
+		unsigned horizontalBorder() const { return _horizontalBorder; };
+		unsigned verticalBorder() const { return _verticalBorder; };
+
+		///
+		/// Returns the maximum number of pixels a led takes its color from (0=all pixels)
+		///
+		unsigned maxSamplesPerLed() const { return _maxSamplesPerLed; };
+
+		///
+		/// Returns true if the map holds the pixel indices, otherwise it can only be used on raw frames
+		///
+		bool isIndexed() const { return _indexed; };
 
 		///
 		/// Determines the mean color for each led using the mapping the image given
 		/// at construction.
 		///
-		/// @param[in] image  The image from which to extract the led colors
+		/// @param[in] image  The image (Image or ImageView) from which to extract the led colors
 		///
 		/// @return ledColors  The vector containing the output
 		///
-		template <typename Pixel_T>
-		std::vector<ColorRgb> getMeanLedColor(const Image<Pixel_T> & image) const
+		template <typename Image_T>
+		std::vector<ColorRgb> getMeanLedColor(const Image_T & image) const
 		{
-			std::vector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0,0,0});
+			std::vector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0,0,0});
 			getMeanLedColor(image, colors);
 			return colors;
 		}
@@ -80,26 +97,24 @@ namespace hyperion
 		/// Determines the mean color for each led using the mapping the image given
 		/// at construction.
 		///
-		/// @param[in] image  The image from which to extract the led colors
+		/// @param[in] image  The image (Image or ImageView) from which to extract the led colors
 		/// @param[out] ledColors  The vector containing the output
 		///
-		template <typename Pixel_T>
-		void getMeanLedColor(const Image<Pixel_T> & image, std::vector<ColorRgb> & ledColors) const
+		template <typename Image_T>
+		void getMeanLedColor(const Image_T & image, std::vector<ColorRgb> & ledColors) const
 		{
 			// Sanity check for the number of leds
-			//assert(_colorsMap.size() == ledColors.size());
-			if(_colorsMap.size() != ledColors.size())
+			//assert(_ledAreas.size() == ledColors.size());
+			if(_ledAreas.size() != ledColors.size())
 			{
-				Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: ledAreas.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
 				return;
 			}
 
 			// Iterate each led and compute the mean
-			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
+			for (size_t led = 0; led < ledColors.size(); ++led)
 			{
-				const ColorRgb color = calcMeanColor(image, *colors);
-				*led = color;
+				ledColors[led] = calcLedColor(image, led);
 			}
 		}
 
@@ -107,14 +122,14 @@ namespace hyperion
 		/// Determines the uni color for each led using the mapping the image given
 		/// at construction.
 		///
-		/// @param[in] image  The image from which to extract the led colors
+		/// @param[in] image  The image (Image or ImageView) from which to extract the led colors
 		///
 		/// @return ledColors  The vector containing the output
 		///
-		template <typename Pixel_T>
-		std::vector<ColorRgb> getUniLedColor(const Image<Pixel_T> & image) const
+		template <typename Image_T>
+		std::vector<ColorRgb> getUniLedColor(const Image_T & image) const
 		{
-			std::vector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0,0,0});
+			std::vector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0,0,0});
 			getUniLedColor(image, colors);
 			return colors;
 		}
@@ -123,17 +138,17 @@ namespace hyperion
 		/// Determines the uni color for each led using the mapping the image given
 		/// at construction.
 		///
-		/// @param[in] image  The image from which to extract the led colors
+		/// @param[in] image  The image (Image or ImageView) from which to extract the led colors
 		/// @param[out] ledColors  The vector containing the output
 		///
-		template <typename Pixel_T>
-		void getUniLedColor(const Image<Pixel_T> & image, std::vector<ColorRgb> & ledColors) const
+		template <typename Image_T>
+		void getUniLedColor(const Image_T & image, std::vector<ColorRgb> & ledColors) const
 		{
 			// Sanity check for the number of leds
-			// assert(_colorsMap.size() == ledColors.size());
-			if(_colorsMap.size() != ledColors.size())
+			// assert(_ledAreas.size() == ledColors.size());
+			if(_ledAreas.size() != ledColors.size())
 			{
-				Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: ledAreas.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
 				return;
 			}
 
@@ -143,6 +158,43 @@ namespace hyperion
 			std::fill(ledColors.begin(),ledColors.end(), color);
 		}
 
+		///
+		/// Determines the mean color for each led directly on a raw YUV frame. The channels are averaged
+		/// in YUV and only the averages are converted to RGB, the sampled grid of the frame has to match the size of the map.
+		///
+		/// @param[in] raw  The raw frame, see RawImage::isMappable() for the supported formats
+		/// @param[out] ledColors  The vector containing the output
+		///
+		void getMeanLedColor(const RawImage & raw, std::vector<ColorRgb> & ledColors) const;
+
+		///
+		/// Determines the uni color for each led directly on a raw YUV frame.
+		///
+		/// @param[in] raw  The raw frame, see RawImage::isMappable() for the supported formats
+		/// @param[out] ledColors  The vector containing the output
+		///
+		void getUniLedColor(const RawImage & raw, std::vector<ColorRgb> & ledColors) const;
+
+		///
+		/// The rectangle of the image a led takes its color from, the max values are exclusive
+		///
+		struct LedArea
+		{
+			unsigned minX;
+			unsigned maxX;
+			unsigned minY;
+			unsigned maxY;
+		};
+
+		///
+		/// A pixel of a led area which is taken into account for the led color
+		///
+		struct LedSample
+		{
+			uint16_t x;
+			uint16_t y;
+		};
+
 	private:
 		/// The width of the indexed image
 		const unsigned _width;
@@ -153,9 +205,85 @@ namespace hyperion
 
 		const unsigned _verticalBorder;
 
-		/// The absolute indices into the image for each led
+		const unsigned _maxSamplesPerLed;
+
+		const bool _indexed;
+
+		/// The absolute indices into the image for each led, empty for sampled leds
 		std::vector<std::vector<unsigned>> _colorsMap;
 
+		/// The area of each led, empty for leds without area
+		std::vector<LedArea> _ledAreas;
+
+		/// The stratified samples of leds whose area exceeds the sample limit, empty for leds which use every pixel
+		std::vector<std::vector<LedSample>> _ledSamples;
+
+		///
+		/// Calculates the 'mean color' of a led on a raw frame
+		///
+		/// @param[in] raw      The raw frame
+		/// @param[in] area     The area on the sampled grid of the frame
+		/// @param[in] samples  The samples of the area, every pixel of the area is used if empty
+		///
+		/// @return The mean color of the area (or black when empty)
+		///
+		ColorRgb calcMeanColor(const RawImage & raw, const LedArea & area, const std::vector<LedSample> & samples = std::vector<LedSample>()) const;
+
+		///
+		/// Calculates the 'mean color' of a led, images use the pixel indices and views the led area.
+		/// Sampled leds use their samples in both cases
+		///
+		template <typename Pixel_T>
+		ColorRgb calcLedColor(const Image<Pixel_T> & image, const size_t led) const
+		{
+			// the indices are only valid for images without row padding
+			if (!image.isContiguous() || !_ledSamples[led].empty())
+			{
+				return calcLedColor(ImageView<Pixel_T>(image), led);
+			}
+			return calcMeanColor(image, _colorsMap[led]);
+		}
+
+		template <typename Pixel_T>
+		ColorRgb calcLedColor(const ImageView<Pixel_T> & view, const size_t led) const
+		{
+			if (!_ledSamples[led].empty())
+			{
+				return calcMeanColor(view, _ledSamples[led]);
+			}
+			return calcMeanColor(view, _ledAreas[led]);
+		}
+
+		///
+		/// Calculates the 'mean color' of the samples of a led. This is the mean over each color-channel
+		/// (red, green, blue)
+		///
+		/// @param[in] view     The view a section from which an average color must be computed
+		/// @param[in] samples  The samples of the led
+		///
+		/// @return The mean of the samples
+		///
+		template <typename Pixel_T>
+		ColorRgb calcMeanColor(const ImageView<Pixel_T> & view, const std::vector<LedSample> & samples) const
+		{
+			// Accumulate the sum of each seperate color channel
+			uint_fast32_t cummRed   = 0;
+			uint_fast32_t cummGreen = 0;
+			uint_fast32_t cummBlue  = 0;
+
+			for (const LedSample& sample : samples)
+			{
+				const Pixel_T& pixel = view(sample.x, sample.y);
+				cummRed   += pixel.red;
+				cummGreen += pixel.green;
+				cummBlue  += pixel.blue;
+			}
+
+			// Compute the average of each color channel
+			const unsigned count = unsigned(samples.size());
+			return {uint8_t(cummRed/count), uint8_t(cummGreen/count), uint8_t(cummBlue/count)};
+		}
+
 		///
 		/// Calculates the 'mean color' of the given list. This is the mean over each color-channel
 		/// (red, green, blue)
@@ -176,9 +304,9 @@ namespace hyperion
 			}
 
 			// Accumulate the sum of each seperate color channel
-			uint_fast16_t cummRed   = 0;
-			uint_fast16_t cummGreen = 0;
-			uint_fast16_t cummBlue  = 0;
+			uint_fast32_t cummRed   = 0;
+			uint_fast32_t cummGreen = 0;
+			uint_fast32_t cummBlue  = 0;
 			const auto& imgData = image.memptr();
 
 			for (const unsigned colorOffset : colors)
@@ -198,6 +326,46 @@ namespace hyperion
 			return {avgRed, avgGreen, avgBlue};
 		}
 
+		///
+		/// Calculates the 'mean color' of an area of a view. This is the mean over each color-channel
+		/// (red, green, blue)
+		///
+		/// @param[in] view  The view a section from which an average color must be computed
+		/// @param[in] area  The area of the view
+		///
+		/// @return The mean of the area (or black when empty)
+		///
+		template <typename Pixel_T>
+		ColorRgb calcMeanColor(const ImageView<Pixel_T> & view, const LedArea & area) const
+		{
+			const unsigned maxX = std::min(area.maxX, view.width());
+			const unsigned maxY = std::min(area.maxY, view.height());
+			if (area.minX >= maxX || area.minY >= maxY)
+			{
+				return ColorRgb::BLACK;
+			}
+
+			// Accumulate the sum of each seperate color channel
+			ImageReduce::ChannelSums sums;
+			for (unsigned y = area.minY; y < maxY; ++y)
+			{
+				ImageReduce::sumChannels(view.row(y) + area.minX, maxX - area.minX, sums);
+			}
+
+			// Compute the average of each color channel
+			const unsigned count = (maxX - area.minX) * (maxY - area.minY);
+			return {uint8_t(sums.red/count), uint8_t(sums.green/count), uint8_t(sums.blue/count)};
+		}
+
+		///
+		/// Calculates the 'mean color' over the given view.
+		///
+		template <typename Pixel_T>
+		ColorRgb calcMeanColor(const ImageView<Pixel_T> & view) const
+		{
+			return calcMeanColor(view, LedArea{0, view.width(), 0, view.height()});
+		}
+
 		///
 		/// Calculates the 'mean color' over the given image. This is the mean over each color-channel
 		/// (red, green, blue)
@@ -209,26 +377,20 @@ namespace hyperion
 		template <typename Pixel_T>
 		ColorRgb calcMeanColor(const Image<Pixel_T> & image) const
 		{
-			// Accumulate the sum of each seperate color channel
-			uint_fast16_t cummRed   = 0;
-			uint_fast16_t cummGreen = 0;
-			uint_fast16_t cummBlue  = 0;
-			const unsigned imageSize = image.width() * image.height();
-
-			const auto& imgData = image.memptr();
-
-			for (unsigned idx=0; idx<imageSize; idx++)
+			if (!image.isContiguous())
 			{
-				const auto& pixel = imgData[idx];
-				cummRed   += pixel.red;
-				cummGreen += pixel.green;
-				cummBlue  += pixel.blue;
+				return calcMeanColor(ImageView<Pixel_T>(image));
 			}
 
+			// Accumulate the sum of each seperate color channel
+			const unsigned imageSize = image.width() * image.height();
+			ImageReduce::ChannelSums sums;
+			ImageReduce::sumChannels(image.memptr(), imageSize, sums);
+
 			// Compute the average of each color channel
-			const uint8_t avgRed   = uint8_t(cummRed/imageSize);
-			const uint8_t avgGreen = uint8_t(cummGreen/imageSize);
-			const uint8_t avgBlue  = uint8_t(cummBlue/imageSize);
+			const uint8_t avgRed   = uint8_t(sums.red/imageSize);
+			const uint8_t avgGreen = uint8_t(sums.green/imageSize);
+			const uint8_t avgBlue  = uint8_t(sums.blue/imageSize);
 
 			// Return the computed color
 			return {avgRed, avgGreen, avgBlue};
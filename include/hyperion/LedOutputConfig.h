@@ -0,0 +1,24 @@
+#pragma once
+
+// STL includes
+#include <memory>
+#include <vector>
+
+// Hyperion includes
+#include <hyperion/LedRemap.h>
+#include <hyperion/MultiColorAdjustment.h>
+
+///
+/// @brief Snapshot of the frame relevant configuration of a Hyperion instance.
+///        Reconfiguration builds a new snapshot and publishes it atomically, Hyperion::update() works on the snapshot
+///        it acquired at frame start. Therefore the frame path never waits for a reconfiguration and vice versa.
+///        A snapshot is never modified after it has been published (the adjustment lookup tables are filled lazily by the frame path only)
+///
+struct LedOutputConfig
+{
+	/// Maps the led colors to the hardware leds (cloned leds, color byte order, additional black leds)
+	LedRemap remap;
+
+	/// The adjustment from raw colors to led colors
+	std::shared_ptr<MultiColorAdjustment> adjustment;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+// STL includes
+#include <cstdint>
+#include <vector>
+
+// Utils includes
+#include <utils/ColorRgb.h>
+
+// Hyperion includes
+#include <hyperion/LedString.h>
+
+///
+/// @brief The output stage of a frame: inserts the cloned leds, applies the color byte order of each led and
+///        pads the hardware leds with black. It's compiled into a gather table whenever the layout changes,
+///        so a frame is remapped in a single linear pass.
+///
+class LedRemap
+{
+public:
+	///
+	/// Constructs a remap which passes the leds through unchanged
+	///
+	LedRemap();
+
+	///
+	/// Compiles the remap of a layout
+	///
+	/// @param ledString       The leds of the layout
+	/// @param ledStringClone  The cloned leds, inserted at their index in the given order
+	/// @param hwLedCount      The count of hardware leds, additional leds are black
+	///
+	LedRemap(const LedString& ledString, const LedString& ledStringClone, unsigned hwLedCount);
+
+	///
+	/// @brief Remap the colors of a frame
+	///
+	/// @param ledColors  The adjusted colors of the layout leds
+	/// @param output     Receives the colors of the hardware leds, its memory is reused
+	///
+	void apply(const std::vector<ColorRgb>& ledColors, std::vector<ColorRgb>& output) const;
+
+	///
+	/// @return The count of output leds
+	///
+	size_t size() const { return _sources.size(); }
+
+private:
+	/// The source index of an output led which is black
+	static const uint32_t NO_SOURCE = UINT32_MAX;
+
+	template <ColorOrder ORDER>
+	void gather(const std::vector<ColorRgb>& ledColors, std::vector<ColorRgb>& output) const;
+
+	/// The index of the layout led each output led takes its color from
+	std::vector<uint32_t> _sources;
+
+	/// The color order of each output led, empty if all leds share _order
+	std::vector<ColorOrder> _orders;
+
+	/// The color order of all leds
+	ColorOrder _order;
+};
@@ -17,6 +17,12 @@ class MultiColorAdjustment
 {
 public:
 	MultiColorAdjustment(const unsigned ledCnt);
+
+	///
+	/// @brief Deep copy of all adjustments and the led assignment
+	///
+	MultiColorAdjustment(const MultiColorAdjustment& other);
+
 	~MultiColorAdjustment();
 
 	/**
@@ -0,0 +1,46 @@
+#pragma once
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+///
+/// @brief Time base of output ticks. The ticks of a period are the multiples of the period since the epoch of the clock,
+///        so render loops that share a clock and run at the same (or a multiple of the) output frequency tick at the same frame boundaries,
+///        regardless of when they have been started. Immutable apart from the member count, may be used from any thread
+///
+class OutputClock
+{
+public:
+	OutputClock()
+		: _epoch(std::chrono::steady_clock::now())
+		, _members(0)
+	{
+	}
+
+	///
+	/// @brief Get the time since the epoch of the clock
+	/// @return  The elapsed time in microseconds
+	///
+	int64_t elapsedUs() const
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _epoch).count();
+	}
+
+	///
+	/// @brief Register a render loop which ticks with this clock
+	/// @return  The number of members including the new one
+	///
+	int join() { return ++_members; }
+
+	///
+	/// @brief Unregister a render loop
+	/// @return  The number of remaining members
+	///
+	int leave() { return --_members; }
+
+private:
+	const std::chrono::steady_clock::time_point _epoch;
+	std::atomic<int> _members;
+};
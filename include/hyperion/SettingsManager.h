@@ -5,12 +5,18 @@
 
 // qt incl
 #include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+#include <QSet>
 
 class Hyperion;
 class SettingsTable;
+class QTimer;
 
 ///
 /// @brief Manage the settings read write from/to config file, on settings changed will emit a signal to update components accordingly
+///        All settings are held parsed in memory, getSetting() never touches the database.
+///        Changes are written behind in batches (single transaction) shortly after saveSettings()
 ///
 class SettingsManager : public QObject
 {
@@ -22,6 +28,7 @@ public:
 	/// @params  parent    The parent hyperion instance
 	///
 	SettingsManager(const quint8& instance, QObject* parent = nullptr);
+	~SettingsManager();
 
 	///
 	/// @brief Save a complete json config
@@ -42,7 +49,18 @@ public:
 	/// @brief get the full settings object of this instance (with global settings)
 	/// @return The requested json
 	///
-	const QJsonObject & getSettings() { return _qconfig; };
+	const QJsonObject & getSettings();
+
+	///
+	/// @brief Write all pending changes to the database now
+	///
+	void flushSettings();
+
+	///
+	/// @brief Drop the cached settings of an instance, required when the instance has been deleted
+	/// @param instance  The instance index
+	///
+	static void clearInstanceCache(const quint8& instance);
 
 signals:
 	///
@@ -53,12 +71,27 @@ signals:
 	void settingsChanged(const settings::type& type, const QJsonDocument& data);
 
 private:
+	///
+	/// @brief Update the shared in memory cache with a new value of a setting
+	/// @param key    The settings type as string
+	/// @param value  The new value
+	///
+	void updateCache(const QString& key, const QJsonValue& value);
+
+	///
+	/// @brief Merge the shared cache into _qconfig when settings have been changed by another SettingsManager
+	///
+	void syncSettings();
+
 	/// Hyperion instance
 	Hyperion* _hyperion;
 
 	/// Logger instance
 	Logger* _log;
 
+	/// instance index
+	const quint8 _instance;
+
 	/// instance of database table interface
 	SettingsTable* _sTable;
 
@@ -67,4 +100,22 @@ private:
 
 	/// the current config of this instance
 	QJsonObject _qconfig;
+
+	/// keys of the settings which are not yet written to the database, the values are taken from the shared cache on write
+	QSet<QString> _pendingWrites;
+
+	/// saveSettings() might be called from another thread than the one of the manager
+	QMutex _pendingMutex;
+
+	/// delays the database write to batch multiple changes, it lives in the thread of the manager
+	QTimer* _writeTimer;
+
+	/// revision of the shared cache this instance has merged into _qconfig
+	int _cacheRevision;
+
+	/// parsed settings, shared between all SettingsManagers (multiple managers may serve the same instance, global settings are shared by all)
+	static QJsonObject _globalCache;
+	static QMap<quint8, QJsonObject> _instanceCache;
+	static int _sharedCacheRevision;
+	static QMutex _cacheMutex;
 };
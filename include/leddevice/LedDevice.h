@@ -7,6 +7,7 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QTimer>
+#include <QElapsedTimer>
 
 // STL includes
 #include <vector>
@@ -45,6 +46,22 @@ public:
 
 	virtual int setLedValues(const std::vector<ColorRgb>& ledValues);
 
+	///
+	/// @brief Write the led values with respect to the latch time of the device. Values which arrive within the latch time
+	///        of the previous write are held back and the most recent of them is written as soon as the latch time expired
+	///
+	/// @param[in] ledValues  The RGB-color per led
+	///
+	/// @return Zero on success or if held back, else negative
+	///
+	int updateLeds(const std::vector<ColorRgb>& ledValues);
+
+	///
+	/// @brief Get the number of frames which have been replaced by a newer one while waiting for the latch time
+	/// @return The number of coalesced frames
+	///
+	quint64 getCoalescedFrames() { return _coalescedFrames; };
+
 	///
 	/// @brief Get color order of device
 	/// @return The color order
@@ -123,13 +140,30 @@ protected:
 	/// e.g. Adalight device will switch off when it does not receive data at least every 15 seconds
 	QTimer       _refresh_timer;
 	unsigned int _refresh_timer_interval;
-	qint64       _last_write_time;
+	/// the time since the last write
+	QElapsedTimer _lastWriteTimer;
 	unsigned int _latchTime_ms;
 protected slots:
 	/// Write the last data to the leds again
 	int rewriteLeds();
 
+	/// Write the held back data when the latch time expired
+	void writePendingLeds();
+
 private:
+	///
+	/// @brief Write the led values immediately and remember them for rewrites and the latch time
+	///
+	int writeLeds(const std::vector<ColorRgb>& ledValues);
+
+	/// Fires when the latch time of the last write expired and a frame is pending
+	QTimer* _latchTimer;
+	/// The most recent frame which arrived within the latch time
+	std::vector<ColorRgb> _pendingValues;
+	bool _latchPending;
+	/// count of frames which have been replaced while pending
+	quint64 _coalescedFrames;
+
 	std::vector<ColorRgb> _ledValues;
 	bool   _componentRegistered;
 	bool   _enabled;
@@ -4,9 +4,14 @@
 #include <utils/Logger.h>
 #include <utils/ColorRgb.h>
 #include <utils/Components.h>
+#include <utils/SpscChannel.h>
+
+// qt
+#include <QMutex>
 
 class LedDevice;
 class Hyperion;
+class ChannelWaker;
 
 typedef LedDevice* ( *LedDeviceCreateFuncType ) ( const QJsonObject& );
 typedef std::map<QString,LedDeviceCreateFuncType> LedDeviceRegistry;
@@ -72,15 +77,12 @@ public slots:
 	///
 	void handleComponentState(const hyperion::Components component, const bool state);
 
-signals:
 	///
-	/// PIPER signal for Hyperion -> LedDevice
+	/// @brief Hand over led values to the device thread. Values the device didn't pick up yet are replaced by newer ones
 	///
 	/// @param[in] ledValues  The RGB-color per led
 	///
-	/// @return Zero on success else negative
-	///
-	int write(const std::vector<ColorRgb>& ledValues);
+	void write(const std::vector<ColorRgb>& ledValues);
 
 private slots:
 	///
@@ -101,6 +103,11 @@ private:
 	/// 
 	void stopDeviceThread();
 
+	///
+	/// @brief Write the latest led values of the channel to the device, runs in the device thread
+	///
+	void writeChannelData();
+
 private:
 	// parent Hyperion
 	Hyperion* _hyperion;
@@ -108,4 +115,13 @@ private:
 	LedDevice* _ledDevice;
 	// the enable state
 	bool _enabled;
+
+	// led values from Hyperion to the device thread
+	SpscChannel<std::vector<ColorRgb>> _ledChannel;
+	// wakes the device thread for new led values, lives in the device thread
+	ChannelWaker* _ledWaker;
+	// serializes writers, led values are written from the smoothing and from update() calls of other threads
+	QMutex _writeLock;
+	// the led values the device thread works on
+	std::vector<ColorRgb> _deviceLedValues;
 };
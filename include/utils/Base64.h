@@ -0,0 +1,33 @@
+#pragma once
+
+// STL includes
+#include <cstddef>
+#include <cstdint>
+
+///
+/// Strict base64 decoding (RFC 4648, standard alphabet with padding) into a caller provided buffer.
+/// The input must not contain whitespace or other characters outside the alphabet, use QByteArray::fromBase64() for lenient decoding.
+///
+namespace Base64
+{
+	///
+	/// @brief Get the size of the decoded data
+	///
+	/// @param data    The base64 encoded data
+	/// @param length  The length of the encoded data
+	///
+	/// @return The size of the decoded data, 0 if the length isn't a multiple of 4
+	///
+	size_t decodedSize(const char* data, size_t length);
+
+	///
+	/// @brief Decode base64 data
+	///
+	/// @param data    The base64 encoded data
+	/// @param length  The length of the encoded data
+	/// @param out     Receives the decoded data, it must hold decodedSize() bytes
+	///
+	/// @return False if the data isn't valid base64
+	///
+	bool decode(const char* data, size_t length, uint8_t* out);
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+// util
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+#include <utils/SpscChannel.h>
+#include <utils/RawImage.h>
+
+// stl
+#include <atomic>
+#include <vector>
+
+// qt
+#include <QObject>
+#include <QString>
+#include <QMutex>
+#include <QVector>
+
+class ChannelWaker;
+
+///
+/// A captured frame together with the name of the capture device. Holds either the converted image or the raw frame
+///
+struct CaptureFrame
+{
+	QString name;
+	Image<ColorRgb> image;
+	/// the raw frame, its data points into rawBuffer
+	RawImage raw;
+	std::vector<uint8_t> rawBuffer;
+};
+
+class CaptureReceiver;
+
+///
+/// @brief Hands the frames of the capture threads over to the Hyperion instances. Every receiver gets its own channel,
+/// which always holds the latest frame. Frames a receiver didn't pick up in time are replaced instead of being queued.
+///
+class CaptureChannels
+{
+public:
+	/// The capture sources
+	enum Source
+	{
+		SYSTEM = 0,
+		V4L,
+		SOURCE_COUNT
+	};
+
+	static CaptureChannels* getInstance()
+	{
+		static CaptureChannels instance;
+		return & instance;
+	}
+
+	CaptureChannels(CaptureChannels const&) = delete;
+	void operator=(CaptureChannels const&) = delete;
+
+	///
+	/// @brief Publish a frame to all receivers of the source, called from the capture thread
+	/// @param source  The capture source
+	/// @param name    The name of the capture device
+	/// @param image   The captured image
+	///
+	void publish(const Source& source, const QString& name, const Image<ColorRgb>& image);
+
+	///
+	/// @brief Publish a raw frame to all receivers of the source, called from the capture thread. Only valid if rawAccepted() is true
+	/// @param source  The capture source
+	/// @param name    The name of the capture device
+	/// @param raw     The raw frame, the data is copied
+	///
+	void publishRaw(const Source& source, const QString& name, const RawImage& raw);
+
+	///
+	/// @brief Check if all receivers of the source are able to map the leds on a raw frame, so the conversion to an image can be skipped
+	/// @param source       The capture source
+	/// @param pixelFormat  The pixel format of the frames
+	/// @return             True if there is at least one receiver and all of them accept raw frames of the format
+	///
+	bool rawAccepted(const Source& source, const PixelFormat& pixelFormat);
+
+private:
+	friend class CaptureReceiver;
+
+	CaptureChannels() {}
+
+	void addReceiver(const Source& source, CaptureReceiver* receiver);
+	void removeReceiver(const Source& source, CaptureReceiver* receiver);
+
+	/// serializes the producers of a source and the receiver (un)registration, receivers never take it
+	QMutex _sourceLock[SOURCE_COUNT];
+	QVector<CaptureReceiver*> _receivers[SOURCE_COUNT];
+};
+
+///
+/// @brief Receives the frames of a capture source in the thread it lives in
+///
+class CaptureReceiver : public QObject
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @param source  The capture source to receive frames from
+	/// @param parent  The parent, frames are delivered in its thread
+	///
+	CaptureReceiver(const CaptureChannels::Source& source, QObject* parent = nullptr);
+	~CaptureReceiver();
+
+	///
+	/// @brief Set which raw frames the receiver handles (see newRawFrame), the capture thread only skips the conversion if all receivers do
+	/// @param packedRgb  True to accept raw RGB24, BGR24 and RGB32 frames
+	/// @param yuv        True to accept raw frames of the YUV formats
+	///
+	void setAcceptRaw(bool packedRgb, bool yuv)
+	{
+		_acceptsPackedRgb.store(packedRgb, std::memory_order_relaxed);
+		_acceptsYuv.store(yuv, std::memory_order_relaxed);
+	}
+
+signals:
+	///
+	/// @brief Emits the latest frame of the source, the image is valid until the slot returns
+	/// @param name   The name of the capture device
+	/// @param image  The captured image
+	///
+	void newFrame(const QString& name, const Image<ColorRgb>& image);
+
+	///
+	/// @brief Emits the latest raw frame of the source, the data is valid until the slot returns
+	/// @param name   The name of the capture device
+	/// @param raw    The raw frame
+	///
+	void newRawFrame(const QString& name, const RawImage& raw);
+
+private slots:
+	///
+	/// @brief Take the latest frame from the channel and emit it
+	///
+	void handleWakeUp();
+
+private:
+	friend class CaptureChannels;
+
+	const CaptureChannels::Source _source;
+	SpscChannel<CaptureFrame> _channel;
+	ChannelWaker* _waker;
+	std::atomic<bool> _acceptsPackedRgb;
+	std::atomic<bool> _acceptsYuv;
+	/// the frame the receiver works on, swapped with the channel
+	CaptureFrame _frame;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+// qt
+#include <QObject>
+
+// stl
+#include <atomic>
+
+class QSocketNotifier;
+
+///
+/// @brief Wakes the consumer of a SpscChannel in its own thread without posting a Qt event per value.
+/// The producer calls wake() after a push, the consumer drains the channel when woken() is emitted.
+/// Wake-ups are coalesced until the consumer handled the pending one, so one wake-up may stand for several values.
+///
+class ChannelWaker : public QObject
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @param parent  The consumer, the waker emits woken() in the thread of its parent
+	///
+	ChannelWaker(QObject* parent = nullptr);
+	~ChannelWaker();
+
+	///
+	/// @brief Request a woken() emit in the consumer thread, may be called from any thread
+	///
+	void wake();
+
+signals:
+	///
+	/// @brief The channel has new values
+	///
+	void woken();
+
+private slots:
+	///
+	/// @brief Clear the wake-up and emit woken()
+	///
+	void handleWakeUp();
+
+private:
+	/// self pipe, written by the producer and watched by the notifier in the consumer thread
+	int _pipe[2];
+	QSocketNotifier* _notifier;
+	/// a wake-up is on the way and not handled by the consumer yet
+	std::atomic<bool> _pending;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+// STL includes
+#include <cstdint>
+#include <ostream>
+
+///
+/// Plain-Old-Data structure containing the red-green-blue color specification padded to 4 bytes.
+/// Used as processing format, every pixel is 32bit aligned and a SIMD register holds a whole number of pixels
+///
+struct ColorRgbx
+{
+	/// The red color channel
+	uint8_t red;
+	/// The green color channel
+	uint8_t green;
+	/// The blue color channel
+	uint8_t blue;
+	/// Unused padding
+	uint8_t x;
+};
+
+/// Assert to ensure that the size of the structure is 'only' 4 bytes
+static_assert(sizeof(ColorRgbx) == 4, "Incorrect size of ColorRgbx");
+
+///
+/// Stream operator to write ColorRgbx to an outputstream (format "'{'[red]','[green]','[blue]'}'")
+///
+/// @param os The output stream
+/// @param color The color to write
+/// @return The output stream (with the color written to it)
+///
+inline std::ostream& operator<<(std::ostream& os, const ColorRgbx& color)
+{
+	os << "{" << unsigned(color.red) << "," << unsigned(color.green) << "," << unsigned(color.blue) << "}";
+	return os;
+}
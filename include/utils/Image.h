@@ -16,16 +16,26 @@ public:
 
 	typedef Pixel_T pixel_type;
 
+	/// The alignment of the pixel memory, a cache line which covers every SIMD register width
+	static const size_t ALIGNMENT = 64;
+
+	///
+	/// The row layout of an image
+	///
+	enum Layout
+	{
+		/// Rows follow each other without gaps, memptr() can be used as a plain array of width*height pixels
+		PACKED,
+		/// Every row starts at an ALIGNMENT boundary, vectorized kernels can process whole aligned rows without tail handling
+		PADDED
+	};
+
 	///
 	/// Default constructor for an image
 	///
 	Image() :
-		_width(1),
-		_height(1),
-		_pixels(new Pixel_T[2]),
-		_endOfPixels(_pixels + 1)
+		Image(1, 1)
 	{
-		memset(_pixels, 0, 2*sizeof(Pixel_T));
 	}
 
 	///
@@ -33,14 +43,19 @@ public:
 	///
 	/// @param width The width of the image
 	/// @param height The height of the image
-	///
-	Image(const unsigned width, const unsigned height) :
-		_width(width),
-		_height(height),
-		_pixels(new Pixel_T[width * height + 1]),
-		_endOfPixels(_pixels + width * height)
+	/// @param layout The row layout of the image
+	///
+	Image(const unsigned width, const unsigned height, const Layout layout = PACKED) :
+		_width(0),
+		_height(0),
+		_stride(0),
+		_layout(layout),
+		_buffer(nullptr),
+		_pixels(nullptr),
+		_capacity(0)
 	{
-		memset(_pixels, 0, (_width*_height+1)*sizeof(Pixel_T));
+		resize(width, height);
+		memset(_pixels, 0, _capacity);
 	}
 
 	///
@@ -51,24 +66,18 @@ public:
 	/// @param background The color of the image
 	///
 	Image(const unsigned width, const unsigned height, const Pixel_T background) :
-		_width(width),
-		_height(height),
-		_pixels(new Pixel_T[width * height + 1]),
-		_endOfPixels(_pixels + width * height)
+		Image(width, height)
 	{
-		std::fill(_pixels, _endOfPixels, background);
+		std::fill(_pixels, _pixels + _width * _height, background);
 	}
 
 	///
-	/// Copy constructor for an image
+	/// Copy constructor for an image, the copy has the same layout
 	///
 	Image(const Image & other) :
-		_width(other._width),
-		_height(other._height),
-		_pixels(new Pixel_T[other._width * other._height + 1]),
-		_endOfPixels(_pixels + other._width * other._height)
+		Image(other._width, other._height, other._layout)
 	{
-		memcpy(_pixels, other._pixels, (long) other._width * other._height * sizeof(Pixel_T));
+		copy(other);
 	}
 
 	// Define assignment operator in terms of the copy constructor
@@ -84,16 +93,22 @@ public:
 		using std::swap;
 		swap(this->_width, s._width);
 		swap(this->_height, s._height);
+		swap(this->_stride, s._stride);
+		swap(this->_layout, s._layout);
+		swap(this->_buffer, s._buffer);
 		swap(this->_pixels, s._pixels);
-		swap(this->_endOfPixels, s._endOfPixels);
+		swap(this->_capacity, s._capacity);
 	}
 
 	// C++11
 	Image(Image&& src) noexcept
 		: _width(0)
 		, _height(0)
-		, _pixels(NULL)
-		, _endOfPixels(NULL)
+		, _stride(0)
+		, _layout(PACKED)
+		, _buffer(nullptr)
+		, _pixels(nullptr)
+		, _capacity(0)
 	{
 		src.swap(*this);
 	}
@@ -108,7 +123,7 @@ public:
 	///
 	~Image()
 	{
-		delete[] _pixels;
+		delete[] _buffer;
 	}
 
 	///
@@ -131,19 +146,67 @@ public:
 		return _height;
 	}
 
+	///
+	/// Returns the distance between two rows in bytes
+	///
+	inline size_t stride() const
+	{
+		return _stride;
+	}
+
+	///
+	/// Returns the row layout of the image
+	///
+	inline Layout layout() const
+	{
+		return _layout;
+	}
+
+	///
+	/// Returns true if the rows aren't padded, which is always the case for PACKED images
+	///
+	inline bool isContiguous() const
+	{
+		return _stride == _width * sizeof(Pixel_T);
+	}
+
+	///
+	/// Returns a color channel of a pixel, the pixels are counted row by row.
+	/// Padded images need a division per call, loops over an image should use row() instead
+	///
 	uint8_t red(const unsigned pixel) const
 	{
-		return (_pixels + pixel)->red;
+		return pixelAt(pixel).red;
 	}
 
 	uint8_t green(const unsigned pixel) const
 	{
-		return (_pixels + pixel)->green;
+		return pixelAt(pixel).green;
 	}
 
 	uint8_t blue(const unsigned pixel) const
 	{
-		return (_pixels + pixel)->blue;
+		return pixelAt(pixel).blue;
+	}
+
+	///
+	/// Returns a const pointer to the first pixel of a row
+	///
+	/// @param y The row index
+	///
+	inline const Pixel_T* row(const unsigned y) const
+	{
+		return reinterpret_cast<const Pixel_T*>(reinterpret_cast<const uint8_t*>(_pixels) + y * _stride);
+	}
+
+	///
+	/// Returns a pointer to the first pixel of a row
+	///
+	/// @param y The row index
+	///
+	inline Pixel_T* row(const unsigned y)
+	{
+		return reinterpret_cast<Pixel_T*>(reinterpret_cast<uint8_t*>(_pixels) + y * _stride);
 	}
 
 	///
@@ -156,7 +219,7 @@ public:
 	///
 	const Pixel_T& operator()(const unsigned x, const unsigned y) const
 	{
-		return _pixels[toIndex(x,y)];
+		return row(y)[x];
 	}
 
 	///
@@ -169,27 +232,34 @@ public:
 	///
 	Pixel_T& operator()(const unsigned x, const unsigned y)
 	{
-		return _pixels[toIndex(x,y)];
+		return row(y)[x];
 	}
 
-	/// Resize the image
+	/// Resize the image, the layout is kept
 	/// @param width The width of the image
 	/// @param height The height of the image
 	void resize(const unsigned width, const unsigned height)
 	{
-		if ((width*height) > unsigned((_endOfPixels-_pixels)))
+		const size_t rowSize = size_t(width) * sizeof(Pixel_T);
+		const size_t stride = (_layout == PADDED) ? ((rowSize + ALIGNMENT - 1) & ~(ALIGNMENT - 1)) : rowSize;
+
+		// one extra pixel as before, padded images get a whole aligned block so kernels may read past the last pixel
+		const size_t required = stride * height + ((_layout == PADDED) ? ALIGNMENT : sizeof(Pixel_T));
+		if (required > _capacity)
 		{
-			delete[] _pixels;
-			_pixels = new Pixel_T[width*height + 1];
-			_endOfPixels = _pixels + width*height;
+			delete[] _buffer;
+			_buffer = new uint8_t[required + ALIGNMENT - 1];
+			_pixels = reinterpret_cast<Pixel_T*>((reinterpret_cast<uintptr_t>(_buffer) + ALIGNMENT - 1) & ~uintptr_t(ALIGNMENT - 1));
+			_capacity = required;
 		}
 
 		_width = width;
 		_height = height;
+		_stride = stride;
 	}
 
 	///
-	/// Copies another image into this image. The images should have exactly the same size.
+	/// Copies another image into this image. The images should have exactly the same size, the layouts may differ.
 	///
 	/// @param other The image to copy into this
 	///
@@ -198,11 +268,48 @@ public:
 		assert(other._width == _width);
 		assert(other._height == _height);
 
-		memcpy(_pixels, other._pixels, _width*_height*sizeof(Pixel_T));
+		if (_stride == other._stride)
+		{
+			memcpy(_pixels, other._pixels, _stride * _height);
+			return;
+		}
+
+		for (unsigned y = 0; y < _height; ++y)
+		{
+			memcpy(row(y), other.row(y), _width * sizeof(Pixel_T));
+		}
+	}
+
+	///
+	/// Copies pixel data from a foreign buffer into this image, the rows are written with the stride of the image
+	///
+	/// @param data The pixels of the source, at least height() rows of width() pixels
+	/// @param lineLength The distance between two rows of the source in bytes, 0 for rows without gaps
+	///
+	void copyFrom(const void* data, size_t lineLength = 0)
+	{
+		const size_t rowSize = _width * sizeof(Pixel_T);
+		if (lineLength == 0)
+		{
+			lineLength = rowSize;
+		}
+
+		if (lineLength == _stride)
+		{
+			memcpy(_pixels, data, _stride * _height);
+			return;
+		}
+
+		const uint8_t* source = static_cast<const uint8_t*>(data);
+		for (unsigned y = 0; y < _height; ++y, source += lineLength)
+		{
+			memcpy(row(y), source, rowSize);
+		}
 	}
 
 	///
-	/// Returns a memory pointer to the first pixel in the image
+	/// Returns a memory pointer to the first pixel in the image, the rows are stride() bytes apart.
+	/// Only a PACKED image can be used as a plain array of width()*height() pixels, use row() or copyFrom() otherwise
 	/// @return The memory pointer to the first pixel
 	///
 	Pixel_T* memptr()
@@ -211,7 +318,8 @@ public:
 	}
 
 	///
-	/// Returns a const memory pointer to the first pixel in the image
+	/// Returns a const memory pointer to the first pixel in the image, the rows are stride() bytes apart.
+	/// Only a PACKED image can be used as a plain array of width()*height() pixels, use row() otherwise
 	/// @return The const memory pointer to the first pixel
 	///
 	const Pixel_T* memptr() const
@@ -225,20 +333,23 @@ public:
 	///
 	/// @param[out] image  The image that buffers the output
 	///
-	void toRgb(Image<ColorRgb>& image)
+	void toRgb(Image<ColorRgb>& image) const
 	{
 		image.resize(_width, _height);
-		const unsigned imageSize = _width * _height;
 
-		for (unsigned idx=0; idx<imageSize; idx++)
+		for (unsigned y = 0; y < _height; ++y)
 		{
-			const Pixel_T color = memptr()[idx];
-			image.memptr()[idx] = ColorRgb{color.red, color.green, color.blue};
+			const Pixel_T* source = row(y);
+			ColorRgb* dest = image.row(y);
+			for (unsigned x = 0; x < _width; ++x)
+			{
+				dest[x] = ColorRgb{source[x].red, source[x].green, source[x].blue};
+			}
 		}
 	}
 
 	///
-	/// get size of buffer
+	/// get size of the pixel data without the row padding
 	//
 	ssize_t size() const
 	{
@@ -246,29 +357,25 @@ public:
 	}
 
 private:
-
-	///
-	/// Translate x and y coordinate to index of the underlying vector
-	///
-	/// @param x The x index
-	/// @param y The y index
-	///
-	/// @return The index into the underlying data-vector
-	///
-	inline unsigned toIndex(const unsigned x, const unsigned y) const
+	/// The pixel at an index which counts the pixels row by row
+	inline const Pixel_T& pixelAt(const unsigned pixel) const
 	{
-		return y*_width + x;
+		return isContiguous() ? _pixels[pixel] : (*this)(pixel % _width, pixel / _width);
 	}
 
-private:
 	/// The width of the image
 	unsigned _width;
 	/// The height of the image
 	unsigned _height;
-
-	/// The pixels of the image
+	/// The distance between two rows in bytes
+	size_t _stride;
+	/// The row layout
+	Layout _layout;
+
+	/// The allocated memory
+	uint8_t* _buffer;
+	/// The pixels of the image, aligned within _buffer
 	Pixel_T* _pixels;
-
-	/// Pointer to the last(extra) pixel
-	Pixel_T* _endOfPixels;
+	/// The usable size of the memory starting at _pixels in bytes
+	size_t _capacity;
 };
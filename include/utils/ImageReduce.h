@@ -0,0 +1,106 @@
+#pragma once
+
+// STL includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+///
+/// Reductions over runs of pixels, which are used by the led mapping and the black border detection.
+/// They work on any pixel type with red, green and blue members (ColorRgb, ColorBgr, ColorRgba, ColorRgbx). The inner loops are
+/// free of branches and use narrow accumulators, so the compiler can vectorize them on every platform.
+///
+namespace ImageReduce
+{
+	///
+	/// The sums of the color channels of a number of pixels
+	///
+	struct ChannelSums
+	{
+		uint64_t red   = 0;
+		uint64_t green = 0;
+		uint64_t blue  = 0;
+	};
+
+	///
+	/// @brief Add the color channels of a run of pixels to the sums
+	///
+	/// @param pixels  The first pixel of the run
+	/// @param count   The number of pixels
+	/// @param sums    The sums to add to
+	///
+	template <typename Pixel_T>
+	void sumChannels(const Pixel_T* pixels, size_t count, ChannelSums& sums)
+	{
+		// 32 bit accumulators can't overflow within a chunk: 255 * 2^24 < 2^32
+		const size_t CHUNK_SIZE = size_t(1) << 24;
+
+		while (count > 0)
+		{
+			const size_t chunk = std::min(count, CHUNK_SIZE);
+			uint32_t red   = 0;
+			uint32_t green = 0;
+			uint32_t blue  = 0;
+
+			for (size_t i = 0; i < chunk; ++i)
+			{
+				red   += pixels[i].red;
+				green += pixels[i].green;
+				blue  += pixels[i].blue;
+			}
+
+			sums.red   += red;
+			sums.green += green;
+			sums.blue  += blue;
+			pixels += chunk;
+			count  -= chunk;
+		}
+	}
+
+	///
+	/// @brief Find the first pixel along a line which reaches the threshold in at least one channel
+	///
+	/// @param first      The first pixel of the line
+	/// @param count      The number of pixels to check
+	/// @param step       The distance between two pixels of the line in bytes, e.g. the stride for a column or negative to walk backwards
+	/// @param threshold  The threshold of a non black pixel
+	///
+	/// @return The index of the first non black pixel, count if all pixels are black
+	///
+	template <typename Pixel_T>
+	int firstNonBlack(const Pixel_T* first, const int count, const ptrdiff_t step, const uint8_t threshold)
+	{
+		const int BLOCK_SIZE = 16;
+		const uint8_t* line = reinterpret_cast<const uint8_t*>(first);
+		const auto isNonBlack = [threshold](const Pixel_T& pixel)
+		{
+			return uint8_t(pixel.red >= threshold) | uint8_t(pixel.green >= threshold) | uint8_t(pixel.blue >= threshold);
+		};
+
+		// skip whole blocks of black pixels without branching per pixel
+		int index = 0;
+		for (; index + BLOCK_SIZE <= count; index += BLOCK_SIZE)
+		{
+			uint8_t nonBlack = 0;
+			for (int i = index; i < index + BLOCK_SIZE; ++i)
+			{
+				nonBlack |= isNonBlack(*reinterpret_cast<const Pixel_T*>(line + i * step));
+			}
+
+			if (nonBlack)
+			{
+				break;
+			}
+		}
+
+		for (; index < count; ++index)
+		{
+			if (isNonBlack(*reinterpret_cast<const Pixel_T*>(line + index * step)))
+			{
+				return index;
+			}
+		}
+
+		return count;
+	}
+}
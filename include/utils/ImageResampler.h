@@ -4,10 +4,24 @@
 #include <utils/PixelFormat.h>
 #include <utils/Image.h>
 #include <utils/ColorRgb.h>
+#include <utils/ColorRgbx.h>
+
+#include <QString>
 
 class ImageResampler
 {
 public:
+	///
+	/// How the decimation reduces a block of pixels
+	///
+	enum DecimationMode
+	{
+		/// take the center pixel of a block
+		DECIMATION_SAMPLE,
+		/// average all pixels of a block, which avoids aliasing on fine patterns at the cost of reading every pixel
+		DECIMATION_AVERAGE
+	};
+
 	ImageResampler();
 	~ImageResampler();
 
@@ -22,13 +36,60 @@ public:
 
 	void setVideoMode(VideoMode mode);
 
+	void setDecimationMode(DecimationMode mode);
+
+	DecimationMode getDecimationMode() const { return _decimationMode; }
+
+	///
+	/// @brief Parse the decimation mode of a configuration ("sample" or "average")
+	///
+	static DecimationMode parseDecimationMode(const QString& mode);
+
 	void processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgb> & outputImage) const;
 
-private:
-	static inline uint8_t clamp(int x);
-	static void yuv2rgb(uint8_t y, uint8_t u, uint8_t v, uint8_t & r, uint8_t & g, uint8_t & b);
+	///
+	/// @brief Same as above, but writes 4 byte RGBX pixels, e.g. into a Image::PADDED image for vectorized processing
+	///
+	void processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgbx> & outputImage) const;
+
+	///
+	/// @brief Convert a sparse grid of source pixels, e.g. to probe a frame cheaply. Cropping, video mode and decimation don't apply,
+	/// the size of the output image gives the number of columns and rows of the grid
+	///
+	void processSamples(const uint8_t * data, int height, int lineLength, PixelFormat pixelFormat, int xStart, int yStart, int xStep, int yStep, Image<ColorRgb> & outputImage) const;
+
+	///
+	/// @brief Get the cropping of a frame including the cropping of the 3D video mode
+	///
+	void getCropping(int width, int height, int & cropLeft, int & cropRight, int & cropTop, int & cropBottom) const;
+
+	static inline uint8_t clamp(int x)
+	{
+		return (x<0) ? 0 : ((x>255) ? 255 : uint8_t(x));
+	}
+
+	static inline void yuv2rgb(uint8_t y, uint8_t u, uint8_t v, uint8_t & r, uint8_t & g, uint8_t & b)
+	{
+		// see: http://en.wikipedia.org/wiki/YUV#Y.27UV444_to_RGB888_conversion
+		int c = y - 16;
+		int d = u - 128;
+		int e = v - 128;
+
+		r = clamp((298 * c + 409 * e + 128) >> 8);
+		g = clamp((298 * c - 100 * d - 208 * e + 128) >> 8);
+		b = clamp((298 * c + 516 * d + 128) >> 8);
+	}
 
 private:
+	template <typename Pixel_T>
+	void resample(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<Pixel_T> & outputImage) const;
+
+	template <typename Pixel_T>
+	void sample(const uint8_t * data, int height, int lineLength, PixelFormat pixelFormat, int xStart, int yStart, int xStep, int yStep, Image<Pixel_T> & outputImage) const;
+
+	template <typename Pixel_T>
+	void average(const uint8_t * data, int height, int lineLength, PixelFormat pixelFormat, int xStart, int yStart, int xEnd, int yEnd, Image<Pixel_T> & outputImage) const;
+
 	int _horizontalDecimation;
 	int _verticalDecimation;
 	int _cropLeft;
@@ -36,4 +97,5 @@ private:
 	int _cropTop;
 	int _cropBottom;
 	VideoMode _videoMode;
+	DecimationMode _decimationMode;
 };
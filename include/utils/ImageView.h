@@ -0,0 +1,178 @@
+#pragma once
+
+// STL includes
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <utils/Image.h>
+
+///
+/// A non-owning view on pixels in a buffer of someone else, e.g. a mmap'd capture buffer or a shared memory segment.
+/// The rows may be padded, the distance between two rows is given by the stride in bytes.
+/// The lifetime handle keeps the buffer alive as long as any view on it exists, it's empty if the owner guarantees
+/// the lifetime by other means (e.g. a view on an Image used within a call).
+///
+template <typename Pixel_T>
+class ImageView
+{
+public:
+
+	typedef Pixel_T pixel_type;
+
+	///
+	/// Constructs an empty view
+	///
+	ImageView()
+		: _width(0)
+		, _height(0)
+		, _stride(0)
+		, _data(nullptr)
+		, _owner()
+	{
+	}
+
+	///
+	/// Constructs a view on a buffer
+	///
+	/// @param data    Pointer to the first pixel
+	/// @param width   The width of the view
+	/// @param height  The height of the view
+	/// @param stride  The distance between two rows in bytes
+	/// @param owner   Keeps the buffer alive while the view exists (optional)
+	///
+	ImageView(const Pixel_T* data, const unsigned width, const unsigned height, const size_t stride, std::shared_ptr<const void> owner = nullptr)
+		: _width(width)
+		, _height(height)
+		, _stride(stride)
+		, _data(reinterpret_cast<const uint8_t*>(data))
+		, _owner(std::move(owner))
+	{
+	}
+
+	///
+	/// Constructs a view on an image, the image must outlive the view
+	///
+	explicit ImageView(const Image<Pixel_T>& image)
+		: _width(image.width())
+		, _height(image.height())
+		, _stride(image.stride())
+		, _data(reinterpret_cast<const uint8_t*>(image.memptr()))
+		, _owner()
+	{
+	}
+
+	///
+	/// Returns the width of the view
+	///
+	inline unsigned width() const
+	{
+		return _width;
+	}
+
+	///
+	/// Returns the height of the view
+	///
+	inline unsigned height() const
+	{
+		return _height;
+	}
+
+	///
+	/// Returns the distance between two rows in bytes
+	///
+	inline size_t stride() const
+	{
+		return _stride;
+	}
+
+	///
+	/// Returns true if the rows aren't padded, so the view can be accessed like the memory of an Image
+	///
+	inline bool isContiguous() const
+	{
+		return _stride == _width * sizeof(Pixel_T);
+	}
+
+	///
+	/// Returns a pointer to the first pixel of a row
+	///
+	/// @param y The row index
+	///
+	inline const Pixel_T* row(const unsigned y) const
+	{
+		return reinterpret_cast<const Pixel_T*>(_data + y * _stride);
+	}
+
+	///
+	/// Returns a const reference to a specified pixel in the view
+	///
+	/// @param x The x index
+	/// @param y The y index
+	///
+	/// @return const reference to specified pixel
+	///
+	inline const Pixel_T& operator()(const unsigned x, const unsigned y) const
+	{
+		return row(y)[x];
+	}
+
+	///
+	/// Returns a view on a part of this view, nothing is copied. The part is clipped to the view
+	///
+	/// @param x       The left column of the part
+	/// @param y       The top row of the part
+	/// @param width   The width of the part
+	/// @param height  The height of the part
+	///
+	ImageView crop(unsigned x, unsigned y, unsigned width, unsigned height) const
+	{
+		x = std::min(x, _width);
+		y = std::min(y, _height);
+		width  = std::min(width,  _width  - x);
+		height = std::min(height, _height - y);
+
+		return ImageView(row(y) + x, width, height, _stride, _owner);
+	}
+
+	///
+	/// Copies the view into an image
+	///
+	/// @param[out] image  The image, it's resized to the size of the view
+	///
+	void copyTo(Image<Pixel_T>& image) const
+	{
+		image.resize(_width, _height);
+		if (isContiguous() && image.isContiguous())
+		{
+			memcpy(image.memptr(), _data, _width * _height * sizeof(Pixel_T));
+			return;
+		}
+
+		for (unsigned y = 0; y < _height; ++y)
+		{
+			memcpy(image.row(y), row(y), _width * sizeof(Pixel_T));
+		}
+	}
+
+	///
+	/// Returns the lifetime handle of the buffer
+	///
+	const std::shared_ptr<const void>& owner() const
+	{
+		return _owner;
+	}
+
+private:
+	/// The width of the view
+	unsigned _width;
+	/// The height of the view
+	unsigned _height;
+	/// The distance between two rows in bytes
+	size_t _stride;
+
+	/// The first pixel
+	const uint8_t* _data;
+
+	/// Keeps the buffer alive
+	std::shared_ptr<const void> _owner;
+};
@@ -9,6 +9,7 @@
 #include <stdarg.h>
 #include <map>
 #include <QVector>
+#include <QMutex>
 
 #include <utils/global_defines.h>
 
@@ -16,16 +17,17 @@
 //#define _FUNCNAME_ __PRETTY_FUNCTION__
 #define _FUNCNAME_ __FUNCTION__
 
-#define Debug(logger, ...)   { (logger)->Message(Logger::DEBUG  , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__); }
-#define Info(logger, ...)    { (logger)->Message(Logger::INFO   , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__); }
-#define Warning(logger, ...) { (logger)->Message(Logger::WARNING, __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__); }
-#define Error(logger, ...)   { (logger)->Message(Logger::ERROR  , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__); }
+// the level is checked before the arguments are evaluated and formatted
+#define Debug(logger, ...)   { if ((logger)->isLevelEnabled(Logger::DEBUG))   {(logger)->Message(Logger::DEBUG  , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__);} }
+#define Info(logger, ...)    { if ((logger)->isLevelEnabled(Logger::INFO))    {(logger)->Message(Logger::INFO   , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__);} }
+#define Warning(logger, ...) { if ((logger)->isLevelEnabled(Logger::WARNING)) {(logger)->Message(Logger::WARNING, __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__);} }
+#define Error(logger, ...)   { if ((logger)->isLevelEnabled(Logger::ERROR))   {(logger)->Message(Logger::ERROR  , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__);} }
 
 // conditional log messages
-#define DebugIf(condition, logger, ...)   { if (condition) {(logger)->Message(Logger::DEBUG   , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__);} }
-#define InfoIf(condition, logger, ...)    { if (condition) {(logger)->Message(Logger::INFO    , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__);} }
-#define WarningIf(condition, logger, ...) { if (condition) {(logger)->Message(Logger::WARNING , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__);} }
-#define ErrorIf(condition, logger, ...)   { if (condition) {(logger)->Message(Logger::ERROR   , __FILE__, _FUNCNAME_, __LINE__, __VA_ARGS__);} }
+#define DebugIf(condition, logger, ...)   { if (condition) Debug(logger, __VA_ARGS__) }
+#define InfoIf(condition, logger, ...)    { if (condition) Info(logger, __VA_ARGS__) }
+#define WarningIf(condition, logger, ...) { if (condition) Warning(logger, __VA_ARGS__) }
+#define ErrorIf(condition, logger, ...)   { if (condition) Error(logger, __VA_ARGS__) }
 
 // ================================================================
 
@@ -54,12 +56,21 @@ public:
 	static void     setLogLevel(LogLevel level, QString name="");
 	static LogLevel getLogLevel(QString name="");
 
+	///
+	/// @brief Queue a log message. The message is formatted on the calling thread and handed over lock free
+	///        to a background writer which does the console/syslog output and feeds the LoggerManager
+	///
 	void     Message(LogLevel level, const char* sourceFile, const char* func, unsigned int line, const char* fmt, ...);
 	void     setMinLevel(LogLevel level) { _minLevel = level; };
 	LogLevel getMinLevel() { return _minLevel; };
 
-signals:
-	void newLogMessage(Logger::T_LOG_MESSAGE);
+	///
+	/// @brief Check if a message with the given level would be logged, used to skip argument evaluation
+	///
+	bool     isLevelEnabled(LogLevel level) const
+	{
+		return (GLOBAL_MIN_LOG_LEVEL == Logger::UNSET) ? level >= _minLevel : level >= GLOBAL_MIN_LOG_LEVEL;
+	};
 
 protected:
 	Logger( QString name="", LogLevel minLevel=INFO);
@@ -83,9 +94,16 @@ class LoggerManager : public QObject
 
 public:
 	static LoggerManager* getInstance();
-	QVector<Logger::T_LOG_MESSAGE>* getLogMessageBuffer() { return &_logMessageBuffer; };
+
+	///
+	/// @brief Get the recent log messages, oldest first
+	///
+	QVector<Logger::T_LOG_MESSAGE> getLogMessageBuffer();
 
 public slots:
+	///
+	/// @brief Store a new log message in the history and notify listeners. Called from the log writer thread
+	///
 	void handleNewLogMessage(const Logger::T_LOG_MESSAGE&);
 
 signals:
@@ -95,7 +113,10 @@ protected:
 	LoggerManager();
 
 	static LoggerManager*          _instance;
+	/// ring buffer of the recent messages, _logMessageBufferPos points to the oldest entry once it's full
 	QVector<Logger::T_LOG_MESSAGE> _logMessageBuffer;
+	int                            _logMessageBufferPos;
+	QMutex                         _logMessageBufferMutex;
 	const int                      _loggerMaxMsgBufferSize;
 };
 
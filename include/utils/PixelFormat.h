@@ -12,6 +12,12 @@ enum PixelFormat {
 	PIXELFORMAT_BGR24,
 	PIXELFORMAT_RGB32,
 	PIXELFORMAT_BGR32,
+	PIXELFORMAT_RGB24,
+	PIXELFORMAT_NV12,
+	PIXELFORMAT_NV21,
+	PIXELFORMAT_I420,
+	PIXELFORMAT_YV12,
+	PIXELFORMAT_GREY,
 #ifdef HAVE_JPEG
 	PIXELFORMAT_MJPEG,
 #endif
@@ -31,8 +37,9 @@ inline PixelFormat parsePixelFormat(QString pixelFormat)
 	{
 		return PIXELFORMAT_UYVY;
 	}
-	else if (pixelFormat == "bgr16")
+	else if (pixelFormat == "bgr16" || pixelFormat == "rgb565")
 	{
+		// little endian RGB565 as delivered by v4l2 and framebuffers
 		return PIXELFORMAT_BGR16;
 	}
 	else if (pixelFormat == "bgr24")
@@ -47,6 +54,30 @@ inline PixelFormat parsePixelFormat(QString pixelFormat)
 	{
 		return PIXELFORMAT_BGR32;
 	}
+	else if (pixelFormat == "rgb24")
+	{
+		return PIXELFORMAT_RGB24;
+	}
+	else if (pixelFormat == "nv12")
+	{
+		return PIXELFORMAT_NV12;
+	}
+	else if (pixelFormat == "nv21")
+	{
+		return PIXELFORMAT_NV21;
+	}
+	else if (pixelFormat == "i420")
+	{
+		return PIXELFORMAT_I420;
+	}
+	else if (pixelFormat == "yv12")
+	{
+		return PIXELFORMAT_YV12;
+	}
+	else if (pixelFormat == "grey")
+	{
+		return PIXELFORMAT_GREY;
+	}
 #ifdef HAVE_JPEG
 	else if (pixelFormat == "mjpeg")
 	{
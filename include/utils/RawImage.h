@@ -0,0 +1,78 @@
+#pragma once
+
+// stl includes
+#include <cstddef>
+#include <cstdint>
+
+// util includes
+#include <utils/PixelFormat.h>
+
+///
+/// @brief A captured frame in the pixel format of the capture device. It doesn't own the pixel data.
+/// The leds can be mapped directly on it (see hyperion::ImageToLedsMap), without converting the complete frame to RGB first
+///
+struct RawImage
+{
+	PixelFormat pixelFormat = PIXELFORMAT_NO_CHANGE;
+	int width      = 0;
+	int height     = 0;
+	int lineLength = 0;
+
+	/// The region the leds are mapped on
+	int cropLeft   = 0;
+	int cropRight  = 0;
+	int cropTop    = 0;
+	int cropBottom = 0;
+
+	/// Sample every n-th pixel in both directions
+	int pixelDecimation = 1;
+
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+
+	int regionWidth() const { return width - cropLeft - cropRight; }
+	int regionHeight() const { return height - cropTop - cropBottom; }
+
+	/// The size of the sampled grid, it matches the image ImageResampler creates with the same cropping and decimation
+	int sampledWidth() const { return (regionWidth() - (pixelDecimation >> 1) + pixelDecimation - 1) / pixelDecimation; }
+	int sampledHeight() const { return (regionHeight() - (pixelDecimation >> 1) + pixelDecimation - 1) / pixelDecimation; }
+
+	/// The source coordinates of a sample of the grid
+	int sourceX(int x) const { return cropLeft + (pixelDecimation >> 1) + x * pixelDecimation; }
+	int sourceY(int y) const { return cropTop + (pixelDecimation >> 1) + y * pixelDecimation; }
+
+	/// packed RGB frames are processed as an ImageView, which can't skip columns, so they can't be decimated
+	bool isValid() const
+	{
+		return data != nullptr && pixelDecimation > 0 && sampledWidth() > 0 && sampledHeight() > 0
+			&& (pixelDecimation == 1 || !isPackedRgb(pixelFormat));
+	}
+
+	///
+	/// @brief Check if the leds can be mapped on frames of the pixel format, which is the case for the YUV formats and packed RGB
+	///
+	static bool isMappable(const PixelFormat& pixelFormat)
+	{
+		switch (pixelFormat)
+		{
+			case PIXELFORMAT_YUYV:
+			case PIXELFORMAT_UYVY:
+			case PIXELFORMAT_NV12:
+			case PIXELFORMAT_NV21:
+			case PIXELFORMAT_I420:
+			case PIXELFORMAT_YV12:
+				return true;
+			default:
+				return isPackedRgb(pixelFormat);
+		}
+	}
+
+	///
+	/// @brief Check if the pixels of the format have the layout of a color type (ColorRgb, ColorBgr, ColorRgba),
+	/// so the frame can be processed in place as an ImageView
+	///
+	static bool isPackedRgb(const PixelFormat& pixelFormat)
+	{
+		return pixelFormat == PIXELFORMAT_RGB24 || pixelFormat == PIXELFORMAT_BGR24 || pixelFormat == PIXELFORMAT_RGB32;
+	}
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+// stl includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+///
+/// @brief Defines how a value is copied into a slot of a SpscChannel. Specialize for types which can reuse the buffer of the slot
+///
+template <typename T>
+struct ChannelAssign
+{
+	static void assign(T& slot, const T& value)
+	{
+		slot = value;
+	}
+};
+
+///
+/// @brief Lock free channel with a single producer and a single consumer thread for frame and led data handoff.
+///
+/// All slots are allocated once, values are copied into a slot by the producer (see ChannelAssign) and swapped out by the consumer,
+/// so the buffers keep circulating between both sides instead of being allocated per value.
+///
+/// In QUEUE mode every value is delivered in order, push() fails when the consumer lags behind for more than the capacity.
+/// In LATEST mode (triple buffer) push() never fails and overwrites a value which has not been consumed yet, the consumer always gets the newest.
+/// Both cases are counted as dropped values to make the backpressure visible.
+///
+template <typename T>
+class SpscChannel
+{
+public:
+	enum Mode
+	{
+		QUEUE,
+		LATEST
+	};
+
+	///
+	/// @param mode      The delivery mode
+	/// @param capacity  The number of queued values in QUEUE mode, rounded up to a power of two. Ignored in LATEST mode
+	///
+	SpscChannel(const Mode& mode = LATEST, size_t capacity = 4)
+		: _mode(mode)
+		, _mask(0)
+		, _head(0)
+		, _tail(0)
+		, _middle(MIDDLE_INITIAL)
+		, _back(BACK_INITIAL)
+		, _front(FRONT_INITIAL)
+		, _dropped(0)
+	{
+		size_t slots = 3;
+		if (_mode == QUEUE)
+		{
+			slots = 1;
+			while (slots < capacity)
+				slots <<= 1;
+			_mask = slots - 1;
+		}
+		_slots.resize(slots);
+	}
+
+	SpscChannel(const SpscChannel&) = delete;
+	SpscChannel& operator=(const SpscChannel&) = delete;
+
+	///
+	/// @brief Hand over a value, producer thread only
+	/// @param value  The value to copy into the channel
+	/// @return       False if the value was dropped because the queue is full (QUEUE mode only)
+	///
+	bool push(const T& value)
+	{
+		return write([&value](T& slot) { ChannelAssign<T>::assign(slot, value); });
+	}
+
+	///
+	/// @brief Hand over a value which is written in place into the slot, producer thread only
+	/// @param writer  Callable which gets the slot (T&) to fill, the slot holds a previously consumed value
+	/// @return        False if the value was dropped because the queue is full (QUEUE mode only)
+	///
+	template <typename Writer>
+	bool write(Writer writer)
+	{
+		if (_mode == LATEST)
+		{
+			writer(_slots[_back]);
+			const uint8_t previous = _middle.exchange(_back | FRESH, std::memory_order_acq_rel);
+			_back = previous & INDEX_MASK;
+			if (previous & FRESH)
+				_dropped.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		const size_t head = _head.load(std::memory_order_relaxed);
+		if (head - _tail.load(std::memory_order_acquire) > _mask)
+		{
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		writer(_slots[head & _mask]);
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	///
+	/// @brief Take the next value, consumer thread only. The value is swapped with the content of value, whose buffer is recycled by the producer
+	/// @param value  Receives the value
+	/// @return       False if there is no new value
+	///
+	bool pop(T& value)
+	{
+		using std::swap;
+
+		if (_mode == LATEST)
+		{
+			if (!(_middle.load(std::memory_order_acquire) & FRESH))
+				return false;
+
+			_front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX_MASK;
+			swap(value, _slots[_front]);
+			return true;
+		}
+
+		const size_t tail = _tail.load(std::memory_order_relaxed);
+		if (tail == _head.load(std::memory_order_acquire))
+			return false;
+
+		swap(value, _slots[tail & _mask]);
+		_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	///
+	/// @brief Get and reset the number of dropped (QUEUE) or overwritten (LATEST) values since the last call
+	///
+	uint64_t takeDropped()
+	{
+		return _dropped.exchange(0, std::memory_order_relaxed);
+	}
+
+	///
+	/// @brief Drop all pending values. Neither producer nor consumer may access the channel concurrently
+	///
+	void reset()
+	{
+		_tail.store(_head.load());
+		_middle.store(_middle.load() & INDEX_MASK);
+		_dropped.store(0);
+	}
+
+private:
+	static const uint8_t INDEX_MASK     = 0x03;
+	static const uint8_t FRESH          = 0x04;
+	static const uint8_t FRONT_INITIAL  = 0;
+	static const uint8_t MIDDLE_INITIAL = 1;
+	static const uint8_t BACK_INITIAL   = 2;
+
+	const Mode _mode;
+	std::vector<T> _slots;
+
+	// QUEUE mode
+	size_t _mask;
+	std::atomic<size_t> _head;
+	std::atomic<size_t> _tail;
+
+	// LATEST mode, the slot index in the middle is exchanged by both sides, back is owned by the producer, front by the consumer
+	std::atomic<uint8_t> _middle;
+	uint8_t _back;
+	uint8_t _front;
+
+	std::atomic<uint64_t> _dropped;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+// qt
+#include <QJsonObject>
+#include <QString>
+
+class QThread;
+
+///
+/// @brief Applies scheduling policy, realtime priority, niceness and cpu affinity to the threads of the processing pipeline.
+/// Threads are registered with a role and get the settings of their role applied when they start and whenever the
+/// "scheduling" settings change. Settings the process is not permitted to apply are logged and skipped, the thread keeps running with the previous ones.
+///
+class ThreadScheduler
+{
+public:
+	/// The pipeline stages which may be tuned
+	enum Role
+	{
+		CAPTURE = 0,
+		INSTANCE,
+		DEVICE,
+		ROLE_COUNT
+	};
+
+	///
+	/// @brief Set the scheduling configuration and re-apply it to all running threads
+	/// @param config  The "scheduling" settings object
+	///
+	static void setConfig(const QJsonObject& config);
+
+	///
+	/// @brief Register a thread for the given role. Must be called before the thread is started,
+	///        the settings are applied from within the thread once it runs and dropped when it finishes
+	/// @param thread  The thread to manage
+	/// @param role    The pipeline role of the thread
+	///
+	static void manageThread(QThread* thread, const Role& role);
+
+	///
+	/// @brief Convert a role to its settings key
+	/// @param role  The role
+	/// @return      The key of the role in the "scheduling" settings object
+	///
+	static QString roleToString(const Role& role);
+
+private:
+	///
+	/// @brief Register the calling thread and apply the settings of role to it
+	///
+	static void registerCurrentThread(const Role& role);
+
+	///
+	/// @brief Remove the calling thread from the registry
+	///
+	static void unregisterCurrentThread();
+};
@@ -13,7 +13,7 @@
 ///
 namespace hyperion {
 
-	void handleInitialEffect(Hyperion* hyperion, const QJsonObject& FGEffectConfig)
+	inline void handleInitialEffect(Hyperion* hyperion, const QJsonObject& FGEffectConfig)
 	{
 		#define FGCONFIG_ARRAY fgColorConfig.toArray()
 		const int FG_PRIORITY = 0;
@@ -51,12 +51,12 @@ namespace hyperion {
 		#undef FGCONFIG_ARRAY
 	}
 
-	ColorOrder createColorOrder(const QJsonObject &deviceConfig)
+	inline ColorOrder createColorOrder(const QJsonObject &deviceConfig)
 	{
 		return stringToColorOrder(deviceConfig["colorOrder"].toString("rgb"));
 	}
 
-	RgbTransform* createRgbTransform(const QJsonObject& colorConfig)
+	inline RgbTransform* createRgbTransform(const QJsonObject& colorConfig)
 	{
 		const double backlightThreshold = colorConfig["backlightThreshold"].toDouble(0.0);
 		const bool   backlightColored   = colorConfig["backlightColored"].toBool(false);
@@ -70,7 +70,7 @@ namespace hyperion {
 		return transform;
 	}
 
-	RgbChannelAdjustment* createRgbChannelAdjustment(const QJsonObject& colorConfig, const QString channelName, const int defaultR, const int defaultG, const int defaultB)
+	inline RgbChannelAdjustment* createRgbChannelAdjustment(const QJsonObject& colorConfig, const QString channelName, const int defaultR, const int defaultG, const int defaultB)
 	{
 		const QJsonArray& channelConfig  = colorConfig[channelName].toArray();
 		RgbChannelAdjustment* adjustment =  new RgbChannelAdjustment(
@@ -82,7 +82,7 @@ namespace hyperion {
 		return adjustment;
 	}
 
-	ColorAdjustment * createColorAdjustment(const QJsonObject & adjustmentConfig)
+	inline ColorAdjustment * createColorAdjustment(const QJsonObject & adjustmentConfig)
 	{
 		const QString id = adjustmentConfig["id"].toString("default");
 
@@ -122,7 +122,7 @@ namespace hyperion {
 		return adjustment;
 	}
 
-	MultiColorAdjustment * createLedColorsAdjustment(const unsigned ledCnt, const QJsonObject & colorConfig)
+	inline MultiColorAdjustment * createLedColorsAdjustment(const unsigned ledCnt, const QJsonObject & colorConfig)
 	{
 		// Create the result, the transforms are added to this
 		MultiColorAdjustment * adjustment = new MultiColorAdjustment(ledCnt);
@@ -188,7 +188,7 @@ namespace hyperion {
 	 * @param deviceOrder  The default RGB channel ordering
 	 * @return The constructed ledstring
 	 */
-	LedString createLedString(const QJsonArray& ledConfigArray, const ColorOrder deviceOrder)
+	inline LedString createLedString(const QJsonArray& ledConfigArray, const ColorOrder deviceOrder)
 	{
 		LedString ledString;
 		const QString deviceOrderStr = colorOrderToString(deviceOrder);
@@ -236,7 +236,7 @@ namespace hyperion {
 		return ledString;
 	}
 
-	LedString createLedStringClone(const QJsonArray& ledConfigArray, const ColorOrder deviceOrder)
+	inline LedString createLedStringClone(const QJsonArray& ledConfigArray, const ColorOrder deviceOrder)
 	{
 		LedString ledString;
 		const QString deviceOrderStr = colorOrderToString(deviceOrder);
@@ -275,7 +275,7 @@ namespace hyperion {
 		return ledString;
 	}
 
-	QSize getLedLayoutGridSize(const QJsonArray& ledConfigArray)
+	inline QSize getLedLayoutGridSize(const QJsonArray& ledConfigArray)
 	{
 		std::vector<int> midPointsX;
 		std::vector<int> midPointsY;
@@ -319,4 +319,41 @@ namespace hyperion {
 
 		return gridSize;
 	}
+
+	///
+	/// @brief Get the image size a remote sender should provide for a led layout. Larger images don't improve the led colors,
+	/// so a sender may downscale its images as long as they stay at least this large
+	/// @param ledConfigArray  The led layout
+	/// @return The target size, invalid if the layout is empty
+	///
+	inline QSize getRemoteImageTargetSize(const QJsonArray& ledConfigArray)
+	{
+		// 8 pixels per led column and row like the v4l2 mode negotiation, but enough pixels for the black border detection
+		const int PIXELS_PER_LED = 8;
+		const int MIN_SIZE = 64;
+
+		const QSize gridSize = getLedLayoutGridSize(ledConfigArray);
+		if (gridSize.isEmpty())
+		{
+			return QSize();
+		}
+
+		return QSize(qMax(MIN_SIZE, gridSize.width() * PIXELS_PER_LED), qMax(MIN_SIZE, gridSize.height() * PIXELS_PER_LED));
+	}
+
+	///
+	/// @brief Get the frame rate a remote sender should not exceed. The smoothing writes the leds at its update frequency,
+	/// more frames than that are dropped by it anyway
+	/// @param smoothingConfig  The smoothing settings
+	/// @return The target frame rate, 0 if the leds follow every frame
+	///
+	inline int getRemoteImageTargetFps(const QJsonObject& smoothingConfig)
+	{
+		if (!smoothingConfig["enable"].toBool(true))
+		{
+			return 0;
+		}
+
+		return qMax(1, qRound(smoothingConfig["updateFrequency"].toDouble(25.0)));
+	}
 };
@@ -29,6 +29,9 @@ enum type  {
 	NETWORK,
 	FLATBUFSERVER,
 	PROTOSERVER,
+	SCHEDULING,
+	OUTPUT,
+	CAPTUREGOVERNOR,
 	INVALID
 };
 
@@ -62,6 +65,9 @@ inline QString typeToString(const type& type)
 		case NETWORK:       return "network";
 		case FLATBUFSERVER: return "flatbufServer";
 		case PROTOSERVER:   return "protoServer";
+		case SCHEDULING:    return "scheduling";
+		case OUTPUT:        return "output";
+		case CAPTUREGOVERNOR: return "captureGovernor";
 		default:            return "invalid";
 	}
 }
@@ -94,6 +100,9 @@ inline type stringToType(const QString& type)
 	else if (type == "network")              return NETWORK;
 	else if (type == "flatbufServer")        return FLATBUFSERVER;
 	else if (type == "protoServer")          return PROTOSERVER;
+	else if (type == "scheduling")           return SCHEDULING;
+	else if (type == "output")               return OUTPUT;
+	else if (type == "captureGovernor")      return CAPTUREGOVERNOR;
 	else                                     return INVALID;
 }
 };
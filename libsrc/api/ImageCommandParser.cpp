@@ -0,0 +1,203 @@
+#include "ImageCommandParser.h"
+
+// STL includes
+#include <cstring>
+#include <climits>
+
+namespace
+{
+	class Scanner
+	{
+	public:
+		Scanner(const char* data, const size_t size)
+			: _pos(data)
+			, _end(data + size)
+		{
+		}
+
+		void skipWhitespace()
+		{
+			while (_pos < _end && (*_pos == ' ' || *_pos == '\t' || *_pos == '\n' || *_pos == '\r'))
+			{
+				++_pos;
+			}
+		}
+
+		bool atEnd() const
+		{
+			return _pos == _end;
+		}
+
+		bool consume(const char c)
+		{
+			skipWhitespace();
+			if (_pos < _end && *_pos == c)
+			{
+				++_pos;
+				return true;
+			}
+			return false;
+		}
+
+		///
+		/// Read a string without escape sequences, the result points into the message
+		///
+		bool readString(const char*& string, size_t& length)
+		{
+			if (!consume('"'))
+			{
+				return false;
+			}
+
+			const char* close = static_cast<const char*>(memchr(_pos, '"', size_t(_end - _pos)));
+			if (close == nullptr || memchr(_pos, '\\', size_t(close - _pos)) != nullptr)
+			{
+				return false;
+			}
+
+			string = _pos;
+			length = size_t(close - _pos);
+			_pos = close + 1;
+			return true;
+		}
+
+		///
+		/// Read an integer, floats and exponents are rejected
+		///
+		bool readInt(int& value)
+		{
+			skipWhitespace();
+			const bool negative = (_pos < _end && *_pos == '-');
+			if (negative)
+			{
+				++_pos;
+			}
+
+			long long result = 0;
+			const char* start = _pos;
+			while (_pos < _end && *_pos >= '0' && *_pos <= '9')
+			{
+				result = result * 10 + (*_pos - '0');
+				if (result > INT_MAX)
+				{
+					return false;
+				}
+				++_pos;
+			}
+
+			if (_pos == start || (_pos < _end && (*_pos == '.' || *_pos == 'e' || *_pos == 'E')))
+			{
+				return false;
+			}
+
+			value = int(negative ? -result : result);
+			return true;
+		}
+
+	private:
+		const char* _pos;
+		const char* _end;
+	};
+
+	bool equals(const char* string, const size_t length, const char* literal)
+	{
+		return length == strlen(literal) && memcmp(string, literal, length) == 0;
+	}
+
+	enum Field
+	{
+		FIELD_COMMAND  = 1 << 0,
+		FIELD_TAN      = 1 << 1,
+		FIELD_PRIORITY = 1 << 2,
+		FIELD_ORIGIN   = 1 << 3,
+		FIELD_DURATION = 1 << 4,
+		FIELD_WIDTH    = 1 << 5,
+		FIELD_HEIGHT   = 1 << 6,
+		FIELD_DATA     = 1 << 7
+	};
+
+	const int REQUIRED_FIELDS = FIELD_COMMAND | FIELD_PRIORITY | FIELD_ORIGIN | FIELD_WIDTH | FIELD_HEIGHT | FIELD_DATA;
+}
+
+bool ImageCommandParser::parse(const QByteArray& message, ImageCommand& command)
+{
+	Scanner scanner(message.constData(), size_t(message.size()));
+	if (!scanner.consume('{'))
+	{
+		return false;
+	}
+
+	int fields = 0;
+	do
+	{
+		const char* key = nullptr;
+		size_t keyLength = 0;
+		if (!scanner.readString(key, keyLength) || !scanner.consume(':'))
+		{
+			return false;
+		}
+
+		int field = 0;
+		bool ok = false;
+		const char* string = nullptr;
+		size_t length = 0;
+
+		if (equals(key, keyLength, "command"))
+		{
+			field = FIELD_COMMAND;
+			ok = scanner.readString(string, length) && equals(string, length, "image");
+		}
+		else if (equals(key, keyLength, "tan"))
+		{
+			field = FIELD_TAN;
+			ok = scanner.readInt(command.tan);
+		}
+		else if (equals(key, keyLength, "priority"))
+		{
+			field = FIELD_PRIORITY;
+			ok = scanner.readInt(command.priority) && command.priority >= 1 && command.priority <= 253;
+		}
+		else if (equals(key, keyLength, "origin"))
+		{
+			field = FIELD_ORIGIN;
+			ok = scanner.readString(string, length);
+			command.origin = QString::fromUtf8(string, int(length));
+		}
+		else if (equals(key, keyLength, "duration"))
+		{
+			field = FIELD_DURATION;
+			ok = scanner.readInt(command.duration);
+		}
+		else if (equals(key, keyLength, "imagewidth"))
+		{
+			field = FIELD_WIDTH;
+			ok = scanner.readInt(command.width) && command.width >= 0;
+		}
+		else if (equals(key, keyLength, "imageheight"))
+		{
+			field = FIELD_HEIGHT;
+			ok = scanner.readInt(command.height) && command.height >= 0;
+		}
+		else if (equals(key, keyLength, "imagedata"))
+		{
+			field = FIELD_DATA;
+			ok = scanner.readString(command.imageData, command.imageDataLength);
+		}
+
+		// unknown and duplicated fields are left to the generic path
+		if (!ok || (fields & field))
+		{
+			return false;
+		}
+		fields |= field;
+	}
+	while (scanner.consume(','));
+
+	if (!scanner.consume('}'))
+	{
+		return false;
+	}
+
+	scanner.skipWhitespace();
+	return scanner.atEnd() && (fields & REQUIRED_FIELDS) == REQUIRED_FIELDS;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+// STL includes
+#include <cstddef>
+
+// qt includes
+#include <QByteArray>
+#include <QString>
+
+///
+/// @brief The fields of an image command
+///
+struct ImageCommand
+{
+	int tan       = 0;
+	int priority  = 0;
+	int duration  = -1;
+	QString origin;
+	int width     = 0;
+	int height    = 0;
+
+	/// The base64 encoded image, it points into the parsed message
+	const char* imageData = nullptr;
+	size_t imageDataLength = 0;
+};
+
+///
+/// @brief Single pass parser of image commands on the raw (UTF-8) message.
+/// It accepts just what the image schema allows in the form senders usually produce it. Everything else
+/// (escaped strings, floats, unknown or invalid fields, other commands) is rejected, so the caller can
+/// take the generic path which also creates the error replies.
+///
+namespace ImageCommandParser
+{
+	///
+	/// @brief Parse and validate an image command
+	///
+	/// @param message       The raw message
+	/// @param[out] command  The fields of the command
+	///
+	/// @return True if the message is a valid image command
+	///
+	bool parse(const QByteArray& message, ImageCommand& command);
+}
@@ -23,8 +23,11 @@
 #include <utils/ColorSys.h>
 #include <leddevice/LedDeviceWrapper.h>
 #include <hyperion/GrabberWrapper.h>
+#include <hyperion/CaptureGovernor.h>
 #include <utils/Process.h>
 #include <utils/JsonUtils.h>
+#include <utils/Base64.h>
+#include <utils/hyperion.h>
 
 // bonjour wrapper
 #include <bonjour/bonjourbrowserwrapper.h>
@@ -34,6 +37,7 @@
 
 // api includes
 #include <api/JsonCB.h>
+#include "ImageCommandParser.h"
 
 // auth manager
 #include <hyperion/AuthManager.h>
@@ -76,6 +80,11 @@ JsonAPI::JsonAPI(QString peerAddress, Logger* log, const bool& localConnection,
 	connect(this, &JsonAPI::forwardJsonMessage, _hyperion, &Hyperion::forwardJsonMessage);
 }
 
+JsonAPI::~JsonAPI()
+{
+	JsonCB::release(_jsonCB, _subscribedCommands);
+}
+
 bool JsonAPI::handleInstanceSwitch(const quint8& inst, const bool& forced)
 {
 	// check if we are already on the requested instance
@@ -92,19 +101,13 @@ bool JsonAPI::handleInstanceSwitch(const quint8& inst, const bool& forced)
 		// get new Hyperion pointer
 		_hyperion = _instanceManager->getHyperionInstance(inst);
 
-		// the JsonCB creates json messages you can subscribe to e.g. data change events; forward them to the parent client
-		QStringList cbCmds;
-		if(_jsonCB != nullptr)
-		{
-			cbCmds = _jsonCB->getSubscribedCommands();
-			delete _jsonCB;
-		}
-
-		_jsonCB = new JsonCB(_hyperion, this);
-		connect(_jsonCB, &JsonCB::newCallback, this, &JsonAPI::callbackMessage);
+		// the JsonCB hub creates json messages you can subscribe to e.g. data change events; forward them to the parent client
+		JsonCB::release(_jsonCB, _subscribedCommands);
+		_jsonCB = JsonCB::acquire(_hyperion);
+		connect(_jsonCB, &JsonCB::newCallback, this, &JsonAPI::handleSubscriptionCallback);
 
 		// read subs
-		for(const auto & entry : cbCmds)
+		for(const auto & entry : _subscribedCommands)
 		{
 			_jsonCB->subscribeFor(entry);
 		}
@@ -122,6 +125,30 @@ bool JsonAPI::handleInstanceSwitch(const quint8& inst, const bool& forced)
 	return false;
 }
 
+void JsonAPI::handleMessage(const QByteArray& message, const QString& httpAuthHeader)
+{
+	// image commands are decoded straight from the raw message into the image buffer, without a QJsonDocument and
+	// the UTF-16 copy of the image data. Messages which need the generic path (other commands, authorization,
+	// forwarding, anything the parser doesn't accept) are handled as before
+	if ((!_apiAuthRequired || _authorized) && _hyperion->getComponentRegister().isComponentEnabled(hyperion::COMP_FORWARDER) <= 0)
+	{
+		ImageCommand image;
+		if (ImageCommandParser::parse(message, image) && Base64::decodedSize(image.imageData, image.imageDataLength) == size_t(image.width) * image.height * 3)
+		{
+			// the buffer is PACKED, so the decoded bytes are the rows of the image
+			_imageBuffer.resize(image.width, image.height);
+			assert(_imageBuffer.isContiguous());
+			if (Base64::decode(image.imageData, image.imageDataLength, reinterpret_cast<uint8_t*>(_imageBuffer.memptr())))
+			{
+				setImageInput(image.priority, image.duration, "image", image.tan);
+				return;
+			}
+		}
+	}
+
+	handleMessage(QString::fromUtf8(message), httpAuthHeader);
+}
+
 void JsonAPI::handleMessage(const QString& messageString, const QString& httpAuthHeader)
 {
 	const QString ident = "JsonRpc@"+_peerAddress;
@@ -240,12 +267,16 @@ void JsonAPI::handleImageCommand(const QJsonObject& message, const QString& comm
 		return;
 	}
 
-	// create ImageRgb
-	Image<ColorRgb> image(width, height);
-	memcpy(image.memptr(), data.data(), data.size());
+	_imageBuffer.resize(width, height);
+	_imageBuffer.copyFrom(data.data());
 
+	setImageInput(priority, duration, command, tan);
+}
+
+void JsonAPI::setImageInput(const int priority, const int duration, const QString& command, const int tan)
+{
 	_hyperion->registerInput(priority, hyperion::COMP_IMAGE, "JsonRpc@"+_peerAddress);
-	_hyperion->setInputImage(priority, image, duration);
+	_hyperion->setInputImage(priority, _imageBuffer, duration);
 
 	// send reply
 	sendSuccessReply(command, tan);
@@ -496,6 +527,7 @@ void JsonAPI::handleServerInfoCommand(const QJsonObject& message, const QString&
 	}
 #endif
 	grabbers["available"] = availableGrabbers;
+	grabbers["governor"] = CaptureGovernor::getStates();
 	info["videomode"] = QString(videoMode2String(_hyperion->getCurrentVideoMode()));
 	info["grabbers"]      = grabbers;
 
@@ -546,6 +578,14 @@ void JsonAPI::handleServerInfoCommand(const QJsonObject& message, const QString&
 	// add leds configs
 	info["leds"] = _hyperion->getSetting(settings::LEDS).array();
 
+	// the image size and frame rate remote senders should provide, larger images don't improve the led colors
+	QJsonObject imageTarget;
+	const QSize targetSize = hyperion::getRemoteImageTargetSize(_hyperion->getSetting(settings::LEDS).array());
+	imageTarget["width"]  = targetSize.isValid() ? targetSize.width() : -1;
+	imageTarget["height"] = targetSize.isValid() ? targetSize.height() : -1;
+	imageTarget["fps"]    = hyperion::getRemoteImageTargetFps(_hyperion->getSetting(settings::SMOOTHING).object());
+	info["imageTarget"] = imageTarget;
+
 	// BEGIN | The following entries are derecated but used to ensure backward compatibility with hyperion Classic remote control
 	// TODO Output the real transformation information instead of default
 
@@ -657,7 +697,7 @@ void JsonAPI::handleServerInfoCommand(const QJsonObject& message, const QString&
 		if(subsArr.contains("all"))
 		{
 			subsArr = QJsonArray();
-			for(const auto & entry : _jsonCB->getCommands())
+			for(const auto & entry : JsonCB::getCommands())
 			{
 				subsArr.append(entry);
 			}
@@ -668,8 +708,14 @@ void JsonAPI::handleServerInfoCommand(const QJsonObject& message, const QString&
 			if(entry == "settings-update" && !_authorized)
 				continue;
 
+			// the hub counts the subscribers, so each command is subscribed once
+			if(_subscribedCommands.contains(entry.toString()))
+				continue;
+
 			if(!_jsonCB->subscribeFor(entry.toString()))
-				sendErrorReply(QString("Subscription for '%1' not found. Possible values: %2").arg(entry.toString(), _jsonCB->getCommands().join(", ")), command, tan);
+				sendErrorReply(QString("Subscription for '%1' not found. Possible values: %2").arg(entry.toString(), JsonCB::getCommands().join(", ")), command, tan);
+			else
+				_subscribedCommands << entry.toString();
 		}
 	}
 }
@@ -1391,7 +1437,7 @@ void JsonAPI::setImage(const Image<ColorRgb> & image)
 	{
 		_image_stream_timeout = QDateTime::currentMSecsSinceEpoch();
 
-		QImage jpgImage((const uint8_t *) image.memptr(), image.width(), image.height(), 3*image.width(), QImage::Format_RGB888);
+		QImage jpgImage((const uint8_t *) image.memptr(), image.width(), image.height(), image.stride(), QImage::Format_RGB888);
 		QByteArray ba;
 		QBuffer buffer(&ba);
 		buffer.open(QIODevice::WriteOnly);
@@ -1412,16 +1458,16 @@ void JsonAPI::incommingLogMessage(const Logger::T_LOG_MESSAGE &msg)
 	if (!_streaming_logging_activated)
 	{
 		_streaming_logging_activated = true;
-		QVector<Logger::T_LOG_MESSAGE>* logBuffer = LoggerManager::getInstance()->getLogMessageBuffer();
-		for(int i=0; i<logBuffer->length(); i++)
+		const QVector<Logger::T_LOG_MESSAGE> logBuffer = LoggerManager::getInstance()->getLogMessageBuffer();
+		for(const auto& logMsg : logBuffer)
 		{
-			message["appName"] = logBuffer->at(i).appName;
-			message["loggerName"] = logBuffer->at(i).loggerName;
-			message["function"] = logBuffer->at(i).function;
-			message["line"] = QString::number(logBuffer->at(i).line);
-			message["fileName"] = logBuffer->at(i).fileName;
-			message["message"] = logBuffer->at(i).message;
-			message["levelString"] = logBuffer->at(i).levelString;
+			message["appName"] = logMsg.appName;
+			message["loggerName"] = logMsg.loggerName;
+			message["function"] = logMsg.function;
+			message["line"] = QString::number(logMsg.line);
+			message["fileName"] = logMsg.fileName;
+			message["message"] = logMsg.message;
+			message["levelString"] = logMsg.levelString;
 
 			messageArray.append(message);
 		}
@@ -1491,3 +1537,9 @@ void JsonAPI::handleInstanceStateChange(const instanceState& state, const quint8
 			break;
 	}
 }
+
+void JsonAPI::handleSubscriptionCallback(const QString& command, const QByteArray& data)
+{
+	if(_subscribedCommands.contains(command))
+		emit callbackData(data);
+}
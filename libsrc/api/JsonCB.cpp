@@ -21,91 +21,149 @@
 
 // qt
 #include <QDateTime>
+#include <QJsonDocument>
+#include <QMap>
+#include <QMutex>
+#include <QPair>
+#include <QThread>
 
 // Image to led map helper
 #include <hyperion/ImageProcessor.h>
 
 using namespace hyperion;
 
-JsonCB::JsonCB(Hyperion* hyperion, QObject* parent)
-	: QObject(parent)
+namespace
+{
+	/// The hubs per instance and thread, the clients of a hub live in the same thread as the hub
+	typedef QPair<Hyperion*, QThread*> HubKey;
+	QMap<HubKey, JsonCB*> hubs;
+	QMutex hubsMutex;
+}
+
+JsonCB* JsonCB::acquire(Hyperion* hyperion)
+{
+	QMutexLocker lock(&hubsMutex);
+
+	const HubKey key(hyperion, QThread::currentThread());
+	JsonCB* hub = hubs.value(key, nullptr);
+	if(hub == nullptr)
+	{
+		hub = new JsonCB(hyperion);
+		hubs.insert(key, hub);
+	}
+	hub->_clients++;
+	return hub;
+}
+
+void JsonCB::release(JsonCB* hub, const QStringList& subscriptions)
+{
+	if(hub == nullptr)
+		return;
+
+	for(const auto & cmd : subscriptions)
+		hub->unsubscribeFor(cmd);
+
+	QMutexLocker lock(&hubsMutex);
+
+	if(--hub->_clients == 0)
+	{
+		hubs.remove(HubKey(hub->_hyperion, hub->thread()));
+		delete hub;
+	}
+}
+
+QStringList JsonCB::getCommands()
+{
+	return QStringList() << "components-update" << "sessions-update" << "priorities-update" << "imageToLedMapping-update"
+	<< "adjustment-update" << "videomode-update" << "effects-update" << "settings-update" << "leds-update" << "instance-update";
+}
+
+JsonCB::JsonCB(Hyperion* hyperion)
+	: QObject()
 	, _hyperion(hyperion)
 	, _componentRegister(& _hyperion->getComponentRegister())
 	, _bonjour(BonjourBrowserWrapper::getInstance())
 	, _prioMuxer(_hyperion->getMuxerInstance())
+	, _clients(0)
 {
-	_availableCommands << "components-update" << "sessions-update" << "priorities-update" << "imageToLedMapping-update"
-	<< "adjustment-update" << "videomode-update" << "effects-update" << "settings-update" << "leds-update" << "instance-update";
 }
 
 bool JsonCB::subscribeFor(const QString& type)
 {
-	if(!_availableCommands.contains(type))
+	if(!getCommands().contains(type))
 		return false;
 
+	if(_subscribers[type]++ == 0)
+		connectUpdates(type, true);
+
+	return true;
+}
+
+void JsonCB::unsubscribeFor(const QString& type)
+{
+	auto it = _subscribers.find(type);
+	if(it == _subscribers.end())
+		return;
+
+	if(--it.value() == 0)
+	{
+		_subscribers.erase(it);
+		connectUpdates(type, false);
+	}
+}
+
+void JsonCB::connectUpdates(const QString& type, const bool& enable)
+{
 	if(type == "components-update")
 	{
-		_subscribedCommands << type;
-		connect(_componentRegister, &ComponentRegister::updatedComponentState, this, &JsonCB::handleComponentState, Qt::UniqueConnection);
+		connectUpdate(_componentRegister, &ComponentRegister::updatedComponentState, &JsonCB::handleComponentState, enable);
 	}
 
 	if(type == "sessions-update")
 	{
-		_subscribedCommands << type;
-		connect(_bonjour, &BonjourBrowserWrapper::browserChange, this, &JsonCB::handleBonjourChange, Qt::UniqueConnection);
+		connectUpdate(_bonjour, &BonjourBrowserWrapper::browserChange, &JsonCB::handleBonjourChange, enable);
 	}
 
 	if(type == "priorities-update")
 	{
-		_subscribedCommands << type;
-		connect(_prioMuxer, &PriorityMuxer::prioritiesChanged, this, &JsonCB::handlePriorityUpdate, Qt::UniqueConnection);
-		connect(_prioMuxer, &PriorityMuxer::autoSelectChanged, this, &JsonCB::handlePriorityUpdate, Qt::UniqueConnection);
+		connectUpdate(_prioMuxer, &PriorityMuxer::prioritiesChanged, &JsonCB::handlePriorityUpdate, enable);
+		connectUpdate(_prioMuxer, &PriorityMuxer::autoSelectChanged, &JsonCB::handlePriorityUpdate, enable);
 	}
 
 	if(type == "imageToLedMapping-update")
 	{
-		_subscribedCommands << type;
-		connect(_hyperion, &Hyperion::imageToLedsMappingChanged, this, &JsonCB::handleImageToLedsMappingChange, Qt::UniqueConnection);
+		connectUpdate(_hyperion, &Hyperion::imageToLedsMappingChanged, &JsonCB::handleImageToLedsMappingChange, enable);
 	}
 
 	if(type == "adjustment-update")
 	{
-		_subscribedCommands << type;
-		connect(_hyperion, &Hyperion::adjustmentChanged, this, &JsonCB::handleAdjustmentChange, Qt::UniqueConnection);
+		connectUpdate(_hyperion, &Hyperion::adjustmentChanged, &JsonCB::handleAdjustmentChange, enable);
 	}
 
 	if(type == "videomode-update")
 	{
-		_subscribedCommands << type;
-		connect(_hyperion, &Hyperion::newVideoMode, this, &JsonCB::handleVideoModeChange, Qt::UniqueConnection);
+		connectUpdate(_hyperion, &Hyperion::newVideoMode, &JsonCB::handleVideoModeChange, enable);
 	}
 
 	if(type == "effects-update")
 	{
-		_subscribedCommands << type;
-		connect(_hyperion, &Hyperion::effectListUpdated, this, &JsonCB::handleEffectListChange, Qt::UniqueConnection);
+		connectUpdate(_hyperion, &Hyperion::effectListUpdated, &JsonCB::handleEffectListChange, enable);
 	}
 
 	if(type == "settings-update")
 	{
-		_subscribedCommands << type;
-		connect(_hyperion, &Hyperion::settingsChanged, this, &JsonCB::handleSettingsChange, Qt::UniqueConnection);
+		connectUpdate(_hyperion, &Hyperion::settingsChanged, &JsonCB::handleSettingsChange, enable);
 	}
 
 	if(type == "leds-update")
 	{
-		_subscribedCommands << type;
-		connect(_hyperion, &Hyperion::settingsChanged, this, &JsonCB::handleLedsConfigChange, Qt::UniqueConnection);
+		connectUpdate(_hyperion, &Hyperion::settingsChanged, &JsonCB::handleLedsConfigChange, enable);
 	}
 
-
 	if(type == "instance-update")
 	{
-		_subscribedCommands << type;
-		connect(HyperionIManager::getInstance(), &HyperionIManager::change, this, &JsonCB::handleInstanceChange, Qt::UniqueConnection);
+		connectUpdate(HyperionIManager::getInstance(), &HyperionIManager::change, &JsonCB::handleInstanceChange, enable);
 	}
-
-	return true;
 }
 
 void JsonCB::doCallback(const QString& cmd, const QVariant& data)
@@ -118,7 +176,8 @@ void JsonCB::doCallback(const QString& cmd, const QVariant& data)
 	else
 		obj["data"] = data.toJsonObject();
 
-	emit newCallback(obj);
+	// serialized once for all clients
+	emit newCallback(cmd, QJsonDocument(obj).toJson(QJsonDocument::Compact) + "\n");
 }
 
 void JsonCB::handleComponentState(const hyperion::Components comp, const bool state)
@@ -5,12 +5,14 @@
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QThreadStorage>
+#include <QHash>
 #include <QUuid>
 #include <QDir>
 
 // not in header because of linking
 static QString _rootPath;
 static QThreadStorage<QSqlDatabase> _databasePool;
+static QThreadStorage<QHash<QString, QSqlQuery>> _queryPool;
 
 DBManager::DBManager(QObject* parent)
 	: QObject(parent)
@@ -48,6 +50,10 @@ QSqlDatabase DBManager::getDB() const
 			Error(_log, QSTRING_CSTR(db.lastError().text()));
 			throw std::runtime_error("Failed to open database connection!");
 		}
+		// write ahead log: readers don't block the writer and commits don't require a full sync
+		QSqlQuery pragma(db);
+		if(!pragma.exec("PRAGMA journal_mode=WAL") || !pragma.exec("PRAGMA synchronous=NORMAL"))
+			Warning(_log, "Failed to enable WAL mode: %s", QSTRING_CSTR(db.lastError().text()));
 		return db;
 	}
 }
@@ -67,8 +73,7 @@ bool DBManager::createRecord(const VectorPair& conditions, const QVariantMap& co
 	}
 
 	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
+	QSqlQuery query;
 
 	QVariantList cValues;
 	QStringList prep;
@@ -90,7 +95,8 @@ bool DBManager::createRecord(const VectorPair& conditions, const QVariantMap& co
 		cValues << pair.second;
 		placeh.append("?");
 	}
-	query.prepare(QString("INSERT INTO %1 ( %2 ) VALUES ( %3 )").arg(_table,prep.join(", ")).arg(placeh.join(", ")));
+	if(!getPreparedQuery(QString("INSERT INTO %1 ( %2 ) VALUES ( %3 )").arg(_table,prep.join(", ")).arg(placeh.join(", ")), query))
+		return false;
 	// add column & condition values
 	doAddBindValue(query, cValues);
 	if(!query.exec())
@@ -107,8 +113,7 @@ bool DBManager::recordExists(const VectorPair& conditions) const
 		return false;
 
 	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
+	QSqlQuery query;
 
 	QStringList prepCond;
 	QVariantList bindVal;
@@ -119,7 +124,8 @@ bool DBManager::recordExists(const VectorPair& conditions) const
 		prepCond << pair.first+"=?";
 		bindVal << pair.second;
 	}
-	query.prepare(QString("SELECT * FROM %1 %2").arg(_table,prepCond.join(" ")));
+	if(!getPreparedQuery(QString("SELECT * FROM %1 %2").arg(_table,prepCond.join(" ")), query))
+		return false;
 	doAddBindValue(query, bindVal);
 	if(!query.exec())
 	{
@@ -127,22 +133,17 @@ bool DBManager::recordExists(const VectorPair& conditions) const
 		return false;
 	}
 
-	int entry = 0;
-	while (query.next()) {
-        entry++;
-    }
-
-	if(entry)
-		return true;
+	// a single row is enough, release the statement afterwards as it's reused
+	const bool found = query.next();
+	query.finish();
 
-	return false;
+	return found;
 }
 
 bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& columns) const
 {
 	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
+	QSqlQuery query;
 
 	QVariantList values;
 	QStringList prep;
@@ -168,7 +169,8 @@ bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& co
 		prepBindVal << pair.second;
 	}
 
-	query.prepare(QString("UPDATE %1 SET %2 %3").arg(_table,prep.join(", ")).arg(prepCond.join(" ")));
+	if(!getPreparedQuery(QString("UPDATE %1 SET %2 %3").arg(_table,prep.join(", ")).arg(prepCond.join(" ")), query))
+		return false;
 	// add column values
 	doAddBindValue(query, values);
 	// add condition values
@@ -184,8 +186,7 @@ bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& co
 bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, const QStringList& tColumns) const
 {
 	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
+	QSqlQuery query;
 
 	QString sColumns("*");
 	if(!tColumns.isEmpty())
@@ -202,7 +203,8 @@ bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, co
 		prepCond << pair.first+"=?";
 		bindVal << pair.second;
 	}
-	query.prepare(QString("SELECT %1 FROM %2 %3").arg(sColumns,_table).arg(prepCond.join(" ")));
+	if(!getPreparedQuery(QString("SELECT %1 FROM %2 %3").arg(sColumns,_table).arg(prepCond.join(" ")), query))
+		return false;
 	doAddBindValue(query, bindVal);
 
 	if(!query.exec())
@@ -219,6 +221,7 @@ bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, co
 	{
 		results[rec.fieldName(i)] = rec.value(i);
 	}
+	query.finish();
 
 	return true;
 }
@@ -268,7 +271,7 @@ bool DBManager::deleteRecord(const VectorPair& conditions) const
 	if(recordExists(conditions))
 	{
 		QSqlDatabase idb = getDB();
-		QSqlQuery query(idb);
+		QSqlQuery query;
 
 		// prep conditions
 		QStringList prepCond("WHERE");
@@ -280,7 +283,8 @@ bool DBManager::deleteRecord(const VectorPair& conditions) const
 			bindValues << pair.second;
 		}
 
-		query.prepare(QString("DELETE FROM %1 %2").arg(_table,prepCond.join(" ")));
+		if(!getPreparedQuery(QString("DELETE FROM %1 %2").arg(_table,prepCond.join(" ")), query))
+			return false;
 		doAddBindValue(query, bindValues);
 		if(!query.exec())
 		{
@@ -370,6 +374,63 @@ bool DBManager::deleteTable(const QString& table) const
 	return true;
 }
 
+bool DBManager::startTransaction() const
+{
+	QSqlDatabase idb = getDB();
+	if(!idb.transaction())
+	{
+		Error(_log, "Failed to start transaction: %s", QSTRING_CSTR(idb.lastError().text()));
+		return false;
+	}
+	return true;
+}
+
+bool DBManager::commitTransaction() const
+{
+	QSqlDatabase idb = getDB();
+	if(!idb.commit())
+	{
+		Error(_log, "Failed to commit transaction: %s", QSTRING_CSTR(idb.lastError().text()));
+		return false;
+	}
+	return true;
+}
+
+bool DBManager::rollbackTransaction() const
+{
+	QSqlDatabase idb = getDB();
+	if(!idb.rollback())
+	{
+		Error(_log, "Failed to rollback transaction: %s", QSTRING_CSTR(idb.lastError().text()));
+		return false;
+	}
+	return true;
+}
+
+bool DBManager::getPreparedQuery(const QString& statement, QSqlQuery& query) const
+{
+	QSqlDatabase idb = getDB();
+	QHash<QString, QSqlQuery>& pool = _queryPool.localData();
+
+	auto it = pool.find(statement);
+	if(it != pool.end())
+	{
+		query = it.value();
+		return true;
+	}
+
+	QSqlQuery newQuery(idb);
+	newQuery.setForwardOnly(true);
+	if(!newQuery.prepare(statement))
+	{
+		Error(_log, "Failed to prepare statement: '%s' Error: %s", QSTRING_CSTR(statement), QSTRING_CSTR(newQuery.lastError().text()));
+		return false;
+	}
+	pool.insert(statement, newQuery);
+	query = newQuery;
+	return true;
+}
+
 void DBManager::doAddBindValue(QSqlQuery& query, const QVariantList& variants) const
 {
 	for(const auto& variant : variants)
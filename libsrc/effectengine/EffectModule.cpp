@@ -215,7 +215,7 @@ PyObject* EffectModule::wrapSetImage(PyObject *self, PyObject *args)
 			{
 				Image<ColorRgb> image(width, height);
 				char * data = PyByteArray_AS_STRING(bytearray);
-				memcpy(image.memptr(), data, length);
+				image.copyFrom(data);
 				getEffect()->setInputImage(getEffect()->_priority, image, timeout, false);
 				Py_RETURN_NONE;
 			}
@@ -372,7 +372,7 @@ PyObject* EffectModule::wrapImageShow(PyObject *self, PyObject *args)
 		}
 	}
 
-	memcpy(image.memptr(), binaryImage.data(), binaryImage.size());
+	image.copyFrom(binaryImage.data());
 	getEffect()->setInputImage(getEffect()->_priority, image, timeout, false);
 
 	return Py_BuildValue("");
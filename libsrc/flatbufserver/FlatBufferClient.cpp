@@ -14,6 +14,8 @@ FlatBufferClient::FlatBufferClient(QTcpSocket* socket, const int &timeout, QObje
 	, _timeoutTimer(new QTimer(this))
 	, _timeout(timeout * 1000)
 	, _priority()
+	, _targetSize()
+	, _targetFps(0)
 {
 	// timer setup
 	_timeoutTimer->setSingleShot(true);
@@ -131,7 +133,28 @@ void FlatBufferClient::handleRegisterCommand(const hyperionnet::Register *regReq
 	_priority = regReq->priority();
 	emit registerGlobalInput(_priority, hyperion::COMP_FLATBUFSERVER, regReq->origin()->c_str()+_clientAddress);
 
-	auto reply = hyperionnet::CreateReplyDirect(_builder, nullptr, -1, (_priority ? _priority : -1));
+	sendRegisteredReply();
+}
+
+void FlatBufferClient::setImageTarget(const QSize& size, const int fps)
+{
+	_targetSize = size;
+	_targetFps = fps;
+
+	// a registered client gets the new target with a repeated registration reply
+	if (_priority >= 100 && _priority < 200)
+	{
+		sendRegisteredReply();
+	}
+}
+
+void FlatBufferClient::sendRegisteredReply()
+{
+	// older clients ignore the target fields
+	auto reply = hyperionnet::CreateReplyDirect(_builder, nullptr, -1, (_priority ? _priority : -1),
+		_targetSize.isValid() ? _targetSize.width() : -1,
+		_targetSize.isValid() ? _targetSize.height() : -1,
+		_targetFps);
 	_builder.Finish(reply);
 
 	// send reply
@@ -158,7 +181,7 @@ void FlatBufferClient::handleImageCommand(const hyperionnet::Image *image)
 		}
 
 		Image<ColorRgb> imageDest(width, height);
-		memmove(imageDest.memptr(), imageData->data(), imageData->size());
+		imageDest.copyFrom(imageData->data());
 		emit setGlobalInputImage(_priority, imageDest, duration);
 	}
 
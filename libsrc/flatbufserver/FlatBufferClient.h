@@ -6,6 +6,9 @@
 #include <utils/ColorRgb.h>
 #include <utils/Components.h>
 
+// qt
+#include <QSize>
+
 // flatbuffer FBS
 #include "hyperion_reply_generated.h"
 #include "hyperion_request_generated.h"
@@ -69,6 +72,13 @@ public slots:
 	///
 	void registationRequired(const int priority);
 
+	///
+	/// @brief Set the image size and frame rate the client is asked for, a registered client is informed right away
+	/// @param size  The target size, invalid if there is none
+	/// @param fps   The target frame rate, 0 if there is no limit
+	///
+	void setImageTarget(const QSize& size, const int fps);
+
 	///
 	/// @brief close the socket and call disconnected()
 	///
@@ -125,6 +135,11 @@ private:
 	///
 	void sendMessage();
 
+	///
+	/// Send the reply to a registration, including the image target
+	///
+	void sendRegisteredReply();
+
 	///
 	/// Send a standard reply indicating success
 	///
@@ -145,6 +160,10 @@ private:
 	int _timeout;
 	int _priority;
 
+	/// the image size and frame rate the client is asked for
+	QSize _targetSize;
+	int _targetFps;
+
 	QByteArray _receiveBuffer;
 
 	// Flatbuffers builder
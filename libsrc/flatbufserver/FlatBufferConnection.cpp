@@ -14,7 +14,14 @@ FlatBufferConnection::FlatBufferConnection(const QString& origin, const QString
 	, _prevSocketState(QAbstractSocket::UnconnectedState)
 	, _log(Logger::getInstance("FLATBUFCONNECTION"))
 	, _registered(false)
+	, _targetSize()
+	, _targetFps(0)
+	, _nextFrameTime(0)
 {
+	// averaging keeps the colors of fine details, which the center pixel of a block might miss
+	_resampler.setDecimationMode(ImageResampler::DECIMATION_AVERAGE);
+	_frameClock.start();
+
 	QStringList parts = address.split(":");
 	if (parts.size() != 2)
 	{
@@ -121,6 +128,47 @@ void FlatBufferConnection::setColor(const ColorRgb & color, int priority, int du
 
 void FlatBufferConnection::setImage(const Image<ColorRgb> &image)
 {
+	// skip frames above the target rate, the server wouldn't show them. A frame may come a quarter interval early,
+	// so a grabber running at the target rate isn't thinned out by jitter
+	if (_targetFps > 0)
+	{
+		const qint64 now = _frameClock.elapsed();
+		const qint64 interval = 1000 / _targetFps;
+		if (now + interval / 4 < _nextFrameTime)
+		{
+			return;
+		}
+		_nextFrameTime = qMax(_nextFrameTime, now - interval) + interval;
+	}
+
+	// downscale by the largest factor which keeps the target size, the aspect ratio is kept
+	if (_targetSize.isValid())
+	{
+		const int decimation = qMin(int(image.width()) / qMax(1, _targetSize.width()), int(image.height()) / qMax(1, _targetSize.height()));
+		if (decimation > 1)
+		{
+			_resampler.setHorizontalPixelDecimation(decimation);
+			_resampler.setVerticalPixelDecimation(decimation);
+			_resampler.processImage(reinterpret_cast<const uint8_t*>(image.memptr()), image.width(), image.height(), int(image.stride()), PIXELFORMAT_RGB24, _scaledImage);
+			sendImage(_scaledImage);
+			return;
+		}
+	}
+
+	sendImage(image);
+}
+
+void FlatBufferConnection::sendImage(const Image<ColorRgb> &image)
+{
+	// the message carries packed rows
+	if (!image.isContiguous())
+	{
+		Image<ColorRgb> packed(image.width(), image.height());
+		packed.copy(image);
+		sendImage(packed);
+		return;
+	}
+
 	auto imgData = _builder.CreateVector(reinterpret_cast<const uint8_t*>(image.memptr()), image.size());
 	auto rawImg = hyperionnet::CreateRawImage(_builder, imgData, image.width(), image.height());
 	auto imageReq = hyperionnet::CreateImage(_builder, hyperionnet::ImageType_RawImage, rawImg.Union(), -1);
@@ -213,8 +261,23 @@ bool FlatBufferConnection::parseReply(const hyperionnet::Reply *reply)
 		if (registered == -1 || registered != _priority)
 			_registered = false;
 		else
+		{
 			_registered = true;
 
+			// older servers don't send a target, the images are sent as they are
+			const QSize targetSize(reply->target_width(), reply->target_height());
+			const int targetFps = qMax(0, reply->target_fps());
+			if (targetSize != _targetSize || targetFps != _targetFps)
+			{
+				_targetSize = targetSize;
+				_targetFps = targetFps;
+				if (_targetSize.isValid())
+				{
+					Info(_log, "Hyperion asks for images of %dx%d at %d fps", _targetSize.width(), _targetSize.height(), _targetFps);
+				}
+			}
+		}
+
 		return true;
 	}
 	else
@@ -16,6 +16,8 @@ FlatBufferServer::FlatBufferServer(const QJsonDocument& config, QObject* parent)
 	, _log(Logger::getInstance("FLATBUFSERVER"))
 	, _timeout(5000)
 	, _config(config)
+	, _targetSize()
+	, _targetFps(0)
 {
 
 }
@@ -57,6 +59,23 @@ void FlatBufferServer::handleSettingsUpdate(const settings::type& type, const QJ
 	}
 }
 
+void FlatBufferServer::setImageTarget(const QSize& size, const int fps)
+{
+	if (size == _targetSize && fps == _targetFps)
+	{
+		return;
+	}
+
+	_targetSize = size;
+	_targetFps = fps;
+	Debug(_log, "Clients are asked for images of %dx%d at %d fps", _targetSize.width(), _targetSize.height(), _targetFps);
+
+	for (const auto& client : _openConnections)
+	{
+		client->setImageTarget(_targetSize, _targetFps);
+	}
+}
+
 void FlatBufferServer::newConnection()
 {
 	while(_server->hasPendingConnections())
@@ -67,6 +86,7 @@ void FlatBufferServer::newConnection()
 			{
 				Debug(_log, "New connection from %s", QSTRING_CSTR(socket->peerAddress().toString()));
 				FlatBufferClient *client = new FlatBufferClient(socket, _timeout, this);
+				client->setImageTarget(_targetSize, _targetFps);
 				// internal
 				connect(client, &FlatBufferClient::clientDisconnected, this, &FlatBufferServer::clientDisconnected);
 				connect(client, &FlatBufferClient::registerGlobalInput, GlobalSignals::getInstance(), &GlobalSignals::registerGlobalInput);
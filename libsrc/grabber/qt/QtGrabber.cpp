@@ -106,7 +106,7 @@ int QtGrabber::grabFrame(Image<ColorRgb> & image)
 	QPixmap originalPixmap = _screen->grabWindow(0, _src_x, _src_y, _src_x_max, _src_y_max);
 	QPixmap resizedPixmap = originalPixmap.scaled(_width,_height);
 	QImage img = resizedPixmap.toImage().convertToFormat( QImage::Format_RGB888);
-	memcpy(image.memptr(), img.bits(),(size_t) _width*_height*3);
+	image.copyFrom(img.constBits(), size_t(img.bytesPerLine()));
 
 	return 0;
 }
@@ -181,7 +181,11 @@ void QtGrabber::setVideoMode(VideoMode mode)
 
 void QtGrabber::setPixelDecimation(int pixelDecimation)
 {
-	_pixelDecimation = pixelDecimation;
+	if(_pixelDecimation != pixelDecimation)
+	{
+		_pixelDecimation = pixelDecimation;
+		updateScreenDimensions(true);
+	}
 }
 
 void QtGrabber::setCropping(unsigned cropLeft, unsigned cropRight, unsigned cropTop, unsigned cropBottom)
@@ -18,6 +18,7 @@
 
 #include <hyperion/Hyperion.h>
 #include <hyperion/HyperionIManager.h>
+#include <utils/CaptureChannels.h>
 
 #include <QDirIterator>
 #include <QFileInfo>
@@ -26,6 +27,82 @@
 
 #define CLEAR(x) memset(&(x), 0, sizeof(x))
 
+// pixels per led column/row the negotiated capture mode has to provide
+static const int MIN_CAPTURE_PIXELS_PER_LED = 8;
+// pixels per led column/row which remain after the pixel decimation of a negotiated mode
+static const int MIN_DECIMATED_PIXELS_PER_LED = 2;
+
+///
+/// @brief The relative cost per pixel to transfer and convert a frame of the given format (bytes per pixel times two),
+///        0 if the format isn't supported. Compressed frames have to be decoded completely before they can be decimated.
+///        Grey is the cheapest format, but the negotiation only selects it when it's configured
+///
+static int formatCost(uint32_t v4l2Format)
+{
+	switch (v4l2Format)
+	{
+		case V4L2_PIX_FMT_GREY:
+			return 2;
+		case V4L2_PIX_FMT_NV12:
+		case V4L2_PIX_FMT_NV21:
+		case V4L2_PIX_FMT_YUV420:
+		case V4L2_PIX_FMT_YVU420:
+			return 3;
+		case V4L2_PIX_FMT_YUYV:
+		case V4L2_PIX_FMT_UYVY:
+		case V4L2_PIX_FMT_RGB565:
+			return 4;
+		case V4L2_PIX_FMT_RGB24:
+		case V4L2_PIX_FMT_BGR24:
+			return 6;
+		case V4L2_PIX_FMT_RGB32:
+			return 8;
+#ifdef HAVE_JPEG
+		case V4L2_PIX_FMT_MJPEG:
+			return 16;
+#endif
+		default:
+			return 0;
+	}
+}
+
+///
+/// @brief Convert a configured pixel format to the v4l2 format, 0 if there is none
+///
+static uint32_t toV4L2Format(PixelFormat pixelFormat)
+{
+	switch (pixelFormat)
+	{
+		case PIXELFORMAT_YUYV:  return V4L2_PIX_FMT_YUYV;
+		case PIXELFORMAT_UYVY:  return V4L2_PIX_FMT_UYVY;
+		case PIXELFORMAT_BGR16: return V4L2_PIX_FMT_RGB565;
+		case PIXELFORMAT_BGR24: return V4L2_PIX_FMT_BGR24;
+		case PIXELFORMAT_RGB24: return V4L2_PIX_FMT_RGB24;
+		case PIXELFORMAT_RGB32: return V4L2_PIX_FMT_RGB32;
+		case PIXELFORMAT_NV12:  return V4L2_PIX_FMT_NV12;
+		case PIXELFORMAT_NV21:  return V4L2_PIX_FMT_NV21;
+		case PIXELFORMAT_I420:  return V4L2_PIX_FMT_YUV420;
+		case PIXELFORMAT_YV12:  return V4L2_PIX_FMT_YVU420;
+		case PIXELFORMAT_GREY:  return V4L2_PIX_FMT_GREY;
+#ifdef HAVE_JPEG
+		case PIXELFORMAT_MJPEG: return V4L2_PIX_FMT_MJPEG;
+#endif
+		default:                return 0;
+	}
+}
+
+///
+/// @brief Get the smallest size of a stepwise range which covers the needed size
+///
+static unsigned fitToRange(unsigned needed, unsigned min, unsigned max, unsigned step)
+{
+	if (needed <= min)
+		return min;
+
+	step = qMax(1u, step);
+	return qMin(max, min + (needed - min + step - 1) / step * step);
+}
+
 V4L2Grabber::V4L2Grabber(const QString & device
 		, VideoStandard videoStandard
 		, PixelFormat pixelFormat
@@ -39,7 +116,9 @@ V4L2Grabber::V4L2Grabber(const QString & device
 	, _fileDescriptor(-1)
 	, _buffers()
 	, _pixelFormat(pixelFormat)
+	, _configuredPixelFormat(pixelFormat)
 	, _pixelDecimation(-1)
+	, _appliedPixelDecimation(-1)
 	, _lineLength(-1)
 	, _frameByteSize(-1)
 	, _noSignalCounterThreshold(40)
@@ -51,9 +130,16 @@ V4L2Grabber::V4L2Grabber(const QString & device
 	, _y_frac_min(0.25)
 	, _x_frac_max(0.75)
 	, _y_frac_max(0.75)
+	, _signalDetectionStep(1)
+	, _signalProbe()
 	, _streamNotifier(nullptr)
 	, _initialized(false)
 	, _deviceAutoDiscoverEnabled(false)
+	, _modeNegotiation(false)
+	, _targetFps(25)
+	, _ledGridSize()
+	, _modeNegotiated(false)
+	, _fusedMapping(true)
 {
 	setPixelDecimation(pixelDecimation);
 	getV4Ldevices();
@@ -552,34 +638,28 @@ void V4L2Grabber::init_device(VideoStandard videoStandard, int input)
 		return;
 	}
 
-	// set the requested pixel format
-	switch (_pixelFormat)
+	// select the cheapest mode which still covers the led layout, otherwise keep the current mode of the device
+	DeviceMode mode = {};
+	_modeNegotiated = _modeNegotiation && negotiate_mode(mode);
+	if (_modeNegotiated)
 	{
-		case PIXELFORMAT_UYVY:
-			fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_UYVY;
-		break;
+		fmt.fmt.pix.pixelformat = mode.v4l2Format;
+		if (mode.v4l2Format == V4L2_PIX_FMT_MJPEG)
+			fmt.fmt.pix.field = V4L2_FIELD_ANY;
 
-		case PIXELFORMAT_YUYV:
-			fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_YUYV;
-		break;
-
-		case PIXELFORMAT_RGB32:
-			fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_RGB32;
-		break;
+		_width  = mode.width;
+		_height = mode.height;
+	}
+	else
+	{
+		// set the requested pixel format
+		if (_configuredPixelFormat != PIXELFORMAT_NO_CHANGE && toV4L2Format(_configuredPixelFormat) != 0)
+			fmt.fmt.pix.pixelformat = toV4L2Format(_configuredPixelFormat);
 
 #ifdef HAVE_JPEG
-		case PIXELFORMAT_MJPEG:
-		{
-			fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_MJPEG;
-			fmt.fmt.pix.field       = V4L2_FIELD_ANY;
-		}
-		break;
+		if (_configuredPixelFormat == PIXELFORMAT_MJPEG)
+			fmt.fmt.pix.field = V4L2_FIELD_ANY;
 #endif
-
-		case PIXELFORMAT_NO_CHANGE:
-		default:
-			// No change to device settings
-			break;
 	}
 
 	// set the settings
@@ -616,7 +696,12 @@ void V4L2Grabber::init_device(VideoStandard videoStandard, int input)
 			// Driver supports the feature. Set required framerate
 			streamparms.parm.capture.capturemode = V4L2_MODE_HIGHQUALITY;
 			streamparms.parm.capture.timeperframe.numerator = 1;
-			streamparms.parm.capture.timeperframe.denominator = 30;
+			streamparms.parm.capture.timeperframe.denominator = _modeNegotiated ? _targetFps : 30;
+			if (_modeNegotiated && mode.intervalDenominator != 0)
+			{
+				streamparms.parm.capture.timeperframe.numerator = mode.intervalNumerator;
+				streamparms.parm.capture.timeperframe.denominator = mode.intervalDenominator;
+			}
 			if(-1 == xioctl(VIDIOC_S_PARM, &streamparms))
 			{
 				throw_errno_exception("VIDIOC_S_PARM");
@@ -655,6 +740,56 @@ void V4L2Grabber::init_device(VideoStandard videoStandard, int input)
 		}
 		break;
 
+		case V4L2_PIX_FMT_RGB24:
+		{
+			_pixelFormat = PIXELFORMAT_RGB24;
+			_frameByteSize = _width * _height * 3;
+			Debug(_log, "Pixel format=RGB24");
+		}
+		break;
+
+		case V4L2_PIX_FMT_BGR24:
+		{
+			_pixelFormat = PIXELFORMAT_BGR24;
+			_frameByteSize = _width * _height * 3;
+			Debug(_log, "Pixel format=BGR24");
+		}
+		break;
+
+		case V4L2_PIX_FMT_RGB565:
+		{
+			_pixelFormat = PIXELFORMAT_BGR16;
+			_frameByteSize = _width * _height * 2;
+			Debug(_log, "Pixel format=RGB565");
+		}
+		break;
+
+		case V4L2_PIX_FMT_GREY:
+		{
+			_pixelFormat = PIXELFORMAT_GREY;
+			_frameByteSize = _lineLength * _height;
+			Debug(_log, "Pixel format=GREY");
+		}
+		break;
+
+		// planar 4:2:0 formats, the chroma planes follow the luma plane with half the rows
+		case V4L2_PIX_FMT_NV12:
+		case V4L2_PIX_FMT_NV21:
+		case V4L2_PIX_FMT_YUV420:
+		case V4L2_PIX_FMT_YVU420:
+		{
+			switch (fmt.fmt.pix.pixelformat)
+			{
+				case V4L2_PIX_FMT_NV12:   _pixelFormat = PIXELFORMAT_NV12; break;
+				case V4L2_PIX_FMT_NV21:   _pixelFormat = PIXELFORMAT_NV21; break;
+				case V4L2_PIX_FMT_YUV420: _pixelFormat = PIXELFORMAT_I420; break;
+				default:                  _pixelFormat = PIXELFORMAT_YV12; break;
+			}
+			_frameByteSize = _lineLength * _height * 3 / 2;
+			Debug(_log, "Pixel format=%.4s", reinterpret_cast<const char*>(&fmt.fmt.pix.pixelformat));
+		}
+		break;
+
 #ifdef HAVE_JPEG
 		case V4L2_PIX_FMT_MJPEG:
 		{
@@ -666,13 +801,16 @@ void V4L2Grabber::init_device(VideoStandard videoStandard, int input)
 
 		default:
 #ifdef HAVE_JPEG
-			throw_exception("Only pixel formats UYVY, YUYV, RGB32 and MJPEG are supported");
+			throw_exception("Only pixel formats UYVY, YUYV, NV12, NV21, I420, YV12, GREY, RGB565, RGB24, BGR24, RGB32 and MJPEG are supported");
 #else
-			throw_exception("Only pixel formats UYVY, YUYV, and RGB32 are supported");
+			throw_exception("Only pixel formats UYVY, YUYV, NV12, NV21, I420, YV12, GREY, RGB565, RGB24, BGR24 and RGB32 are supported");
 #endif
 		return;
 	}
 
+	// the limit of the decimation depends on the mode
+	update_pixel_decimation();
+
 	switch (_ioMethod)
 	{
 		case IO_METHOD_READ:
@@ -689,6 +827,167 @@ void V4L2Grabber::init_device(VideoStandard videoStandard, int input)
 	}
 }
 
+bool V4L2Grabber::negotiate_mode(DeviceMode& mode)
+{
+	if (_ledGridSize.isEmpty())
+	{
+		Debug(_log, "The led layout is empty, keep the current mode of the device");
+		return false;
+	}
+
+	const unsigned neededWidth  = _ledGridSize.width()  * MIN_CAPTURE_PIXELS_PER_LED;
+	const unsigned neededHeight = _ledGridSize.height() * MIN_CAPTURE_PIXELS_PER_LED;
+	std::vector<DeviceMode> modes;
+
+	struct v4l2_fmtdesc fmtdesc;
+	CLEAR(fmtdesc);
+	fmtdesc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+
+	for (; 0 == xioctl(VIDIOC_ENUM_FMT, &fmtdesc); ++fmtdesc.index)
+	{
+		// skip formats which can't be converted, a configured pixel format restricts the selection
+		if (formatCost(fmtdesc.pixelformat) == 0 || (_configuredPixelFormat != PIXELFORMAT_NO_CHANGE && fmtdesc.pixelformat != toV4L2Format(_configuredPixelFormat)))
+			continue;
+
+		// grey frames are the cheapest, but lose all colors, so they are only captured when configured
+		if (fmtdesc.pixelformat == V4L2_PIX_FMT_GREY && _configuredPixelFormat != PIXELFORMAT_GREY)
+			continue;
+
+		struct v4l2_frmsizeenum frmsize;
+		CLEAR(frmsize);
+		frmsize.pixel_format = fmtdesc.pixelformat;
+
+		for (; 0 == xioctl(VIDIOC_ENUM_FRAMESIZES, &frmsize); ++frmsize.index)
+		{
+			if (frmsize.type == V4L2_FRMSIZE_TYPE_DISCRETE)
+			{
+				enum_frame_intervals(fmtdesc.pixelformat, frmsize.discrete.width, frmsize.discrete.height, modes);
+			}
+			else
+			{
+				// continuous or stepwise sizes are reported as a single range, take the smallest size which covers the led layout
+				const v4l2_frmsize_stepwise& range = frmsize.stepwise;
+				enum_frame_intervals(fmtdesc.pixelformat,
+					fitToRange(neededWidth, range.min_width, range.max_width, range.step_width),
+					fitToRange(neededHeight, range.min_height, range.max_height, range.step_height),
+					modes);
+				break;
+			}
+		}
+	}
+
+	if (modes.empty())
+	{
+		Debug(_log, "The device doesn't report usable modes, keep the current mode of the device");
+		return false;
+	}
+
+	const auto fps = [this](const DeviceMode& m)
+	{
+		return (m.intervalNumerator != 0 && m.intervalDenominator != 0) ? double(m.intervalDenominator) / m.intervalNumerator : double(_targetFps);
+	};
+	const auto coversLayout = [neededWidth, neededHeight](const DeviceMode& m)
+	{
+		return m.width >= neededWidth && m.height >= neededHeight;
+	};
+	const auto reachesRate = [this, &fps](const DeviceMode& m)
+	{
+		// allow NTSC rates like 29.97 for a target of 30
+		return fps(m) >= _targetFps * 0.99;
+	};
+	const auto cost = [&fps](const DeviceMode& m)
+	{
+		return double(m.width) * m.height * fps(m) * formatCost(m.v4l2Format);
+	};
+
+	// prefer modes which cover the led layout at the target rate and of those the cheapest to transfer and convert,
+	// if there is none come as close as possible
+	const auto better = [&](const DeviceMode& a, const DeviceMode& b)
+	{
+		if (coversLayout(a) != coversLayout(b))
+			return coversLayout(a);
+		if (reachesRate(a) != reachesRate(b))
+			return reachesRate(a);
+		if (!coversLayout(a) && a.width * a.height != b.width * b.height)
+			return a.width * a.height > b.width * b.height;
+		if (!reachesRate(a) && fps(a) != fps(b))
+			return fps(a) > fps(b);
+		return cost(a) < cost(b);
+	};
+
+	mode = modes.front();
+	for (const DeviceMode& candidate : modes)
+	{
+		if (better(candidate, mode))
+			mode = candidate;
+	}
+
+	const char* fourcc = reinterpret_cast<const char*>(&mode.v4l2Format);
+	Info(_log, "Negotiated mode %.4s %ux%u at %.2f fps out of %zu modes, the led layout needs %ux%u at %d fps",
+		fourcc, mode.width, mode.height, fps(mode), modes.size(), neededWidth, neededHeight, _targetFps);
+	WarningIf(!coversLayout(mode) || !reachesRate(mode), _log, "The device offers no mode which covers the led layout at the target rate");
+
+	return true;
+}
+
+void V4L2Grabber::enum_frame_intervals(uint32_t v4l2Format, unsigned width, unsigned height, std::vector<DeviceMode>& modes)
+{
+	struct v4l2_frmivalenum frmival;
+	CLEAR(frmival);
+	frmival.pixel_format = v4l2Format;
+	frmival.width = width;
+	frmival.height = height;
+
+	for (; 0 == xioctl(VIDIOC_ENUM_FRAMEINTERVALS, &frmival); ++frmival.index)
+	{
+		if (frmival.type == V4L2_FRMIVAL_TYPE_DISCRETE)
+		{
+			modes.push_back({ v4l2Format, width, height, frmival.discrete.numerator, frmival.discrete.denominator });
+		}
+		else
+		{
+			// continuous or stepwise intervals, take the target rate limited to the range (min is the shortest interval)
+			const v4l2_frmival_stepwise& range = frmival.stepwise;
+			DeviceMode mode { v4l2Format, width, height, 1, unsigned(_targetFps) };
+			if (range.min.denominator != 0 && double(range.min.numerator) / range.min.denominator > 1.0 / _targetFps)
+			{
+				mode.intervalNumerator = range.min.numerator;
+				mode.intervalDenominator = range.min.denominator;
+			}
+			else if (range.max.denominator != 0 && double(range.max.numerator) / range.max.denominator < 1.0 / _targetFps)
+			{
+				mode.intervalNumerator = range.max.numerator;
+				mode.intervalDenominator = range.max.denominator;
+			}
+			modes.push_back(mode);
+			return;
+		}
+	}
+
+	// the device doesn't report frame intervals for this size
+	if (frmival.index == 0)
+		modes.push_back({ v4l2Format, width, height, 0, 0 });
+}
+
+void V4L2Grabber::update_pixel_decimation()
+{
+	int pixelDecimation = _pixelDecimation;
+	if (_modeNegotiated && !_ledGridSize.isEmpty())
+	{
+		// a negotiated mode is small already, don't decimate it below the resolution the led layout needs
+		const int limit = qMin(_width / (_ledGridSize.width() * MIN_DECIMATED_PIXELS_PER_LED), _height / (_ledGridSize.height() * MIN_DECIMATED_PIXELS_PER_LED));
+		pixelDecimation = qMin(pixelDecimation, qMax(1, limit));
+	}
+
+	if (_appliedPixelDecimation != pixelDecimation)
+	{
+		_appliedPixelDecimation = pixelDecimation;
+		_imageResampler.setHorizontalPixelDecimation(pixelDecimation);
+		_imageResampler.setVerticalPixelDecimation(pixelDecimation);
+		DebugIf(pixelDecimation != _pixelDecimation, _log, "Pixel decimation limited to %d for the led layout", pixelDecimation);
+	}
+}
+
 void V4L2Grabber::uninit_device()
 {
 	switch (_ioMethod)
@@ -918,9 +1217,9 @@ bool V4L2Grabber::process_image(const void *p, int size)
 {
 	// We do want a new frame...
 #ifdef HAVE_JPEG
-	if (size != _frameByteSize && _pixelFormat != PIXELFORMAT_MJPEG)
+	if (size < _frameByteSize && _pixelFormat != PIXELFORMAT_MJPEG)
 #else
-	if (size != _frameByteSize)
+	if (size < _frameByteSize)
 #endif
 	{
 		Error(_log, "Frame too small: %d != %d", size, _frameByteSize);
@@ -936,10 +1235,45 @@ bool V4L2Grabber::process_image(const void *p, int size)
 
 void V4L2Grabber::process_image(const uint8_t * data, int size)
 {
-	Image<ColorRgb> image(_width, _height);
+	// hand over the frame as it is, the instances map the leds directly on it. The signal detection needs the image
+	if (_fusedMapping && !_signalDetectionEnabled && RawImage::isMappable(_pixelFormat)
+		&& CaptureChannels::getInstance()->rawAccepted(CaptureChannels::V4L, _pixelFormat))
+	{
+		RawImage raw;
+		raw.pixelFormat     = _pixelFormat;
+		raw.width           = _width;
+		raw.height          = _height;
+		raw.lineLength      = _lineLength;
+		// in average mode every pixel of a led area counts, like in the averaged image
+		raw.pixelDecimation = (_imageResampler.getDecimationMode() == ImageResampler::DECIMATION_AVERAGE) ? 1 : _appliedPixelDecimation;
+		raw.data            = data;
+		raw.size            = size_t(_frameByteSize);
+		_imageResampler.getCropping(_width, _height, raw.cropLeft, raw.cropRight, raw.cropTop, raw.cropBottom);
+
+		if (raw.isValid())
+		{
+			emit newRawFrame(raw);
+			return;
+		}
+	}
 
 #ifdef HAVE_JPEG
-	if (_pixelFormat == PIXELFORMAT_MJPEG)
+	const bool compressed = (_pixelFormat == PIXELFORMAT_MJPEG);
+#else
+	const bool compressed = false;
+#endif
+
+	// the signal is detected on a sparse grid of the frame before it's converted, so idle inputs skip the conversion
+	if (_signalDetectionEnabled && !compressed && !updateSignalState(probeNoSignal(data)))
+	{
+		return;
+	}
+
+	// every row starts at an aligned address, the consumers use the stride of the image
+	Image<ColorRgb> image(_width, _height, Image<ColorRgb>::PADDED);
+
+#ifdef HAVE_JPEG
+	if (compressed)
 	{
 		_decompress = new jpeg_decompress_struct;
 		_error = new errorManager;
@@ -1013,76 +1347,123 @@ void V4L2Grabber::process_image(const uint8_t * data, int size)
 
 		QRect rect(_cropLeft, _cropTop, imageFrame.width() - _cropLeft - _cropRight, imageFrame.height() - _cropTop - _cropBottom);
 		imageFrame = imageFrame.copy(rect);
-		imageFrame = imageFrame.scaled(imageFrame.width() / _pixelDecimation, imageFrame.height() / _pixelDecimation,Qt::KeepAspectRatio);
+		imageFrame = imageFrame.scaled(imageFrame.width() / _appliedPixelDecimation, imageFrame.height() / _appliedPixelDecimation, Qt::KeepAspectRatio,
+			(_imageResampler.getDecimationMode() == ImageResampler::DECIMATION_AVERAGE) ? Qt::SmoothTransformation : Qt::FastTransformation);
+
+		// a smooth scaling may return another format, RGB888 has the byte order of ColorRgb
+		if (imageFrame.format() != QImage::Format_RGB888)
+			imageFrame = imageFrame.convertToFormat(QImage::Format_RGB888);
 
 		if ((image.width() != unsigned(imageFrame.width())) || (image.height() != unsigned(imageFrame.height())))
 			image.resize(imageFrame.width(), imageFrame.height());
 
-		for (int y=0; y<imageFrame.height(); ++y)
-			for (int x=0; x<imageFrame.width(); ++x)
-			{
-				QColor inPixel(imageFrame.pixel(x,y));
-				ColorRgb & outPixel = image(x,y);
-				outPixel.red   = inPixel.red();
-				outPixel.green = inPixel.green();
-				outPixel.blue  = inPixel.blue();
-			}
+		image.copyFrom(imageFrame.constBits(), size_t(imageFrame.bytesPerLine()));
 	}
 	else
 #endif
 		_imageResampler.processImage(data, _width, _height, _lineLength, _pixelFormat, image);
 
-	if (_signalDetectionEnabled)
+	// compressed frames have to be decoded first
+	if (_signalDetectionEnabled && compressed)
+	{
+		if (!updateSignalState(isBelowSignalThreshold(image,
+				unsigned(image.width() * _x_frac_min), unsigned(image.width() * _x_frac_max),
+				unsigned(image.height() * _y_frac_min), unsigned(image.height() * _y_frac_max), unsigned(_signalDetectionStep))))
+		{
+			return;
+		}
+	}
+
+	emit newFrame(image);
+}
+
+bool V4L2Grabber::probeNoSignal(const uint8_t * data)
+{
+	int cropLeft, cropRight, cropTop, cropBottom;
+	_imageResampler.getCropping(_width, _height, cropLeft, cropRight, cropTop, cropBottom);
+
+	// the detection area (only in center, because some grabbers have noise values along the borders) on the converted image,
+	// which consists of the center pixels of the decimated blocks
+	const int decimation   = _appliedPixelDecimation;
+	const int outputWidth  = (_width - cropLeft - cropRight - (decimation >> 1) + decimation - 1) / decimation;
+	const int outputHeight = (_height - cropTop - cropBottom - (decimation >> 1) + decimation - 1) / decimation;
+	const int xMin = int(outputWidth  * _x_frac_min);
+	const int xMax = int(outputWidth  * _x_frac_max);
+	const int yMin = int(outputHeight * _y_frac_min);
+	const int yMax = int(outputHeight * _y_frac_max);
+
+	const int step    = _signalDetectionStep;
+	const int columns = (xMax - xMin + step - 1) / step;
+	const int rows    = (yMax - yMin + step - 1) / step;
+	if (columns <= 0 || rows <= 0)
 	{
-		// check signal (only in center of the resulting image, because some grabbers have noise values along the borders)
-		bool noSignal = true;
+		return true;
+	}
 
-		// top left
-		unsigned xOffset  = image.width()  * _x_frac_min;
-		unsigned yOffset  = image.height() * _y_frac_min;
+	// convert just the checked pixels
+	_signalProbe.resize(unsigned(columns), unsigned(rows));
+	_imageResampler.processSamples(data, _height, _lineLength, _pixelFormat,
+		cropLeft + (decimation >> 1) + xMin * decimation, cropTop + (decimation >> 1) + yMin * decimation,
+		decimation * step, decimation * step, _signalProbe);
 
-		// bottom right
-		unsigned xMax     = image.width()  * _x_frac_max;
-		unsigned yMax     = image.height() * _y_frac_max;
+	return isBelowSignalThreshold(_signalProbe, 0, unsigned(columns), 0, unsigned(rows), 1);
+}
 
+bool V4L2Grabber::isBelowSignalThreshold(const Image<ColorRgb> & image, unsigned xMin, unsigned xMax, unsigned yMin, unsigned yMax, unsigned step) const
+{
+	const ColorRgb threshold = _noSignalThresholdColor;
 
-		for (unsigned x = xOffset; noSignal && x < xMax; ++x)
+	// row by row and without branches within a row, so the compiler can vectorize the comparison
+	for (unsigned y = yMin; y < yMax; y += step)
+	{
+		const ColorRgb* row = image.row(y);
+		uint8_t above = 0;
+		for (unsigned x = xMin; x < xMax; x += step)
 		{
-			for (unsigned y = yOffset; noSignal && y < yMax; ++y)
-			{
-				noSignal &= (ColorRgb&)image(x, y) <= _noSignalThresholdColor;
-			}
+			above |= uint8_t(row[x].red > threshold.red) | uint8_t(row[x].green > threshold.green) | uint8_t(row[x].blue > threshold.blue);
 		}
 
-		if (noSignal)
+		if (above)
 		{
-			++_noSignalCounter;
+			return false;
 		}
-		else
-		{
-			if (_noSignalCounter >= _noSignalCounterThreshold)
-			{
-				_noSignalDetected = true;
-				Info(_log, "Signal detected");
-			}
+	}
 
-			_noSignalCounter = 0;
-		}
+	return true;
+}
 
-		if ( _noSignalCounter < _noSignalCounterThreshold)
+bool V4L2Grabber::updateSignalState(bool noSignal)
+{
+	if (noSignal)
+	{
+		// stop counting once the signal is lost
+		if (_noSignalCounter <= _noSignalCounterThreshold)
 		{
-			emit newFrame(image);
+			++_noSignalCounter;
 		}
-		else if (_noSignalCounter == _noSignalCounterThreshold)
+	}
+	else
+	{
+		if (_noSignalCounter >= _noSignalCounterThreshold)
 		{
-			_noSignalDetected = false;
-			Info(_log, "Signal lost");
+			_noSignalDetected = true;
+			Info(_log, "Signal detected");
 		}
+
+		_noSignalCounter = 0;
 	}
-	else
+
+	if (_noSignalCounter < _noSignalCounterThreshold)
 	{
-		emit newFrame(image);
+		return true;
 	}
+
+	if (_noSignalCounter == _noSignalCounterThreshold)
+	{
+		_noSignalDetected = false;
+		Info(_log, "Signal lost");
+	}
+	return false;
 }
 
 int V4L2Grabber::xioctl(int request, void *arg)
@@ -1112,8 +1493,7 @@ void V4L2Grabber::setPixelDecimation(int pixelDecimation)
 	if (_pixelDecimation != pixelDecimation)
 	{
 		_pixelDecimation = pixelDecimation;
-		_imageResampler.setHorizontalPixelDecimation(pixelDecimation);
-		_imageResampler.setVerticalPixelDecimation(pixelDecimation);
+		update_pixel_decimation();
 	}
 }
 
@@ -1134,6 +1514,55 @@ void V4L2Grabber::setDeviceVideoStandard(QString device, VideoStandard videoStan
 	}
 }
 
+void V4L2Grabber::setModeNegotiation(bool enable, int fps)
+{
+	fps = qMax(1, fps);
+	if (_modeNegotiation != enable || _targetFps != fps)
+	{
+		_modeNegotiation = enable;
+		_targetFps = fps;
+
+		// the mode is selected when the device is initialized
+		bool started = _initialized;
+		uninit();
+		if(started) start();
+	}
+}
+
+void V4L2Grabber::setLedGridSize(const QSize& gridSize)
+{
+	if (_ledGridSize != gridSize)
+	{
+		_ledGridSize = gridSize;
+
+		if (_modeNegotiation)
+		{
+			bool started = _initialized;
+			uninit();
+			if(started) start();
+		}
+	}
+}
+
+void V4L2Grabber::setSignalDetectionStep(int step)
+{
+	step = qMax(1, step);
+	if (_signalDetectionStep != step)
+	{
+		_signalDetectionStep = step;
+		Debug(_log, "Signal detection checks every %d. pixel", step);
+	}
+}
+
+void V4L2Grabber::setFusedMapping(bool enable)
+{
+	if (_fusedMapping != enable)
+	{
+		_fusedMapping = enable;
+		Info(_log, "Fused led mapping %s", enable ? "enabled" : "disabled");
+	}
+}
+
 void V4L2Grabber::componentStateChanged(const hyperion::Components component, bool enable)
 {
 	if (component == hyperion::COMP_V4L)
@@ -2,6 +2,9 @@
 
 #include <grabber/V4L2Wrapper.h>
 
+// utils
+#include <utils/CaptureChannels.h>
+
 // qt
 #include <QTimer>
 
@@ -22,6 +25,7 @@ V4L2Wrapper::V4L2Wrapper(const QString &device,
 
 	// Handle the image in the captured thread using a direct connection
 	connect(&_grabber, SIGNAL(newFrame(Image<ColorRgb>)), this, SLOT(newFrame(Image<ColorRgb>)), Qt::DirectConnection);
+	connect(&_grabber, &V4L2Grabber::newRawFrame, this, &V4L2Wrapper::newRawFrame, Qt::DirectConnection);
 	connect(&_grabber, SIGNAL(readError(const char*)), this, SLOT(readError(const char*)), Qt::DirectConnection);
 	
 	connect(this, &V4L2Wrapper::componentStateChanged, _ggrabber, &Grabber::componentStateChanged);
@@ -56,6 +60,16 @@ void V4L2Wrapper::setSignalDetectionOffset(double verticalMin, double horizontal
 void V4L2Wrapper::newFrame(const Image<ColorRgb> &image)
 {
 	emit systemImage(_grabberName, image);
+
+	// the decoding time isn't known here, the governor decides on the cpu load only
+	frameDone(0);
+}
+
+void V4L2Wrapper::newRawFrame(const RawImage &raw)
+{
+	CaptureChannels::getInstance()->publishRaw(CaptureChannels::V4L, _grabberName, raw);
+
+	frameDone(0);
 }
 
 void V4L2Wrapper::readError(const char* err)
@@ -83,3 +97,36 @@ void V4L2Wrapper::setDeviceVideoStandard(QString device, VideoStandard videoStan
 {
 	_grabber.setDeviceVideoStandard(device, videoStandard);
 }
+
+void V4L2Wrapper::setModeNegotiation(bool enable, int fps)
+{
+	_grabber.setModeNegotiation(enable, fps);
+}
+
+void V4L2Wrapper::setLedGridSize(const QSize& gridSize)
+{
+	_grabber.setLedGridSize(gridSize);
+}
+
+void V4L2Wrapper::setFusedMapping(bool enable)
+{
+	_grabber.setFusedMapping(enable);
+}
+
+void V4L2Wrapper::setSignalDetectionStep(int step)
+{
+	_grabber.setSignalDetectionStep(step);
+}
+
+void V4L2Wrapper::handleSettingsUpdate(const settings::type& type, const QJsonDocument& config)
+{
+	if(type == settings::V4L2)
+	{
+		const QJsonObject& obj = config.object();
+		_grabber.setModeNegotiation(obj["modeNegotiation"].toBool(true), obj["fps"].toInt(25));
+		_grabber.setFusedMapping(obj["fusedMapping"].toBool(true));
+		_grabber.setSignalDetectionStep(obj["sDStep"].toInt(1));
+	}
+
+	GrabberWrapper::handleSettingsUpdate(type, config);
+}
@@ -4,7 +4,7 @@
 #include <hyperion/Hyperion.h>
 
 // utils includes
-#include <utils/GlobalSignals.h>
+#include <utils/CaptureChannels.h>
 
 // qt includes
 #include <QTimer>
@@ -16,10 +16,12 @@ CaptureCont::CaptureCont(Hyperion* hyperion)
 	, _systemCaptPrio(0)
 	, _systemCaptName()
 	, _systemInactiveTimer(new QTimer(this))
+	, _systemReceiver(nullptr)
 	, _v4lCaptEnabled(false)
 	, _v4lCaptPrio(0)
 	, _v4lCaptName()
 	, _v4lInactiveTimer(new QTimer(this))
+	, _v4lReceiver(nullptr)
 {
 	// settings changes
 	connect(_hyperion, &Hyperion::settingsChanged, this, &CaptureCont::handleSettingsUpdate);
@@ -45,7 +47,7 @@ CaptureCont::~CaptureCont()
 {
 }
 
-void CaptureCont::handleV4lImage(const QString& name, const Image<ColorRgb> & image)
+void CaptureCont::updateV4lInput(const QString& name)
 {
 	if(_v4lCaptName != name)
 	{
@@ -53,9 +55,23 @@ void CaptureCont::handleV4lImage(const QString& name, const Image<ColorRgb> & im
 		_v4lCaptName = name;
 	}
 	_v4lInactiveTimer->start();
+
+	// the capture thread skips the conversion of the next frames, if every instance maps its leds on raw frames
+	_v4lReceiver->setAcceptRaw(_hyperion->canMapRawImage(PIXELFORMAT_RGB24), _hyperion->canMapRawImage(PIXELFORMAT_YUYV));
+}
+
+void CaptureCont::handleV4lImage(const QString& name, const Image<ColorRgb> & image)
+{
+	updateV4lInput(name);
 	_hyperion->setInputImage(_v4lCaptPrio, image);
 }
 
+void CaptureCont::handleV4lRawFrame(const QString& name, const RawImage& raw)
+{
+	updateV4lInput(name);
+	_hyperion->setInputRawImage(_v4lCaptPrio, raw);
+}
+
 void CaptureCont::handleSystemImage(const QString& name, const Image<ColorRgb>& image)
 {
 	if(_systemCaptName != name)
@@ -74,12 +90,14 @@ void CaptureCont::setSystemCaptureEnable(const bool& enable)
 		if(enable)
 		{
 			_hyperion->registerInput(_systemCaptPrio, hyperion::COMP_GRABBER);
-			connect(GlobalSignals::getInstance(), &GlobalSignals::setSystemImage, this, &CaptureCont::handleSystemImage);
-			connect(GlobalSignals::getInstance(), &GlobalSignals::setSystemImage, _hyperion, &Hyperion::forwardSystemProtoMessage);
+			_systemReceiver = new CaptureReceiver(CaptureChannels::SYSTEM, this);
+			connect(_systemReceiver, &CaptureReceiver::newFrame, this, &CaptureCont::handleSystemImage);
+			connect(_systemReceiver, &CaptureReceiver::newFrame, _hyperion, &Hyperion::forwardSystemProtoMessage);
 		}
 		else
 		{
-			disconnect(GlobalSignals::getInstance(), &GlobalSignals::setSystemImage, 0, 0);
+			delete _systemReceiver;
+			_systemReceiver = nullptr;
 			_hyperion->clear(_systemCaptPrio);
 			_systemInactiveTimer->stop();
 			_systemCaptName = "";
@@ -97,12 +115,15 @@ void CaptureCont::setV4LCaptureEnable(const bool& enable)
 		if(enable)
 		{
 			_hyperion->registerInput(_v4lCaptPrio, hyperion::COMP_V4L);
-			connect(GlobalSignals::getInstance(), &GlobalSignals::setV4lImage, this, &CaptureCont::handleV4lImage);
-			connect(GlobalSignals::getInstance(), &GlobalSignals::setV4lImage, _hyperion, &Hyperion::forwardV4lProtoMessage);
+			_v4lReceiver = new CaptureReceiver(CaptureChannels::V4L, this);
+			connect(_v4lReceiver, &CaptureReceiver::newFrame, this, &CaptureCont::handleV4lImage);
+			connect(_v4lReceiver, &CaptureReceiver::newFrame, _hyperion, &Hyperion::forwardV4lProtoMessage);
+			connect(_v4lReceiver, &CaptureReceiver::newRawFrame, this, &CaptureCont::handleV4lRawFrame);
 		}
 		else
 		{
-			disconnect(GlobalSignals::getInstance(), &GlobalSignals::setV4lImage, 0, 0);
+			delete _v4lReceiver;
+			_v4lReceiver = nullptr;
 			_hyperion->clear(_v4lCaptPrio);
 			_v4lInactiveTimer->stop();
 			_v4lCaptName = "";
@@ -0,0 +1,195 @@
+#include <hyperion/CaptureGovernor.h>
+#include <utils/Logger.h>
+
+// qt
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+#ifdef Q_OS_UNIX
+	#include <sys/resource.h>
+#endif
+
+namespace {
+
+// the load is evaluated over this period
+const qint64 evaluationPeriodMs = 2000;
+// above this share of the grab interval a frame is considered too slow
+const double frameTimeLimit = 0.8;
+// below this share of the budget and the grab interval the quality is raised again
+const double headroomFactor = 0.6;
+
+QMutex _statesMutex;
+QMap<const CaptureGovernor*, QJsonObject> _states;
+
+}
+
+CaptureGovernor::CaptureGovernor(const QString& name)
+	: _name(name)
+	, _enabled(false)
+	, _cpuBudget(0.5)
+	, _minFrequency(5)
+	, _maxDecimation(16)
+	, _hasBaseline(false)
+	, _baseFrequency(0)
+	, _baseDecimation(0)
+	, _frequency(0)
+	, _pixelDecimation(0)
+	, _periodCpuUs(0)
+	, _frameTimeSumUs(0)
+	, _frames(0)
+	, _settle(0)
+	, _cpuLoad(0.0)
+	, _frameTimeMs(0.0)
+	, _decision("disabled")
+{
+}
+
+CaptureGovernor::~CaptureGovernor()
+{
+	QMutexLocker lock(&_statesMutex);
+	_states.remove(this);
+}
+
+void CaptureGovernor::setConfig(const QJsonObject& config)
+{
+	_enabled       = config["enable"].toBool(false);
+	_cpuBudget     = config["cpuBudget"].toInt(50) / 100.0;
+	_minFrequency  = config["minFrequency_Hz"].toInt(5);
+	_maxDecimation = config["maxDecimation"].toInt(16);
+
+	// start over with the configured quality
+	if (_hasBaseline)
+		setBaseline(_baseFrequency, _baseDecimation);
+}
+
+void CaptureGovernor::setBaseline(const int& frequency_Hz, const int& pixelDecimation)
+{
+	_hasBaseline     = true;
+	_baseFrequency   = frequency_Hz;
+	_baseDecimation  = pixelDecimation;
+	_frequency       = frequency_Hz;
+	_pixelDecimation = pixelDecimation;
+
+	_period.invalidate();
+	_settle = 0;
+	_decision = _enabled ? "configured quality" : "disabled";
+	publishState();
+}
+
+bool CaptureGovernor::addFrame(const int64_t& frameTimeUs)
+{
+	if (!_enabled)
+		return false;
+
+	if (!_period.isValid())
+	{
+		_period.start();
+		_periodCpuUs = processCpuTimeUs();
+		_frameTimeSumUs = 0;
+		_frames = 0;
+		return false;
+	}
+
+	_frameTimeSumUs += frameTimeUs;
+	_frames++;
+
+	const qint64 elapsedMs = _period.elapsed();
+	if (elapsedMs < evaluationPeriodMs)
+		return false;
+
+	// share of the total cpu capacity used by the whole process, all cores count
+	const int64_t cpuUs = processCpuTimeUs();
+	_cpuLoad = (cpuUs >= 0 && _periodCpuUs >= 0) ? double(cpuUs - _periodCpuUs) / (elapsedMs * 1000.0 * qMax(1, QThread::idealThreadCount())) : 0.0;
+	_frameTimeMs = (_frames > 0) ? _frameTimeSumUs / (_frames * 1000.0) : 0.0;
+
+	_period.restart();
+	_periodCpuUs = cpuUs;
+	_frameTimeSumUs = 0;
+	_frames = 0;
+
+	if (_settle > 0)
+	{
+		_settle--;
+		publishState();
+		return false;
+	}
+
+	const double intervalMs = (_frequency > 0) ? 1000.0 / _frequency : 0.0;
+	const bool overloaded = _cpuLoad > _cpuBudget || (intervalMs > 0 && _frameTimeMs > intervalMs * frameTimeLimit);
+	const bool headroom = _cpuLoad < _cpuBudget * headroomFactor && (intervalMs == 0 || _frameTimeMs < intervalMs * frameTimeLimit * headroomFactor);
+
+	const int maxDecimation = qMax(_baseDecimation, _maxDecimation);
+	const int minFrequency = qMin(_baseFrequency, _minFrequency);
+	const int prevFrequency = _frequency;
+	const int prevDecimation = _pixelDecimation;
+
+	if (overloaded)
+	{
+		// fewer pixels first, a lower rate is more visible
+		if (_pixelDecimation > 0 && _pixelDecimation < maxDecimation)
+			_pixelDecimation = qMin(maxDecimation, _pixelDecimation + qMax(1, _pixelDecimation / 4));
+		else if (_frequency > 0 && _frequency > minFrequency)
+			_frequency = qMax(minFrequency, _frequency * 3 / 4);
+	}
+	else if (headroom)
+	{
+		if (_frequency > 0 && _frequency < _baseFrequency)
+			_frequency = qMin(_baseFrequency, _frequency + qMax(1, _frequency / 3));
+		else if (_pixelDecimation > 0 && _pixelDecimation > _baseDecimation)
+			_pixelDecimation = qMax(_baseDecimation, _pixelDecimation - qMax(1, _pixelDecimation / 5));
+	}
+
+	const bool changed = (_frequency != prevFrequency || _pixelDecimation != prevDecimation);
+	if (changed)
+	{
+		_decision = QString("%1: %2 Hz, pixel decimation %3").arg(overloaded ? "reduced quality" : "raised quality").arg(_frequency).arg(_pixelDecimation);
+		Info(Logger::getInstance("GOVERNOR"), "%s %s (cpu load %.0f%% of %.0f%%, frame time %.1f ms)", QSTRING_CSTR(_name), QSTRING_CSTR(_decision), _cpuLoad * 100, _cpuBudget * 100, _frameTimeMs);
+		_settle = 1;
+	}
+	else if (overloaded)
+		_decision = "over budget at the lowest quality";
+	else
+		_decision = (_frequency == _baseFrequency && _pixelDecimation == _baseDecimation) ? "configured quality" : "reduced quality";
+
+	publishState();
+	return changed;
+}
+
+QJsonArray CaptureGovernor::getStates()
+{
+	QMutexLocker lock(&_statesMutex);
+
+	QJsonArray states;
+	for (const QJsonObject& state : _states)
+		states.append(state);
+	return states;
+}
+
+int64_t CaptureGovernor::processCpuTimeUs()
+{
+#ifdef Q_OS_UNIX
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+	{
+		return int64_t(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+	}
+#endif
+	return -1;
+}
+
+void CaptureGovernor::publishState()
+{
+	QJsonObject state;
+	state["name"]            = _name;
+	state["enabled"]         = _enabled;
+	state["frequency_Hz"]    = _frequency;
+	state["pixelDecimation"] = _pixelDecimation;
+	state["cpuLoad"]         = _cpuLoad;
+	state["frameTime_ms"]    = _frameTimeMs;
+	state["decision"]        = _decision;
+
+	QMutexLocker lock(&_statesMutex);
+	_states[this] = state;
+}
@@ -38,6 +38,19 @@ void Grabber::setVideoMode(VideoMode mode)
 	}
 }
 
+void Grabber::setDecimationMode(const QString& mode)
+{
+	if ( _useImageResampler )
+	{
+		const ImageResampler::DecimationMode decimationMode = ImageResampler::parseDecimationMode(mode);
+		if (decimationMode != _imageResampler.getDecimationMode())
+		{
+			Debug(_log,"Set decimation mode to %s", QSTRING_CSTR(mode.toLower()));
+			_imageResampler.setDecimationMode(decimationMode);
+		}
+	}
+}
+
 void Grabber::setCropping(unsigned cropLeft, unsigned cropRight, unsigned cropTop, unsigned cropBottom)
 {
 	if (_width>0 && _height>0)
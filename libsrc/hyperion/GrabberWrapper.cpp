@@ -1,13 +1,15 @@
 // Hyperion includes
 #include <hyperion/GrabberWrapper.h>
 #include <hyperion/Grabber.h>
+#include <hyperion/CaptureGovernor.h>
 #include <HyperionConfig.h>
 
 // utils includes
-#include <utils/GlobalSignals.h>
+#include <utils/CaptureChannels.h>
 
 // qt
 #include <QTimer>
+#include <QThread>
 
 GrabberWrapper::GrabberWrapper(QString grabberName, Grabber * ggrabber, unsigned width, unsigned height, const unsigned updateRate_Hz)
 	: _grabberName(grabberName)
@@ -16,6 +18,7 @@ GrabberWrapper::GrabberWrapper(QString grabberName, Grabber * ggrabber, unsigned
 	, _log(Logger::getInstance(grabberName))
 	, _ggrabber(ggrabber)
 	, _image(0,0)
+	, _governor(new CaptureGovernor(grabberName))
 {
 	// Configure the timer to generate events every n milliseconds
 	_timer->setInterval(_updateInterval_ms);
@@ -24,20 +27,29 @@ GrabberWrapper::GrabberWrapper(QString grabberName, Grabber * ggrabber, unsigned
 
 	connect(_timer, &QTimer::timeout, this, &GrabberWrapper::action);
 
-	// connect the image forwarding
-	(_grabberName.startsWith("V4L"))
-		? connect(this, &GrabberWrapper::systemImage, GlobalSignals::getInstance(), &GlobalSignals::setV4lImage)
-		: connect(this, &GrabberWrapper::systemImage, GlobalSignals::getInstance(), &GlobalSignals::setSystemImage);
+	// hand the images over to the instances without leaving the capture thread
+	const CaptureChannels::Source source = _grabberName.startsWith("V4L") ? CaptureChannels::V4L : CaptureChannels::SYSTEM;
+	connect(this, &GrabberWrapper::systemImage, this, [source](const QString& name, const Image<ColorRgb>& image)
+	{
+		CaptureChannels::getInstance()->publish(source, name, image);
+	}, Qt::DirectConnection);
 }
 
 GrabberWrapper::~GrabberWrapper()
 {
 	GrabberWrapper::stop(); // TODO Is this right????????
+	delete _governor;
 	Debug(_log,"Close grabber: %s", QSTRING_CSTR(_grabberName));
 }
 
 bool GrabberWrapper::start()
 {
+	// the grabbers are constructed with their configured quality, later changes are applied by handleSettingsUpdate()
+	if (!_governor->hasBaseline())
+	{
+		_governor->setBaseline(_grabberName.startsWith("V4L") ? 0 : 1000/_updateInterval_ms, _ggrabber->getPixelDecimation());
+	}
+
 	// Start the timer with the pre configured interval
 	_timer->start();
 	return _timer->isActive();
@@ -49,6 +61,15 @@ void GrabberWrapper::stop()
 	_timer->stop();
 }
 
+void GrabberWrapper::moveToCaptureThread(QThread* thread)
+{
+	moveToThread(thread);
+
+	// the grabbers are members of the wrappers and not parented, they have to follow explicitly
+	if (_ggrabber != nullptr && _ggrabber->parent() == nullptr)
+		_ggrabber->moveToThread(thread);
+}
+
 QStringList GrabberWrapper::availableGrabbers()
 {
 	QStringList grabbers;
@@ -99,8 +120,39 @@ void GrabberWrapper::setCropping(unsigned cropLeft, unsigned cropRight, unsigned
 	_ggrabber->setCropping(cropLeft, cropRight, cropTop, cropBottom);
 }
 
+void GrabberWrapper::setDecimationMode(const QString& mode)
+{
+	_ggrabber->setDecimationMode(mode);
+}
+
+void GrabberWrapper::frameDone(const int64_t& frameTimeUs)
+{
+	if (_governor->addFrame(frameTimeUs))
+		applyGovernor();
+}
+
+void GrabberWrapper::applyGovernor()
+{
+	// the rate of v4l is given by the device
+	if (_governor->frequency() > 0 && !_grabberName.startsWith("V4L"))
+	{
+		const int interval = 1000/_governor->frequency();
+		if (_timer->interval() != interval)
+			_timer->setInterval(interval);
+	}
+
+	if (_governor->pixelDecimation() > 0)
+		_ggrabber->setPixelDecimation(_governor->pixelDecimation());
+}
+
 void GrabberWrapper::handleSettingsUpdate(const settings::type& type, const QJsonDocument& config)
 {
+	if(type == settings::CAPTUREGOVERNOR)
+	{
+		_governor->setConfig(config.object());
+		applyGovernor();
+	}
+
 	if(type == settings::V4L2 || type == settings::SYSTEMCAPTURE)
 	{
 		// extract settings
@@ -119,6 +171,7 @@ void GrabberWrapper::handleSettingsUpdate(const settings::type& type, const QJso
 
 			// pixel decimation for x11
 			_ggrabber->setPixelDecimation(obj["pixelDecimation"].toInt(8));
+			_ggrabber->setDecimationMode(obj["decimationMode"].toString("sample"));
 
 			// crop for system capture
 			_ggrabber->setCropping(
@@ -137,6 +190,9 @@ void GrabberWrapper::handleSettingsUpdate(const settings::type& type, const QJso
 				if(timerWasActive)
 					_timer->start();
 			}
+
+			_governor->setBaseline(1000/_updateInterval_ms, _ggrabber->getPixelDecimation());
+			applyGovernor();
 		}
 
 		// v4l instances only!
@@ -144,6 +200,7 @@ void GrabberWrapper::handleSettingsUpdate(const settings::type& type, const QJso
 		{
 			// pixel decimation for v4l
 			_ggrabber->setPixelDecimation(obj["sizeDecimation"].toInt(8));
+			_ggrabber->setDecimationMode(obj["decimationMode"].toString("sample"));
 
 			// crop for v4l
 			_ggrabber->setCropping(
@@ -166,6 +223,8 @@ void GrabberWrapper::handleSettingsUpdate(const settings::type& type, const QJso
 				obj["device"].toString("auto"),
 				parseVideoStandard(obj["standard"].toString("no-change")));
 
+			_governor->setBaseline(0, _ggrabber->getPixelDecimation());
+			applyGovernor();
 		}
 	}
 }
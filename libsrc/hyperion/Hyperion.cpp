@@ -8,6 +8,7 @@
 #include <QString>
 #include <QStringList>
 #include <QThread>
+#include <QMetaMethod>
 
 // hyperion include
 #include <hyperion/Hyperion.h>
@@ -24,6 +25,7 @@
 
 #include <hyperion/MultiColorAdjustment.h>
 #include "LinearColorSmoothing.h"
+#include "RenderLoop.h"
 
 // effect engine includes
 #include <effectengine/EffectEngine.h>
@@ -57,6 +59,7 @@ Hyperion::Hyperion(const quint8& instance)
 	, _ledGridSize(hyperion::getLedLayoutGridSize(getSetting(settings::LEDS).array()))
 	, _prevCompId(hyperion::COMP_INVALID)
 	, _ledBuffer(_ledString.leds().size(), ColorRgb::BLACK)
+	, _renderLoop(nullptr)
 {
 
 }
@@ -82,14 +85,10 @@ void Hyperion::start()
 	// handle hwLedCount
 	_hwLedCount = qMax(unsigned(getSetting(settings::DEVICE).object()["hardwareLedCount"].toInt(getLedCount())), getLedCount());
 
-	// init colororder vector
-	for (Led& led : _ledString.leds())
+	// init the configuration used by update()
 	{
-		_ledStringColorOrder.push_back(led.colorOrder);
-	}
-	for (Led& led : _ledStringClone.leds())
-	{
-		_ledStringColorOrder.insert(_ledStringColorOrder.begin() + led.index, led.colorOrder);
+		QMutexLocker lock(&_changes);
+		publishOutputConfig();
 	}
 
 	// connect Hyperion::update with Muxer visible priority changes as muxer updates independent
@@ -117,6 +116,10 @@ void Hyperion::start()
 	_deviceSmooth = new LinearColorSmoothing(getSetting(settings::SMOOTHING), this);
 	connect(this, &Hyperion::settingsChanged, _deviceSmooth, &LinearColorSmoothing::handleSettingsUpdate);
 
+	// output clock, drives the smoothing when the render loop is enabled
+	_renderLoop = new RenderLoop(getSetting(settings::OUTPUT), this, _deviceSmooth);
+	connect(this, &Hyperion::settingsChanged, _renderLoop, &RenderLoop::handleSettingsUpdate);
+
 	// create the message forwarder only on main instance
 	if (_instIndex == 0)
 		_messageForwarder = new MessageForwarder(this);
@@ -157,10 +160,17 @@ void Hyperion::stop()
 {
 	emit finished();
 	thread()->wait();
+
+	// the instance thread has been finished, persist pending settings changes
+	_settingsManager->flushSettings();
 }
 
 void Hyperion::freeObjects(bool emitCloseSignal)
 {
+	// there is no further tick, render the following clear immediately
+	if (_renderLoop != nullptr)
+		_renderLoop->setEnable(false);
+
 	// switch off all leds
 	clearall(true);
 
@@ -183,15 +193,19 @@ void Hyperion::handleSettingsUpdate(const settings::type& type, const QJsonDocum
 {
 	if(type == settings::COLOR)
 	{
+		QMutexLocker lock(&_changes);
 		const QJsonObject obj = config.object();
 		// change in color recreate ledAdjustments
 		delete _raw2ledAdjustment;
 		_raw2ledAdjustment = hyperion::createLedColorsAdjustment(_ledString.leds().size(), obj);
+		_raw2ledAdjustment->setBacklightEnabled((_prevCompId != hyperion::COMP_COLOR && _prevCompId != hyperion::COMP_EFFECT));
 
 		if (!_raw2ledAdjustment->verifyAdjustments())
 		{
 			Warning(_log, "At least one led has no color calibration, please add all leds from your led layout to an 'LED index' field!");
 		}
+
+		publishOutputConfig();
 	}
 	else if(type == settings::LEDS)
 	{
@@ -209,25 +223,15 @@ void Hyperion::handleSettingsUpdate(const settings::type& type, const QJsonDocum
 		_muxer.updateLedColorsLength(_ledString.leds().size());
 		_ledGridSize = hyperion::getLedLayoutGridSize(leds);
 
-		std::vector<ColorRgb> color(_ledString.leds().size(), ColorRgb{0,0,0});
-		_ledBuffer = color;
-
-		_ledStringColorOrder.clear();
-		for (Led& led : _ledString.leds())
-		{
-			_ledStringColorOrder.push_back(led.colorOrder);
-		}
-		for (Led& led : _ledStringClone.leds())
-		{
-			_ledStringColorOrder.insert(_ledStringColorOrder.begin() + led.index, led.colorOrder);
-		}
-
 		// handle hwLedCount update
 		_hwLedCount = qMax(unsigned(getSetting(settings::DEVICE).object()["hardwareLedCount"].toInt(getLedCount())), getLedCount());
 
 		// change in leds are also reflected in adjustment
 		delete _raw2ledAdjustment;
 		_raw2ledAdjustment = hyperion::createLedColorsAdjustment(_ledString.leds().size(), getSetting(settings::COLOR).object());
+		_raw2ledAdjustment->setBacklightEnabled((_prevCompId != hyperion::COMP_COLOR && _prevCompId != hyperion::COMP_EFFECT));
+
+		publishOutputConfig();
 
 		// start cached effects
 		_effectEngine->startCachedEffects();
@@ -248,6 +252,8 @@ void Hyperion::handleSettingsUpdate(const settings::type& type, const QJsonDocum
 			_imageProcessor->setLedString(_ledString);
 		}
 
+		publishOutputConfig();
+
 		// do always reinit until the led devices can handle dynamic changes
 		dev["currentLedCount"] = int(_hwLedCount); // Inject led count info
 		_ledDeviceWrapper->createLedDevice(dev);
@@ -354,6 +360,31 @@ bool Hyperion::setInputImage(const int priority, const Image<ColorRgb>& image, i
 	return false;
 }
 
+bool Hyperion::setInputRawImage(const int priority, const RawImage& raw)
+{
+	if (!_muxer.hasPriority(priority))
+	{
+		emit GlobalSignals::getInstance()->globalRegRequired(priority);
+		return false;
+	}
+
+	// the image processor is shared with render()
+	std::vector<ColorRgb> ledColors;
+	{
+		QMutexLocker lock(&_frameLock);
+		_imageProcessor->processRaw(raw, ledColors);
+	}
+
+	return !ledColors.empty() && setInput(priority, ledColors);
+}
+
+bool Hyperion::canMapRawImage(const PixelFormat& pixelFormat)
+{
+	return (RawImage::isPackedRgb(pixelFormat) || !_imageProcessor->blackBorderDetectorEnabled())
+		&& !isSignalConnected(QMetaMethod::fromSignal(&Hyperion::currentImage))
+		&& !isSignalConnected(QMetaMethod::fromSignal(&Hyperion::forwardV4lProtoMessage));
+}
+
 bool Hyperion::setInputInactive(const quint8& priority)
 {
 	return _muxer.setInputInactive(priority);
@@ -389,6 +420,10 @@ ColorAdjustment * Hyperion::getAdjustment(const QString& id)
 
 void Hyperion::adjustmentsUpdated()
 {
+	{
+		QMutexLocker lock(&_changes);
+		publishOutputConfig();
+	}
 	emit adjustmentChanged();
 	update();
 }
@@ -513,12 +548,40 @@ void Hyperion::updatedComponentState(const hyperion::Components comp, const bool
 		_imageProcessor->setHardLedMappingType((_prevCompId == hyperion::COMP_EFFECT) ? 0 : -1);
 		_prevCompId = comp;
 		_raw2ledAdjustment->setBacklightEnabled((_prevCompId != hyperion::COMP_COLOR && _prevCompId != hyperion::COMP_EFFECT));
+		publishOutputConfig();
 	}
 }
 
+void Hyperion::publishOutputConfig()
+{
+	std::shared_ptr<LedOutputConfig> config = std::make_shared<LedOutputConfig>();
+
+	config->remap = LedRemap(_ledString, _ledStringClone, _hwLedCount);
+	config->adjustment = std::make_shared<MultiColorAdjustment>(*_raw2ledAdjustment);
+
+	// a running update() keeps the previous snapshot alive until it's done
+	std::atomic_store(&_outputConfig, std::shared_ptr<const LedOutputConfig>(config));
+}
+
 void Hyperion::update()
 {
-	QMutexLocker lock(&_changes);
+	// the render loop pulls the newest input with its next tick
+	if (_renderLoop != nullptr && _renderLoop->requestFrame())
+		return;
+
+	render();
+}
+
+void Hyperion::render()
+{
+	QMutexLocker lock(&_frameLock);
+
+	// acquire the current configuration, it stays valid for this frame even if a reconfiguration happens meanwhile
+	const std::shared_ptr<const LedOutputConfig> config = std::atomic_load(&_outputConfig);
+	if (config == nullptr)
+	{
+		return;
+	}
 
 	// Obtain the current priority channel
 	int priority = _muxer.getCurrentPriority();
@@ -537,50 +600,11 @@ void Hyperion::update()
 	// emit rawLedColors before transform
 	emit rawLedColors(_ledBuffer);
 
-	_raw2ledAdjustment->applyAdjustment(_ledBuffer);
-
-	// insert cloned leds into buffer
-	for (Led& led : _ledStringClone.leds())
-	{
-		_ledBuffer.insert(_ledBuffer.begin() + led.index, _ledBuffer.at(led.clone));
-	}
-
-	int i = 0;
-	for (ColorRgb& color : _ledBuffer)
-	{
-		// correct the color byte order
-		switch (_ledStringColorOrder.at(i))
-		{
-		case ORDER_RGB:
-			// leave as it is
-			break;
-		case ORDER_BGR:
-			std::swap(color.red, color.blue);
-			break;
-		case ORDER_RBG:
-			std::swap(color.green, color.blue);
-			break;
-		case ORDER_GRB:
-			std::swap(color.red, color.green);
-			break;
-		case ORDER_GBR:
-			std::swap(color.red, color.green);
-			std::swap(color.green, color.blue);
-			break;
-
-		case ORDER_BRG:
-			std::swap(color.red, color.blue);
-			std::swap(color.green, color.blue);
-			break;
-		}
-		i++;
-	}
+	config->adjustment->applyAdjustment(_ledBuffer);
 
-	// fill additional hw leds with black
-	if ( _hwLedCount > _ledBuffer.size() )
-	{
-		_ledBuffer.resize(_hwLedCount, ColorRgb::BLACK);
-	}
+	// insert cloned leds, correct the color byte order and fill additional hw leds with black in one pass
+	config->remap.apply(_ledBuffer, _outputBuffer);
+	_ledBuffer.swap(_outputBuffer);
 
 	// Write the data to the device
 	if (_ledDeviceWrapper->enabled())
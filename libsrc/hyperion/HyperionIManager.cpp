@@ -2,8 +2,12 @@
 
 // hyperion
 #include <hyperion/Hyperion.h>
+#include <hyperion/SettingsManager.h>
 #include <db/InstanceTable.h>
 
+// utils
+#include <utils/ThreadScheduler.h>
+
 // qt
 #include <QThread>
 
@@ -67,6 +71,7 @@ bool HyperionIManager::startInstance(const quint8& inst, const bool& block)
 			Hyperion* hyperion = new Hyperion(inst);
 			hyperion->moveToThread(hyperionThread);
 			// setup thread management
+			ThreadScheduler::manageThread(hyperionThread, ThreadScheduler::INSTANCE);
 			connect(hyperionThread, &QThread::started, hyperion, &Hyperion::start);
 			connect(hyperion, &Hyperion::started, this, &HyperionIManager::handleStarted);
 			connect(hyperion, &Hyperion::finished, this, &HyperionIManager::handleFinished);
@@ -156,6 +161,7 @@ bool HyperionIManager::deleteInstance(const quint8& inst)
 
 	if(_instanceTable->deleteInstance(inst))
 	{
+		SettingsManager::clearInstanceCache(inst);
 		Info(_log,"Hyperion instance with index '%d' has been deleted", inst);
 		emit instanceStateChanged(H_DELETED, inst);
 		emit change();
@@ -1,4 +1,7 @@
 
+// STL includes
+#include <algorithm>
+
 // Hyperion includes
 #include <hyperion/Hyperion.h>
 #include <hyperion/ImageProcessor.h>
@@ -7,8 +10,24 @@
 // Blacborder includes
 #include <blackborder/BlackBorderProcessor.h>
 
+// Utils includes
+#include <utils/ColorBgr.h>
+#include <utils/ColorRgba.h>
+
 using namespace hyperion;
 
+namespace {
+
+/// A view on the cropped region of a packed RGB frame, nothing is copied
+template <typename Pixel_T>
+ImageView<Pixel_T> regionView(const RawImage& raw)
+{
+	const ImageView<Pixel_T> frame(reinterpret_cast<const Pixel_T*>(raw.data), unsigned(raw.width), unsigned(raw.height), size_t(raw.lineLength));
+	return frame.crop(unsigned(raw.cropLeft), unsigned(raw.cropTop), unsigned(raw.regionWidth()), unsigned(raw.regionHeight()));
+}
+
+}
+
 // global transform method
 int ImageProcessor::mappingTypeToInt(QString mappingType)
 {
@@ -30,8 +49,12 @@ ImageProcessor::ImageProcessor(const LedString& ledString, Hyperion* hyperion)
 	: QObject(hyperion)
 	, _log(Logger::getInstance("BLACKBORDER"))
 	, _ledString(ledString)
+	, _maxSamplesPerLed(0)
+	, _appliedMaxSamplesPerLed(0)
 	, _borderProcessor(new BlackBorderProcessor(hyperion, this))
+	, _ledsMapCache()
 	, _imageToLeds(nullptr)
+	, _rawToLeds(nullptr)
 	, _mappingType(0)
 	, _userMappingType(0)
 	, _hardMappingType(0)
@@ -45,7 +68,6 @@ ImageProcessor::ImageProcessor(const LedString& ledString, Hyperion* hyperion)
 
 ImageProcessor::~ImageProcessor()
 {
-	delete _imageToLeds;
 }
 
 void ImageProcessor::handleSettingsUpdate(const settings::type& type, const QJsonDocument& config)
@@ -58,6 +80,13 @@ void ImageProcessor::handleSettingsUpdate(const settings::type& type, const QJso
 		{
 			setLedMappingType(newType);
 		}
+
+		// the mappings are rebuilt by the next process() call
+		const unsigned maxSamplesPerLed = unsigned(obj["maxSamplesPerLed"].toInt(0));
+		if (_maxSamplesPerLed.exchange(maxSamplesPerLed) != maxSamplesPerLed)
+		{
+			Debug(_log, "set max samples per led to %u", maxSamplesPerLed);
+		}
 	}
 }
 
@@ -69,26 +98,114 @@ void ImageProcessor::setSize(const unsigned width, const unsigned height)
 		return;
 	}
 
-	// Clean up the old buffer and mapping
-	_imageToLeds = 0;
-
-	// Construct a new buffer and mapping
-	_imageToLeds = (width>0 && height>0) ? (new ImageToLedsMap(width, height, 0, 0, _ledString.leds())) : nullptr;
+	// Take the mapping of the new size
+	_imageToLeds = (width>0 && height>0) ? getLedsMap(width, height, 0, 0) : nullptr;
 }
 
 void ImageProcessor::setLedString(const LedString& ledString)
 {
-	_ledString = ledString;
+	// the mapping is rebuilt by the next process() call, so a reconfiguration never waits for a running frame
+	std::atomic_store(&_pendingLedString, std::shared_ptr<const LedString>(new LedString(ledString)));
+}
+
+void ImageProcessor::applyLedString()
+{
+	const std::shared_ptr<const LedString> ledString = std::atomic_exchange(&_pendingLedString, std::shared_ptr<const LedString>());
+	const unsigned maxSamplesPerLed = _maxSamplesPerLed.load();
+	if (ledString == nullptr && maxSamplesPerLed == _appliedMaxSamplesPerLed)
+	{
+		return;
+	}
+
+	if (ledString != nullptr)
+	{
+		_ledString = *ledString;
+	}
+	_appliedMaxSamplesPerLed = maxSamplesPerLed;
+
+	// the current mapping is owned by the cache, so its size is taken before the cache is cleared
+	const bool hasMapping = (_imageToLeds != nullptr);
+	const unsigned width  = hasMapping ? _imageToLeds->width() : 0;
+	const unsigned height = hasMapping ? _imageToLeds->height() : 0;
+
+	// the cached mappings belong to the old led string
+	_imageToLeds = nullptr;
+	_rawToLeds = nullptr;
+	_ledsMapCache.clear();
+
+	if (hasMapping)
+	{
+		// Construct a new mapping with the current width/height
+		_imageToLeds = getLedsMap(width, height, 0, 0);
+	}
+}
+
+ImageToLedsMap* ImageProcessor::getLedsMap(const unsigned width, const unsigned height, const unsigned horizontalBorder, const unsigned verticalBorder, const bool indexed)
+{
+	for (auto entry = _ledsMapCache.begin(); entry != _ledsMapCache.end(); ++entry)
+	{
+		const ImageToLedsMap& map = **entry;
+		if (map.width() == width && map.height() == height && map.isIndexed() == indexed
+			&& map.horizontalBorder() == horizontalBorder && map.verticalBorder() == verticalBorder)
+		{
+			// move it to the front
+			std::rotate(_ledsMapCache.begin(), entry, entry + 1);
+			return _ledsMapCache.front().get();
+		}
+	}
+
+	// keep the mappings in use, the least recently used other one is dropped
+	if (_ledsMapCache.size() >= LEDS_MAP_CACHE_SIZE)
+	{
+		for (auto entry = _ledsMapCache.end(); entry != _ledsMapCache.begin(); --entry)
+		{
+			ImageToLedsMap* map = (entry - 1)->get();
+			if (map != _imageToLeds && map != _rawToLeds)
+			{
+				_ledsMapCache.erase(entry - 1);
+				break;
+			}
+		}
+	}
+
+	_ledsMapCache.emplace(_ledsMapCache.begin(), new ImageToLedsMap(width, height, horizontalBorder, verticalBorder, _ledString.leds(), indexed, _appliedMaxSamplesPerLed));
+	return _ledsMapCache.front().get();
+}
+
+void ImageProcessor::processRaw(const RawImage& raw, std::vector<ColorRgb>& ledColors)
+{
+	if (!raw.isValid() || !RawImage::isMappable(raw.pixelFormat))
+	{
+		Warning(_log, "Called with an invalid raw frame");
+		return;
+	}
 
-	// get current width/height
-	const unsigned width = _imageToLeds->width();
-	const unsigned height = _imageToLeds->height();
+	// Apply a changed led string
+	applyLedString();
+	ledColors.resize(_ledString.leds().size());
 
-	// Clean up the old buffer and mapping
-	_imageToLeds = 0;
+	// packed RGB is processed in place like an image, including the black border detection
+	switch (raw.pixelFormat)
+	{
+		case PIXELFORMAT_RGB24: process(regionView<ColorRgb>(raw), ledColors); return;
+		case PIXELFORMAT_BGR24: process(regionView<ColorBgr>(raw), ledColors); return;
+		case PIXELFORMAT_RGB32: process(regionView<ColorRgba>(raw), ledColors); return;
+		default: break;
+	}
+
+	// the map is built on the sampled grid, so it's the same as for the converted image
+	const unsigned width  = unsigned(raw.sampledWidth());
+	const unsigned height = unsigned(raw.sampledHeight());
+	if (_rawToLeds == nullptr || _rawToLeds->width() != width || _rawToLeds->height() != height)
+	{
+		_rawToLeds = getLedsMap(width, height, 0, 0, false);
+	}
 
-	// Construct a new buffer and mapping
-	_imageToLeds = new ImageToLedsMap(width, height, 0, 0, _ledString.leds());
+	switch (_mappingType)
+	{
+		case 1: _rawToLeds->getUniLedColor(raw, ledColors); break;
+		default: _rawToLeds->getMeanLedColor(raw, ledColors);
+	}
 }
 
 void ImageProcessor::setBlackbarDetectDisable(bool enable)
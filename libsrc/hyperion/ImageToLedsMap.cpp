@@ -1,18 +1,205 @@
 #include <hyperion/ImageToLedsMap.h>
 
+// STL includes
+#include <cmath>
+#include <random>
+
+// utils includes
+#include <utils/ImageResampler.h>
+
 using namespace hyperion;
 
+namespace {
+
+/// The channel sums of a led area
+struct YuvSum
+{
+	uint32_t y = 0;
+	uint32_t u = 0;
+	uint32_t v = 0;
+	uint32_t count = 0;
+};
+
+/// YUYV and UYVY, two pixels share the chroma of a four byte group
+struct PackedReader
+{
+	struct Row
+	{
+		const uint8_t* data;
+	};
+
+	const RawImage & raw;
+	const int lumaOffset;
+	const int uOffset;
+	const int vOffset;
+
+	Row row(const int ySource) const
+	{
+		return { raw.data + raw.lineLength * ySource };
+	}
+
+	void operator()(const Row & row, const unsigned xSource, YuvSum & sum) const
+	{
+		const uint8_t* group = row.data + ((xSource & ~1u) << 1);
+		sum.y += row.data[(xSource << 1) + lumaOffset];
+		sum.u += group[uOffset];
+		sum.v += group[vOffset];
+	}
+};
+
+/// NV12 and NV21, one interleaved chroma plane with half the rows
+struct SemiPlanarReader
+{
+	struct Row
+	{
+		const uint8_t* luma;
+		const uint8_t* chroma;
+	};
+
+	const RawImage & raw;
+	const int uOffset;
+	const int vOffset;
+
+	Row row(const int ySource) const
+	{
+		return { raw.data + raw.lineLength * ySource, raw.data + raw.lineLength * (raw.height + (ySource >> 1)) };
+	}
+
+	void operator()(const Row & row, const unsigned xSource, YuvSum & sum) const
+	{
+		const uint8_t* chroma = row.chroma + (xSource & ~1u);
+		sum.y += row.luma[xSource];
+		sum.u += chroma[uOffset];
+		sum.v += chroma[vOffset];
+	}
+};
+
+/// I420 and YV12, two chroma planes with half the rows and columns
+struct PlanarReader
+{
+	struct Row
+	{
+		const uint8_t* luma;
+		const uint8_t* u;
+		const uint8_t* v;
+	};
+
+	PlanarReader(const RawImage & raw, const bool vFirst)
+		: raw(raw)
+		, chromaLineLength(raw.lineLength >> 1)
+		, uPlane(raw.data + raw.lineLength * raw.height + (vFirst ? chromaLineLength * (raw.height >> 1) : 0))
+		, vPlane(raw.data + raw.lineLength * raw.height + (vFirst ? 0 : chromaLineLength * (raw.height >> 1)))
+	{
+	}
+
+	const RawImage & raw;
+	const int chromaLineLength;
+	const uint8_t* const uPlane;
+	const uint8_t* const vPlane;
+
+	Row row(const int ySource) const
+	{
+		const int chromaRow = chromaLineLength * (ySource >> 1);
+		return { raw.data + raw.lineLength * ySource, uPlane + chromaRow, vPlane + chromaRow };
+	}
+
+	void operator()(const Row & row, const unsigned xSource, YuvSum & sum) const
+	{
+		sum.y += row.luma[xSource];
+		sum.u += row.u[xSource >> 1];
+		sum.v += row.v[xSource >> 1];
+	}
+};
+
+///
+/// Sum the pixels of a led on the sampled grid of the frame, every pixel of the area or just the samples.
+/// The plane and row pointers are computed once per row, the reader just adds the pixel at a column of that row
+///
+template <typename Reader>
+void sumLed(const RawImage & raw, const ImageToLedsMap::LedArea & area, const std::vector<ImageToLedsMap::LedSample> & samples, const Reader & read, YuvSum & sum)
+{
+	if (!samples.empty())
+	{
+		// the samples are ordered by rows, so the row only changes a few times
+		int ySource = raw.sourceY(samples.front().y);
+		typename Reader::Row row = read.row(ySource);
+		for (const ImageToLedsMap::LedSample& sample : samples)
+		{
+			const int ySample = raw.sourceY(sample.y);
+			if (ySample != ySource)
+			{
+				ySource = ySample;
+				row = read.row(ySource);
+			}
+			read(row, unsigned(raw.sourceX(sample.x)), sum);
+		}
+		sum.count += uint32_t(samples.size());
+		return;
+	}
+
+	for (unsigned y = area.minY; y < area.maxY; ++y)
+	{
+		const typename Reader::Row row = read.row(raw.sourceY(int(y)));
+		for (unsigned x = area.minX; x < area.maxX; ++x)
+		{
+			read(row, unsigned(raw.sourceX(int(x))), sum);
+		}
+	}
+	sum.count += (area.maxX - area.minX) * (area.maxY - area.minY);
+}
+
+///
+/// Pick a stratified subset of an area: the area is divided into a grid of cells with about the aspect ratio of the area
+/// and one jittered pixel is taken from each cell. The generator is seeded per led, so a map is the same on every rebuild
+///
+std::vector<ImageToLedsMap::LedSample> stratifiedSamples(const ImageToLedsMap::LedArea & area, const unsigned maxSamples, const unsigned seed)
+{
+	const unsigned areaWidth  = area.maxX - area.minX;
+	const unsigned areaHeight = area.maxY - area.minY;
+
+	unsigned columns = unsigned(qRound(std::sqrt(double(maxSamples) * areaWidth / areaHeight)));
+	columns = std::max(1u, std::min(columns, areaWidth));
+	const unsigned rows = std::max(1u, std::min(maxSamples / columns, areaHeight));
+	columns = std::max(1u, std::min(maxSamples / rows, areaWidth));
+
+	std::minstd_rand random(seed + 1);
+	std::vector<ImageToLedsMap::LedSample> samples;
+	samples.reserve(size_t(columns) * rows);
+
+	for (unsigned row = 0; row < rows; ++row)
+	{
+		const unsigned cellTop    = area.minY + row * areaHeight / rows;
+		const unsigned cellHeight = area.minY + (row + 1) * areaHeight / rows - cellTop;
+		for (unsigned column = 0; column < columns; ++column)
+		{
+			const unsigned cellLeft  = area.minX + column * areaWidth / columns;
+			const unsigned cellWidth = area.minX + (column + 1) * areaWidth / columns - cellLeft;
+			samples.push_back({uint16_t(cellLeft + random() % cellWidth), uint16_t(cellTop + random() % cellHeight)});
+		}
+	}
+
+	return samples;
+}
+
+}
+
 ImageToLedsMap::ImageToLedsMap(
 		const unsigned width,
 		const unsigned height,
 		const unsigned horizontalBorder,
 		const unsigned verticalBorder,
-		const std::vector<Led>& leds)
+		const std::vector<Led>& leds,
+		const bool indexed,
+		const unsigned maxSamplesPerLed)
 	: _width(width)
 	, _height(height)
 	, _horizontalBorder(horizontalBorder)
 	, _verticalBorder(verticalBorder)
+	, _maxSamplesPerLed(maxSamplesPerLed)
+	, _indexed(indexed)
 	, _colorsMap()
+	, _ledAreas()
+	, _ledSamples(leds.size())
 {
 	// Sanity check of the size of the borders (and width and height)
 	Q_ASSERT(_width  > 2*_verticalBorder);
@@ -21,7 +208,9 @@ ImageToLedsMap::ImageToLedsMap(
 	Q_ASSERT(_height < 10000);
 
 	// Reserve enough space in the map for the leds
-	_colorsMap.reserve(leds.size());
+	if (indexed)
+		_colorsMap.reserve(leds.size());
+	_ledAreas.reserve(leds.size());
 
 	const unsigned xOffset      = _verticalBorder;
 	const unsigned actualWidth  = _width  - 2 * _verticalBorder;
@@ -33,7 +222,9 @@ ImageToLedsMap::ImageToLedsMap(
 		// skip leds without area
 		if ((led.maxX_frac-led.minX_frac) < 1e-6 || (led.maxY_frac-led.minY_frac) < 1e-6)
 		{
-			_colorsMap.emplace_back();
+			if (indexed)
+				_colorsMap.emplace_back();
+			_ledAreas.push_back({0, 0, 0, 0});
 			continue;
 		}
 
@@ -59,6 +250,22 @@ ImageToLedsMap::ImageToLedsMap(
 		const auto maxYLedCount = qMin(maxY_idx, yOffset+actualHeight);
 		const auto maxXLedCount = qMin(maxX_idx, xOffset+actualWidth);
 
+		_ledAreas.push_back({minX_idx, maxXLedCount, minY_idx, maxYLedCount});
+
+		// large areas are represented by a bounded number of samples, independent of the image size
+		if (_maxSamplesPerLed > 0 && (maxXLedCount - minX_idx) * (maxYLedCount - minY_idx) > _maxSamplesPerLed)
+		{
+			_ledSamples[_ledAreas.size() - 1] = stratifiedSamples(_ledAreas.back(), _maxSamplesPerLed, unsigned(_ledAreas.size() - 1));
+			if (indexed)
+				_colorsMap.emplace_back();
+			continue;
+		}
+
+		if (!indexed)
+		{
+			continue;
+		}
+
 		std::vector<unsigned> ledColors;
 		ledColors.reserve((size_t) maxXLedCount*maxYLedCount);
 
@@ -84,3 +291,54 @@ unsigned ImageToLedsMap::height() const
 {
 	return _height;
 }
+
+void ImageToLedsMap::getMeanLedColor(const RawImage & raw, std::vector<ColorRgb> & ledColors) const
+{
+	if(_ledAreas.size() != ledColors.size())
+	{
+		Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: ledAreas.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
+		return;
+	}
+
+	for (size_t led = 0; led < ledColors.size(); ++led)
+	{
+		ledColors[led] = calcMeanColor(raw, _ledAreas[led], _ledSamples[led]);
+	}
+}
+
+void ImageToLedsMap::getUniLedColor(const RawImage & raw, std::vector<ColorRgb> & ledColors) const
+{
+	if(_ledAreas.size() != ledColors.size())
+	{
+		Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: ledAreas.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
+		return;
+	}
+
+	const ColorRgb color = calcMeanColor(raw, LedArea{0, _width, 0, _height});
+	std::fill(ledColors.begin(), ledColors.end(), color);
+}
+
+ColorRgb ImageToLedsMap::calcMeanColor(const RawImage & raw, const LedArea & area, const std::vector<LedSample> & samples) const
+{
+	YuvSum sum;
+	switch (raw.pixelFormat)
+	{
+		case PIXELFORMAT_YUYV: sumLed(raw, area, samples, PackedReader{raw, 0, 1, 3}, sum); break;
+		case PIXELFORMAT_UYVY: sumLed(raw, area, samples, PackedReader{raw, 1, 0, 2}, sum); break;
+		case PIXELFORMAT_NV12: sumLed(raw, area, samples, SemiPlanarReader{raw, 0, 1}, sum); break;
+		case PIXELFORMAT_NV21: sumLed(raw, area, samples, SemiPlanarReader{raw, 1, 0}, sum); break;
+		case PIXELFORMAT_I420: sumLed(raw, area, samples, PlanarReader{raw, false}, sum); break;
+		case PIXELFORMAT_YV12: sumLed(raw, area, samples, PlanarReader{raw, true}, sum); break;
+		default: break;
+	}
+
+	if (sum.count == 0)
+	{
+		return ColorRgb::BLACK;
+	}
+
+	// the conversion is affine, so converting the averages gives the average of the converted pixels (apart from clamping)
+	ColorRgb color;
+	ImageResampler::yuv2rgb(uint8_t(sum.y / sum.count), uint8_t(sum.u / sum.count), uint8_t(sum.v / sum.count), color.red, color.green, color.blue);
+	return color;
+}
@@ -0,0 +1,159 @@
+// STL includes
+#include <algorithm>
+
+// Hyperion includes
+#include <hyperion/LedRemap.h>
+
+namespace
+{
+	/// The input channel of each output channel per color order, in the order of the ColorOrder enum
+	const uint8_t PERMUTATIONS[6][3] =
+	{
+		{ 0, 1, 2 }, // ORDER_RGB
+		{ 0, 2, 1 }, // ORDER_RBG
+		{ 1, 0, 2 }, // ORDER_GRB
+		{ 2, 0, 1 }, // ORDER_BRG
+		{ 1, 2, 0 }, // ORDER_GBR
+		{ 2, 1, 0 }  // ORDER_BGR
+	};
+
+	inline uint8_t channel(const ColorRgb& color, const uint8_t index)
+	{
+		return index == 0 ? color.red : (index == 1 ? color.green : color.blue);
+	}
+
+	template <ColorOrder ORDER>
+	inline ColorRgb reorder(const ColorRgb& color)
+	{
+		// the permutation is known at compile time, so this folds to plain byte moves
+		return ColorRgb{
+			channel(color, PERMUTATIONS[ORDER][0]),
+			channel(color, PERMUTATIONS[ORDER][1]),
+			channel(color, PERMUTATIONS[ORDER][2])};
+	}
+}
+
+const uint32_t LedRemap::NO_SOURCE;
+
+LedRemap::LedRemap()
+	: _sources()
+	, _orders()
+	, _order(ORDER_RGB)
+{
+}
+
+LedRemap::LedRemap(const LedString& ledString, const LedString& ledStringClone, unsigned hwLedCount)
+	: _sources()
+	, _orders()
+	, _order(ORDER_RGB)
+{
+	const std::vector<Led>& leds = ledString.leds();
+
+	std::vector<ColorOrder> orders;
+	for (uint32_t i = 0; i < leds.size(); ++i)
+	{
+		_sources.push_back(i);
+		orders.push_back(leds[i].colorOrder);
+	}
+
+	// the clones are inserted one after another, so an index refers to the buffer including the previous clones
+	for (const Led& led : ledStringClone.leds())
+	{
+		const size_t index = std::min(size_t(led.index), _sources.size());
+		const uint32_t source = (led.clone >= 0 && size_t(led.clone) < _sources.size()) ? _sources[led.clone] : NO_SOURCE;
+		_sources.insert(_sources.begin() + index, source);
+		orders.insert(orders.begin() + index, led.colorOrder);
+	}
+
+	// fill additional hw leds with black
+	if (hwLedCount > _sources.size())
+	{
+		_sources.resize(hwLedCount, NO_SOURCE);
+		orders.resize(hwLedCount, ORDER_RGB);
+	}
+
+	// the order of black leds doesn't matter, so they don't prevent the uniform case
+	bool uniform = true;
+	bool found = false;
+	for (size_t i = 0; i < orders.size(); ++i)
+	{
+		if (_sources[i] == NO_SOURCE)
+		{
+			continue;
+		}
+
+		if (!found)
+		{
+			_order = orders[i];
+			found = true;
+		}
+		else if (orders[i] != _order)
+		{
+			uniform = false;
+			break;
+		}
+	}
+
+	if (!uniform)
+	{
+		_orders.swap(orders);
+	}
+}
+
+void LedRemap::apply(const std::vector<ColorRgb>& ledColors, std::vector<ColorRgb>& output) const
+{
+	// an unconfigured remap passes the leds through
+	if (_sources.empty())
+	{
+		output = ledColors;
+		return;
+	}
+
+	output.resize(_sources.size());
+
+	if (_orders.empty())
+	{
+		switch (_order)
+		{
+		case ORDER_RGB: gather<ORDER_RGB>(ledColors, output); break;
+		case ORDER_RBG: gather<ORDER_RBG>(ledColors, output); break;
+		case ORDER_GRB: gather<ORDER_GRB>(ledColors, output); break;
+		case ORDER_BRG: gather<ORDER_BRG>(ledColors, output); break;
+		case ORDER_GBR: gather<ORDER_GBR>(ledColors, output); break;
+		case ORDER_BGR: gather<ORDER_BGR>(ledColors, output); break;
+		}
+		return;
+	}
+
+	const size_t count = ledColors.size();
+	for (size_t i = 0; i < _sources.size(); ++i)
+	{
+		const uint32_t source = _sources[i];
+		if (source < count)
+		{
+			const uint8_t* permutation = PERMUTATIONS[_orders[i]];
+			const ColorRgb& color = ledColors[source];
+			output[i] = ColorRgb{channel(color, permutation[0]), channel(color, permutation[1]), channel(color, permutation[2])};
+		}
+		else
+		{
+			output[i] = ColorRgb::BLACK;
+		}
+	}
+}
+
+template <ColorOrder ORDER>
+void LedRemap::gather(const std::vector<ColorRgb>& ledColors, std::vector<ColorRgb>& output) const
+{
+	const uint32_t* sources = _sources.data();
+	const ColorRgb* colors = ledColors.data();
+	ColorRgb* out = output.data();
+	const size_t outputCount = _sources.size();
+	const size_t count = ledColors.size();
+	const ColorRgb black = ColorRgb::BLACK;
+
+	for (size_t i = 0; i < outputCount; ++i)
+	{
+		out[i] = sources[i] < count ? reorder<ORDER>(colors[sources[i]]) : black;
+	}
+}
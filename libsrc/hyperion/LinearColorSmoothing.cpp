@@ -20,6 +20,7 @@ LinearColorSmoothing::LinearColorSmoothing(const QJsonDocument& config, Hyperion
 	, _writeToLedsEnable(true)
 	, _continuousOutput(false)
 	, _pause(false)
+	, _externalClock(false)
 	, _currentConfigId(0)
 {
 	// set initial state to true, as LedDevice::enabled() is true by default
@@ -72,7 +73,8 @@ int LinearColorSmoothing::write(const std::vector<ColorRgb> &ledValues)
 
 		_previousTime = QDateTime::currentMSecsSinceEpoch();
 		_previousValues = ledValues;
-		_timer->start();
+		if (!_externalClock)
+			_timer->start();
 	}
 	else
 	{
@@ -221,7 +223,8 @@ bool LinearColorSmoothing::selectConfig(unsigned cfg, const bool& force)
 			_timer->stop();
 			_updateInterval = _cfgList[cfg].updateInterval;
 			_timer->setInterval(_updateInterval);
-			_timer->start();
+			if (!_externalClock)
+				_timer->start();
 		}
 		_currentConfigId = cfg;
 		//DebugIf( enabled() && !_pause, _log, "set smoothing cfg: %d, interval: %d ms, settlingTime: %d ms, updateDelay: %d frames",  _currentConfigId, _updateInterval, _settlingTime,  _outputDelay );
@@ -234,3 +237,20 @@ bool LinearColorSmoothing::selectConfig(unsigned cfg, const bool& force)
 	_currentConfigId = 0;
 	return false;
 }
+
+void LinearColorSmoothing::setExternalClock(const bool& external)
+{
+	_externalClock = external;
+
+	if (_externalClock)
+		_timer->stop();
+	else if (!_previousValues.empty())
+		_timer->start();
+}
+
+void LinearColorSmoothing::clockTick()
+{
+	// nothing to step until the first values arrived
+	if (_externalClock && !_previousValues.empty())
+		updateLeds();
+}
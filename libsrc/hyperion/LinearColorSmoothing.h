@@ -69,6 +69,17 @@ public:
 	///
 	bool selectConfig(unsigned cfg, const bool& force = false);
 
+	///
+	/// @brief Let the output clock of the instance step the smoothing instead of the own timer
+	/// @param external  True to stop the own timer and wait for clockTick()
+	///
+	void setExternalClock(const bool& external);
+
+	///
+	/// @brief Step the smoothing once, called by the output clock when set external
+	///
+	void clockTick();
+
 public slots:
 	///
 	/// @brief Handle settings update from Hyperion Settingsmanager emit or this constructor
@@ -137,6 +148,9 @@ private:
 	/// Flag for pausing
 	bool _pause;
 
+	/// The smoothing is stepped by the output clock of the instance
+	bool _externalClock;
+
 	struct SMOOTHING_CFG
 	{
 		bool     pause;
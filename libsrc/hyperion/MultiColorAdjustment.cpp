@@ -1,3 +1,6 @@
+// STL includes
+#include <algorithm>
+
 // Hyperion includes
 #include <utils/Logger.h>
 #include <hyperion/MultiColorAdjustment.h>
@@ -8,6 +11,27 @@ MultiColorAdjustment::MultiColorAdjustment(const unsigned ledCnt)
 {
 }
 
+MultiColorAdjustment::MultiColorAdjustment(const MultiColorAdjustment& other)
+	: _adjustmentIds(other._adjustmentIds)
+	, _ledAdjustments(other._ledAdjustments.size(), nullptr)
+	, _log(other._log)
+{
+	for (const ColorAdjustment * adjustment : other._adjustment)
+	{
+		_adjustment.push_back(new ColorAdjustment(*adjustment));
+	}
+
+	// assign the copies to the same leds
+	for (size_t iLed=0; iLed<other._ledAdjustments.size(); ++iLed)
+	{
+		const auto it = std::find(other._adjustment.begin(), other._adjustment.end(), other._ledAdjustments[iLed]);
+		if (it != other._adjustment.end())
+		{
+			_ledAdjustments[iLed] = _adjustment[it - other._adjustment.begin()];
+		}
+	}
+}
+
 MultiColorAdjustment::~MultiColorAdjustment()
 {
 	// Clean up all the transforms
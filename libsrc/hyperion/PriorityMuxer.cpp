@@ -185,6 +185,8 @@ bool PriorityMuxer::setInput(const int priority, const std::vector<ColorRgb>& le
 	// update input
 	input.timeoutTime_ms = timeout_ms;
 	input.ledColors      = ledColors;
+	// an image of a previous setInputImage() call would take precedence
+	input.image.resize(0, 0);
 
 	// emit active change
 	if(activeChange)
@@ -0,0 +1,138 @@
+// Qt includes
+#include <QTimer>
+
+#include "RenderLoop.h"
+#include "LinearColorSmoothing.h"
+#include <hyperion/Hyperion.h>
+#include <hyperion/HyperionIManager.h>
+
+RenderLoop::RenderLoop(const QJsonDocument& config, Hyperion* hyperion, LinearColorSmoothing* smoothing)
+	: QObject(hyperion)
+	, _log(Logger::getInstance("HYPERION"))
+	, _hyperion(hyperion)
+	, _smoothing(smoothing)
+	, _timer(new QTimer(this))
+	, _clock(&_ownClock)
+	, _periodUs(40000)
+	, _tick(0)
+	, _enabled(false)
+	, _framePending(false)
+{
+	// every tick is scheduled for its frame boundary, the coarse timer slack would shift it
+	_timer->setTimerType(Qt::PreciseTimer);
+	_timer->setSingleShot(true);
+	connect(_timer, &QTimer::timeout, this, &RenderLoop::handleTick);
+
+	handleSettingsUpdate(settings::OUTPUT, config);
+}
+
+RenderLoop::~RenderLoop()
+{
+	setFrameLock(false);
+}
+
+void RenderLoop::handleSettingsUpdate(const settings::type& type, const QJsonDocument& config)
+{
+	if(type == settings::OUTPUT)
+	{
+		const QJsonObject obj = config.object();
+		_periodUs = qMax(int64_t(1000), int64_t(1000000.0/obj["frequency"].toDouble(25.0)));
+		const bool wasEnabled = _enabled;
+		setFrameLock(obj["frameLock"].toBool(false));
+		setEnable(obj["renderLoop"].toBool(false));
+
+		// the period or the clock of the running loop might have been changed
+		if (wasEnabled && _enabled)
+		{
+			_tick = _clock->elapsedUs() / _periodUs;
+			scheduleTick();
+		}
+	}
+}
+
+bool RenderLoop::requestFrame()
+{
+	if (!_enabled)
+		return false;
+
+	_framePending = true;
+	return true;
+}
+
+void RenderLoop::setEnable(const bool& enable)
+{
+	if (_enabled == enable)
+		return;
+
+	_enabled = enable;
+	_smoothing->setExternalClock(enable);
+
+	if (enable)
+	{
+		_framePending = true;
+		_tick = _clock->elapsedUs() / _periodUs;
+		scheduleTick();
+	}
+	else
+	{
+		_timer->stop();
+		// don't lose the last input, it was waiting for the next tick
+		if (_framePending.exchange(false))
+			_hyperion->update();
+	}
+
+	if (enable)
+	{
+		Info(_log, "Render loop enabled, output interval %.1f ms%s", _periodUs / 1000.0, (_clock != &_ownClock) ? ", frame locked" : "");
+	}
+	else
+	{
+		Info(_log, "Render loop disabled");
+	}
+}
+
+void RenderLoop::setFrameLock(const bool& frameLock)
+{
+	OutputClock* clock = &_ownClock;
+	if (frameLock && HyperionIManager::getInstance() != nullptr)
+		clock = HyperionIManager::getInstance()->getOutputClock();
+
+	if (clock == _clock)
+		return;
+
+	if (_clock != &_ownClock)
+	{
+		Debug(_log, "Left the shared output clock, %d instances remaining", _clock->leave());
+	}
+
+	_clock = clock;
+
+	if (_clock != &_ownClock)
+	{
+		Debug(_log, "Joined the shared output clock, %d instances frame locked", _clock->join());
+	}
+}
+
+void RenderLoop::scheduleTick()
+{
+	const int64_t now = _clock->elapsedUs();
+
+	// the next boundary, a tick which fired a bit early still counts as the one it was scheduled for
+	_tick++;
+	if (_tick * _periodUs < now)
+		_tick = now / _periodUs + 1;
+
+	_timer->start(int((_tick * _periodUs - now + 500) / 1000));
+}
+
+void RenderLoop::handleTick()
+{
+	// all inputs since the last tick are covered by one render of the newest
+	if (_framePending.exchange(false))
+		_hyperion->render();
+
+	_smoothing->clockTick();
+
+	if (_enabled)
+		scheduleTick();
+}
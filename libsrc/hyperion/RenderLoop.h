@@ -0,0 +1,107 @@
+#pragma once
+
+// stl
+#include <atomic>
+
+// qt
+#include <QObject>
+#include <QJsonDocument>
+
+// settings
+#include <utils/settings.h>
+
+// hyperion
+#include <hyperion/OutputClock.h>
+
+class QTimer;
+class Logger;
+class Hyperion;
+class LinearColorSmoothing;
+
+///
+/// @brief Output clock of a Hyperion instance. When enabled, new inputs just mark the instance dirty and the clock
+/// renders the newest input once per output period, so the processing follows the output rate instead of the input rate.
+/// The smoothing is stepped by the same clock instead of its own timer.
+/// With frame lock enabled the ticks follow the output clock shared by all instances, see HyperionIManager::getOutputClock()
+///
+class RenderLoop : public QObject
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @param config     The "output" settings
+	/// @param hyperion   The hyperion parent instance
+	/// @param smoothing  The smoothing of the instance
+	///
+	RenderLoop(const QJsonDocument& config, Hyperion* hyperion, LinearColorSmoothing* smoothing);
+	~RenderLoop();
+
+	///
+	/// @brief Mark a new input for the next tick, may be called from any thread
+	/// @return False if the render loop is disabled and the caller should render immediately
+	///
+	bool requestFrame();
+
+	///
+	/// @brief Enable or disable the render loop. A pending frame is rendered immediately when disabled
+	/// @param enable  The new state
+	///
+	void setEnable(const bool& enable);
+
+	bool enabled() const { return _enabled; };
+
+public slots:
+	///
+	/// @brief Handle settings update from Hyperion Settingsmanager emit or this constructor
+	/// @param type   settingyType from enum
+	/// @param config configuration object
+	///
+	void handleSettingsUpdate(const settings::type& type, const QJsonDocument& config);
+
+private slots:
+	///
+	/// @brief Render the newest input if there is one and step the smoothing
+	///
+	void handleTick();
+
+private:
+	///
+	/// @brief Start the timer for the next frame boundary of the clock, boundaries which already passed are skipped
+	///
+	void scheduleTick();
+
+	///
+	/// @brief Join or leave the shared output clock
+	/// @param frameLock  True to tick with the shared clock, false for an own one
+	///
+	void setFrameLock(const bool& frameLock);
+
+	/// Logger instance
+	Logger* _log;
+
+	/// Hyperion instance
+	Hyperion* _hyperion;
+
+	/// The smoothing of the instance
+	LinearColorSmoothing* _smoothing;
+
+	/// Fires at the next tick
+	QTimer* _timer;
+
+	/// The time base of the ticks, either _ownClock or the shared clock
+	OutputClock _ownClock;
+	OutputClock* _clock;
+
+	/// output period in microseconds
+	int64_t _periodUs;
+
+	/// index of the last tick since the epoch of the clock
+	int64_t _tick;
+
+	/// render loop state, read by requestFrame() of other threads
+	std::atomic<bool> _enabled;
+
+	/// a new input arrived since the last tick
+	std::atomic<bool> _framePending;
+};
@@ -12,13 +12,42 @@
 // write config to filesystem
 #include <utils/JsonUtils.h>
 
+// qt
+#include <QTimer>
+
+// delay of the database write after a settings change, changes in between are batched
+#define WRITE_BEHIND_DELAY_MS 500
+
 QJsonObject SettingsManager::schemaJson;
+QJsonObject SettingsManager::_globalCache;
+QMap<quint8, QJsonObject> SettingsManager::_instanceCache;
+int SettingsManager::_sharedCacheRevision = 0;
+QMutex SettingsManager::_cacheMutex;
+
+namespace {
+	///
+	/// @brief Wrap a json value (object or array) as QJsonDocument
+	///
+	QJsonDocument toDocument(const QJsonValue& value)
+	{
+		if(value.isArray())
+			return QJsonDocument(value.toArray());
+		return QJsonDocument(value.toObject());
+	}
+}
 
 SettingsManager::SettingsManager(const quint8& instance, QObject* parent)
 	: QObject(parent)
 	, _log(Logger::getInstance("SettingsManager"))
+	, _instance(instance)
 	, _sTable(new SettingsTable(instance, this))
+	, _writeTimer(new QTimer(this))
+	, _cacheRevision(-1)
 {
+	_writeTimer->setSingleShot(true);
+	_writeTimer->setInterval(WRITE_BEHIND_DELAY_MS);
+	connect(_writeTimer, &QTimer::timeout, this, &SettingsManager::flushSettings);
+
 	// get schema
 	if(schemaJson.isEmpty())
 	{
@@ -54,6 +83,7 @@ SettingsManager::SettingsManager(const quint8& instance, QObject* parent)
 	}
 
 	// fill database with default data if required
+	const bool transaction = _sTable->startTransaction();
 	for(const auto key : keyList)
 	{
 		QString val = defValueList.takeFirst();
@@ -61,17 +91,30 @@ SettingsManager::SettingsManager(const quint8& instance, QObject* parent)
 		if(!_sTable->recordExist(key))
 			_sTable->createSettingsRecord(key,val);
 	}
+	if(transaction && !_sTable->commitTransaction())
+		_sTable->rollbackTransaction();
 
 	// need to validate all data in database constuct the entire data object
 	// TODO refactor schemaChecker to accept QJsonArray in validate(); QJsonDocument container? To validate them per entry...
 	QJsonObject dbConfig;
-	for(const auto key : keyList)
 	{
-		QJsonDocument doc = _sTable->getSettingsRecord(key);
-		if(doc.isArray())
-			dbConfig[key] = doc.array();
-		else
-			dbConfig[key] = doc.object();
+		QMutexLocker lock(&_cacheMutex);
+		for(const auto key : keyList)
+		{
+			// prefer the cache, changes of another SettingsManager might not be written to the database yet
+			const QJsonObject& cache = _sTable->isSettingGlobal(key) ? _globalCache : _instanceCache[_instance];
+			if(cache.contains(key))
+			{
+				dbConfig[key] = cache[key];
+				continue;
+			}
+
+			QJsonDocument doc = _sTable->getSettingsRecord(key);
+			if(doc.isArray())
+				dbConfig[key] = doc.array();
+			else
+				dbConfig[key] = doc.object();
+		}
 	}
 
 	// validate full dbconfig against schema, on error we need to rewrite entire table
@@ -94,16 +137,106 @@ SettingsManager::SettingsManager(const quint8& instance, QObject* parent)
 			Warning(_log, "Config Fix: %s", QSTRING_CSTR(schemaError));
 
 		saveSettings(dbConfig);
+		flushSettings();
 	}
 	else
-		_qconfig = dbConfig;
+	{
+		for(const auto key : keyList)
+			updateCache(key, dbConfig[key]);
+	}
+	syncSettings();
 
 	Debug(_log,"Settings database initialized")
 }
 
+SettingsManager::~SettingsManager()
+{
+	flushSettings();
+}
+
 const QJsonDocument SettingsManager::getSetting(const settings::type& type)
 {
-	return _sTable->getSettingsRecord(settings::typeToString(type));
+	const QString key = settings::typeToString(type);
+
+	QMutexLocker lock(&_cacheMutex);
+	if(_sTable->isSettingGlobal(key))
+		return toDocument(_globalCache.value(key));
+
+	return toDocument(_instanceCache[_instance].value(key));
+}
+
+const QJsonObject & SettingsManager::getSettings()
+{
+	syncSettings();
+	return _qconfig;
+}
+
+void SettingsManager::updateCache(const QString& key, const QJsonValue& value)
+{
+	QMutexLocker lock(&_cacheMutex);
+	QJsonObject& cache = _sTable->isSettingGlobal(key) ? _globalCache : _instanceCache[_instance];
+	if(cache.value(key) != value)
+	{
+		cache[key] = value;
+		_sharedCacheRevision++;
+	}
+}
+
+void SettingsManager::syncSettings()
+{
+	QMutexLocker lock(&_cacheMutex);
+	if(_cacheRevision == _sharedCacheRevision)
+		return;
+
+	const QJsonObject& instanceCache = _instanceCache[_instance];
+	for(auto it = instanceCache.constBegin(); it != instanceCache.constEnd(); ++it)
+		_qconfig[it.key()] = it.value();
+	for(auto it = _globalCache.constBegin(); it != _globalCache.constEnd(); ++it)
+		_qconfig[it.key()] = it.value();
+
+	_cacheRevision = _sharedCacheRevision;
+}
+
+void SettingsManager::flushSettings()
+{
+	QSet<QString> keys;
+	{
+		QMutexLocker lock(&_pendingMutex);
+		keys.swap(_pendingWrites);
+	}
+	if(keys.isEmpty())
+		return;
+
+	// write the newest values of the shared cache, another SettingsManager of the instance might have changed a setting
+	// after it has been queued here. So it doesn't matter which manager writes last
+	QMap<QString, QString> records;
+	{
+		QMutexLocker lock(&_cacheMutex);
+		for(const auto& key : keys)
+		{
+			const QJsonObject& cache = _sTable->isSettingGlobal(key) ? _globalCache : _instanceCache[_instance];
+			// the instance might have been deleted meanwhile
+			if(cache.contains(key))
+				records[key] = QString(toDocument(cache.value(key)).toJson(QJsonDocument::Compact));
+		}
+	}
+
+	// write all changes at once
+	const bool transaction = _sTable->startTransaction();
+	for(auto it = records.constBegin(); it != records.constEnd(); ++it)
+	{
+		if(!_sTable->createSettingsRecord(it.key(), it.value()))
+			Error(_log, "Failed to write setting '%s' to database", QSTRING_CSTR(it.key()));
+	}
+	if(transaction && !_sTable->commitTransaction())
+		_sTable->rollbackTransaction();
+}
+
+void SettingsManager::clearInstanceCache(const quint8& instance)
+{
+	QMutexLocker lock(&_cacheMutex);
+	_instanceCache.remove(instance);
+	_sharedCacheRevision++;
 }
 
 bool SettingsManager::saveSettings(QJsonObject config, const bool& correct)
@@ -125,34 +258,35 @@ bool SettingsManager::saveSettings(QJsonObject config, const bool& correct)
 			Warning(_log, "Config Fix: %s", QSTRING_CSTR(schemaError));
 	}
 
-	// store the new config
-	_qconfig = config;
+	// settings might have been changed by another SettingsManager
+	syncSettings();
 
-	// extract keys and data
-	QStringList keyList = config.keys();
-	QStringList newValueList;
-	for(const auto key : keyList)
+	// compare cached data with new data to emit/save changes accordingly
+	QStringList changedKeys;
+	for(const auto key : config.keys())
 	{
-		if(config[key].isObject())
-		{
-			newValueList << QString(QJsonDocument(config[key].toObject()).toJson(QJsonDocument::Compact));
-		}
-		else if(config[key].isArray())
-		{
-			newValueList << QString(QJsonDocument(config[key].toArray()).toJson(QJsonDocument::Compact));
-		}
+		if(_qconfig.value(key) != config.value(key))
+			changedKeys << key;
 	}
 
-	// compare database data with new data to emit/save changes accordingly
-	for(const auto key : keyList)
-	{
-		QString data = newValueList.takeFirst();
-		if(_sTable->getSettingsRecordString(key) != data)
-		{
-			_sTable->createSettingsRecord(key, data);
+	// store the new config, update the cache entirely before notifying as listeners may request other settings
+	for(const auto key : changedKeys)
+		updateCache(key, config.value(key));
+	_qconfig = config;
 
-			emit settingsChanged(settings::stringToType(key), QJsonDocument::fromJson(data.toLocal8Bit()));
-		}
+	if(!changedKeys.isEmpty())
+	{
+		QMutexLocker lock(&_pendingMutex);
+		for(const auto key : changedKeys)
+			_pendingWrites.insert(key);
 	}
+
+	for(const auto key : changedKeys)
+		emit settingsChanged(settings::stringToType(key), toDocument(config.value(key)));
+
+	// persist write behind, the timer can only be started from its own thread (e.g. JsonAPI saves from the main thread)
+	if(!changedKeys.isEmpty())
+		QMetaObject::invokeMethod(_writeTimer, "start", Qt::AutoConnection);
+
 	return true;
 }
@@ -18,6 +18,7 @@ JsonClientConnection::JsonClientConnection(QTcpSocket *socket, const bool& local
 	_jsonAPI = new JsonAPI(socket->peerAddress().toString(), _log, localConnection, this);
 	// get the callback messages from JsonAPI and send it to the client
 	connect(_jsonAPI,SIGNAL(callbackMessage(QJsonObject)),this,SLOT(sendMessage(QJsonObject)));
+	connect(_jsonAPI, &JsonAPI::callbackData, this, &JsonClientConnection::sendData);
 }
 
 void JsonClientConnection::readRequest()
@@ -27,8 +28,8 @@ void JsonClientConnection::readRequest()
 	int bytes = _receiveBuffer.indexOf('\n') + 1;
 	while(bytes > 0)
 	{
-		// create message string
-		QString message(QByteArray(_receiveBuffer.data(), bytes));
+		// the raw message, the JsonAPI decodes it
+		QByteArray message(_receiveBuffer.data(), bytes);
 
 		// remove message data from buffer
 		_receiveBuffer = _receiveBuffer.mid(bytes);
@@ -44,10 +45,13 @@ void JsonClientConnection::readRequest()
 qint64 JsonClientConnection::sendMessage(QJsonObject message)
 {
 	QJsonDocument writer(message);
-	QByteArray data = writer.toJson(QJsonDocument::Compact) + "\n";
+	return sendData(writer.toJson(QJsonDocument::Compact) + "\n");
+}
 
+qint64 JsonClientConnection::sendData(const QByteArray& data)
+{
 	if (!_socket || (_socket->state() != QAbstractSocket::ConnectedState)) return 0;
-	return _socket->write(data.data(), data.size());
+	return _socket->write(data.constData(), data.size());
 }
 
 void JsonClientConnection::disconnected(void)
@@ -31,6 +31,12 @@ signals:
 public slots:
 	qint64 sendMessage(QJsonObject);
 
+	///
+	/// Send a serialized message
+	/// @param data The message, terminated by a newline
+	///
+	qint64 sendData(const QByteArray& data);
+
 private slots:
 	///
 	/// Slot called when new data has arrived
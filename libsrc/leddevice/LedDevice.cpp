@@ -5,7 +5,6 @@
 #include <QResource>
 #include <QStringList>
 #include <QDir>
-#include <QDateTime>
 
 #include "hyperion/Hyperion.h"
 #include <utils/JsonUtils.h>
@@ -18,19 +17,30 @@ LedDevice::LedDevice(const QJsonObject& config, QObject* parent)
 	, _deviceReady(true)
 	, _refresh_timer()
 	, _refresh_timer_interval(0)
-	, _last_write_time(QDateTime::currentMSecsSinceEpoch())
+	, _lastWriteTimer()
 	, _latchTime_ms(0)
+	, _latchTimer(new QTimer(this))
+	, _latchPending(false)
+	, _coalescedFrames(0)
 	, _componentRegistered(false)
 	, _enabled(true)
 {
 	// setup timer
 	_refresh_timer.setInterval(0);
 	connect(&_refresh_timer, SIGNAL(timeout()), this, SLOT(rewriteLeds()));
+
+	// the pending frame should be written right when the latch time expired
+	_latchTimer->setSingleShot(true);
+	_latchTimer->setTimerType(Qt::PreciseTimer);
+	connect(_latchTimer, &QTimer::timeout, this, &LedDevice::writePendingLeds);
+
+	// a monotonic clock, so a change of the system time can't skip or stretch the latch time
+	_lastWriteTimer.start();
 }
 
 LedDevice::~LedDevice()
 {
-
+	DebugIf(_coalescedFrames > 0, _log, "%llu frames have been coalesced within the latch time", _coalescedFrames);
 }
 
 // dummy implemention
@@ -49,6 +59,9 @@ void LedDevice::setEnable(bool enable)
 	// switch off device when disabled, default: set black to leds when they should go off
 	if ( _enabled && !enable)
 	{
+		// a held back frame must not overwrite the switch off
+		_latchTimer->stop();
+		_latchPending = false;
 		switchOff();
 	}
 	else
@@ -86,28 +99,62 @@ bool LedDevice::init(const QJsonObject &deviceConfig)
 
 int LedDevice::setLedValues(const std::vector<ColorRgb>& ledValues)
 {
-	int retval = 0;
 	if (!_deviceReady || !_enabled)
 		return -1;
 
+	return updateLeds(ledValues);
+}
 
+int LedDevice::updateLeds(const std::vector<ColorRgb>& ledValues)
+{
 	// restart the timer
 	if (_refresh_timer.interval() > 0)
 	{
 		_refresh_timer.start();
 	}
 
-	if (_latchTime_ms == 0 || QDateTime::currentMSecsSinceEpoch()-_last_write_time >= _latchTime_ms)
+	const qint64 elapsed = _lastWriteTimer.elapsed();
+	if (_latchTime_ms == 0 || elapsed >= _latchTime_ms)
 	{
-		_ledValues = ledValues;
-		retval = write(ledValues);
-		_last_write_time = QDateTime::currentMSecsSinceEpoch();
+		// a pending frame is older than this one, the latch timer just didn't fire yet
+		if (_latchPending)
+		{
+			_latchTimer->stop();
+			_latchPending = false;
+			_coalescedFrames++;
+		}
+		return writeLeds(ledValues);
 	}
-	//else Debug(_log, "latch %d", QDateTime::currentMSecsSinceEpoch()-_last_write_time);
 
+	// hold the most recent frame back until the device is able to take it
+	if (_latchPending)
+		_coalescedFrames++;
+
+	_pendingValues = ledValues;
+	_latchPending = true;
+	if (!_latchTimer->isActive())
+		_latchTimer->start(int(_latchTime_ms - elapsed));
+
+	return 0;
+}
+
+int LedDevice::writeLeds(const std::vector<ColorRgb>& ledValues)
+{
+	_ledValues = ledValues;
+	const int retval = write(_ledValues);
+	_lastWriteTimer.restart();
 	return retval;
 }
 
+void LedDevice::writePendingLeds()
+{
+	if (_latchPending)
+	{
+		_latchPending = false;
+		writeLeds(_pendingValues);
+	}
+}
+
 int LedDevice::switchOff()
 {
 	return _deviceReady ? write(std::vector<ColorRgb>(_ledCount, ColorRgb::BLACK )) : -1;
@@ -127,5 +174,6 @@ void LedDevice::setLedCount(int ledCount)
 
 int LedDevice::rewriteLeds()
 {
-	return _enabled ? write(_ledValues) : -1;
+	// a refresh is a write as well, the next frame has to respect its latch time
+	return _enabled ? writeLeds(_ledValues) : -1;
 }
@@ -9,6 +9,8 @@
 // util
 #include <hyperion/Hyperion.h>
 #include <utils/JsonUtils.h>
+#include <utils/ThreadScheduler.h>
+#include <utils/ChannelWaker.h>
 
 // qt
 #include <QThread>
@@ -21,6 +23,8 @@ LedDeviceWrapper::LedDeviceWrapper(Hyperion* hyperion)
 	, _hyperion(hyperion)
 	, _ledDevice(nullptr)
 	, _enabled(true)
+	, _ledChannel(SpscChannel<std::vector<ColorRgb>>::LATEST)
+	, _ledWaker(nullptr)
 {
 	// prepare the device constrcutor map
 	#define REGISTER(className) LedDeviceWrapper::addToDeviceMap(QString(#className).toLower(), LedDevice##className::construct);
@@ -48,14 +52,21 @@ void LedDeviceWrapper::createLedDevice(const QJsonObject& config)
 	// create thread and device
 	QThread* thread = new QThread(this);
 	_ledDevice = LedDeviceFactory::construct(config);
+	{
+		// the old device is gone, so nobody consumes the channel right now
+		QMutexLocker lock(&_writeLock);
+		_ledChannel.reset();
+		_ledWaker = new ChannelWaker(_ledDevice);
+	}
 	_ledDevice->moveToThread(thread);
 	// setup thread management
+	ThreadScheduler::manageThread(thread, ThreadScheduler::DEVICE);
 	connect(thread, &QThread::started, _ledDevice, &LedDevice::start);
 	connect(thread, &QThread::finished, thread, &QThread::deleteLater);
 	connect(thread, &QThread::finished, _ledDevice, &LedDevice::deleteLater);
 
 	// further signals
-	connect(this, &LedDeviceWrapper::write, _ledDevice, &LedDevice::write, Qt::QueuedConnection);
+	connect(_ledWaker, &ChannelWaker::woken, _ledDevice, [this]() { writeChannelData(); });
 	connect(_hyperion->getMuxerInstance(), &PriorityMuxer::visiblePriorityChanged, _ledDevice, &LedDevice::visiblePriorityChanged, Qt::QueuedConnection);
 	connect(_ledDevice, &LedDevice::enableStateChanged, this, &LedDeviceWrapper::handleInternalEnableState, Qt::QueuedConnection);
 
@@ -148,12 +159,33 @@ void LedDeviceWrapper::stopDeviceThread()
 
 	// get current thread
 	QThread* oldThread = _ledDevice->thread();
-	disconnect(oldThread, 0, 0, 0);
+	// drop the deferred deletes, both are deleted below. The scheduler still needs to see the thread finish
+	disconnect(oldThread, &QThread::finished, oldThread, &QThread::deleteLater);
+	disconnect(oldThread, &QThread::finished, _ledDevice, &LedDevice::deleteLater);
 	oldThread->quit();
 	oldThread->wait();
 	delete oldThread;
 
 	disconnect(_ledDevice, 0, 0, 0);
+	QMutexLocker lock(&_writeLock);
 	delete _ledDevice;
 	_ledDevice = nullptr;
+	_ledWaker = nullptr;
+}
+
+void LedDeviceWrapper::write(const std::vector<ColorRgb>& ledValues)
+{
+	QMutexLocker lock(&_writeLock);
+	if (_ledWaker == nullptr)
+		return;
+
+	_ledChannel.push(ledValues);
+	_ledWaker->wake();
+}
+
+void LedDeviceWrapper::writeChannelData()
+{
+	// a disabled or not ready device drops the frame
+	if (_ledChannel.pop(_deviceLedValues))
+		_ledDevice->setLedValues(_deviceLedValues);
 }
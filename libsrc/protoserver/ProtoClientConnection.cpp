@@ -179,7 +179,7 @@ void ProtoClientConnection::handleImageCommand(const proto::ImageRequest &messag
 
 	// create ImageRgb
 	Image<ColorRgb> image(width, height);
-	memcpy(image.memptr(), imageData.c_str(), imageData.size());
+	image.copyFrom(imageData.c_str());
 
 	emit setGlobalInputImage(_priority, image, duration);
 
@@ -0,0 +1,103 @@
+#include <utils/Base64.h>
+
+namespace
+{
+	/// Invalid characters map to 0xFF, so an OR of the decoded values reveals an invalid character
+	struct DecodeTable
+	{
+		uint8_t values[256];
+
+		DecodeTable()
+		{
+			const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			for (int i = 0; i < 256; ++i)
+			{
+				values[i] = 0xFF;
+			}
+			for (uint8_t i = 0; i < 64; ++i)
+			{
+				values[uint8_t(alphabet[i])] = i;
+			}
+		}
+	};
+
+	const DecodeTable table;
+}
+
+size_t Base64::decodedSize(const char* data, size_t length)
+{
+	if (length == 0 || length % 4 != 0)
+	{
+		return 0;
+	}
+
+	size_t padding = 0;
+	if (data[length - 1] == '=')
+	{
+		padding = (data[length - 2] == '=') ? 2 : 1;
+	}
+	return length / 4 * 3 - padding;
+}
+
+bool Base64::decode(const char* data, size_t length, uint8_t* out)
+{
+	if (length == 0)
+	{
+		return true;
+	}
+	if (length % 4 != 0)
+	{
+		return false;
+	}
+
+	const uint8_t* in = reinterpret_cast<const uint8_t*>(data);
+	const uint8_t* values = table.values;
+
+	// all quanta except the last one, which may be padded. The loop doesn't branch per character,
+	// the validity is checked once at the end
+	const size_t body = length - 4;
+	uint8_t invalid = 0;
+	for (size_t i = 0; i < body; i += 4)
+	{
+		const uint8_t a = values[in[i]];
+		const uint8_t b = values[in[i + 1]];
+		const uint8_t c = values[in[i + 2]];
+		const uint8_t d = values[in[i + 3]];
+		invalid |= a | b | c | d;
+
+		const uint32_t triple = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | uint32_t(d);
+		out[0] = uint8_t(triple >> 16);
+		out[1] = uint8_t(triple >> 8);
+		out[2] = uint8_t(triple);
+		out += 3;
+	}
+
+	if (invalid & 0x80)
+	{
+		return false;
+	}
+
+	// the last quantum
+	const uint8_t* last = in + body;
+	const size_t padding = (last[3] == '=') ? ((last[2] == '=') ? 2 : 1) : 0;
+	const uint8_t a = values[last[0]];
+	const uint8_t b = values[last[1]];
+	const uint8_t c = (padding >= 2) ? 0 : values[last[2]];
+	const uint8_t d = (padding >= 1) ? 0 : values[last[3]];
+	if ((a | b | c | d) & 0x80)
+	{
+		return false;
+	}
+
+	const uint32_t triple = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | uint32_t(d);
+	out[0] = uint8_t(triple >> 16);
+	if (padding < 2)
+	{
+		out[1] = uint8_t(triple >> 8);
+	}
+	if (padding < 1)
+	{
+		out[2] = uint8_t(triple);
+	}
+	return true;
+}
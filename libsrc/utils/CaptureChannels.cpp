@@ -0,0 +1,100 @@
+#include <utils/CaptureChannels.h>
+#include <utils/ChannelWaker.h>
+
+// qt
+#include <QMutexLocker>
+
+void CaptureChannels::publish(const Source& source, const QString& name, const Image<ColorRgb>& image)
+{
+	QMutexLocker lock(&_sourceLock[source]);
+
+	for (CaptureReceiver* receiver : _receivers[source])
+	{
+		// copy into the image buffer of the slot, it's only reallocated when the capture size grows
+		receiver->_channel.write([&name, &image](CaptureFrame& frame)
+		{
+			frame.name = name;
+			frame.image.resize(image.width(), image.height());
+			frame.image.copy(image);
+			frame.rawBuffer.clear();
+		});
+		receiver->_waker->wake();
+	}
+}
+
+void CaptureChannels::publishRaw(const Source& source, const QString& name, const RawImage& raw)
+{
+	QMutexLocker lock(&_sourceLock[source]);
+
+	for (CaptureReceiver* receiver : _receivers[source])
+	{
+		// the raw buffer keeps its capacity as well, so it's only reallocated when the frame size grows
+		receiver->_channel.write([&name, &raw](CaptureFrame& frame)
+		{
+			frame.name = name;
+			frame.image.resize(0, 0);
+			frame.rawBuffer.assign(raw.data, raw.data + raw.size);
+			frame.raw = raw;
+		});
+		receiver->_waker->wake();
+	}
+}
+
+bool CaptureChannels::rawAccepted(const Source& source, const PixelFormat& pixelFormat)
+{
+	QMutexLocker lock(&_sourceLock[source]);
+
+	const bool packedRgb = RawImage::isPackedRgb(pixelFormat);
+	for (CaptureReceiver* receiver : _receivers[source])
+	{
+		if (!(packedRgb ? receiver->_acceptsPackedRgb : receiver->_acceptsYuv).load(std::memory_order_relaxed))
+			return false;
+	}
+	return !_receivers[source].isEmpty();
+}
+
+void CaptureChannels::addReceiver(const Source& source, CaptureReceiver* receiver)
+{
+	QMutexLocker lock(&_sourceLock[source]);
+	_receivers[source].append(receiver);
+}
+
+void CaptureChannels::removeReceiver(const Source& source, CaptureReceiver* receiver)
+{
+	QMutexLocker lock(&_sourceLock[source]);
+	_receivers[source].removeAll(receiver);
+}
+
+CaptureReceiver::CaptureReceiver(const CaptureChannels::Source& source, QObject* parent)
+	: QObject(parent)
+	, _source(source)
+	, _channel(SpscChannel<CaptureFrame>::LATEST)
+	, _waker(new ChannelWaker(this))
+	, _acceptsPackedRgb(false)
+	, _acceptsYuv(false)
+{
+	connect(_waker, &ChannelWaker::woken, this, &CaptureReceiver::handleWakeUp);
+	CaptureChannels::getInstance()->addReceiver(_source, this);
+}
+
+CaptureReceiver::~CaptureReceiver()
+{
+	// once removed no capture thread touches the channel anymore
+	CaptureChannels::getInstance()->removeReceiver(_source, this);
+}
+
+void CaptureReceiver::handleWakeUp()
+{
+	if (!_channel.pop(_frame))
+		return;
+
+	if (!_frame.rawBuffer.empty())
+	{
+		_frame.raw.data = _frame.rawBuffer.data();
+		emit newRawFrame(_frame.name, _frame.raw);
+	}
+	else
+	{
+		emit newFrame(_frame.name, _frame.image);
+	}
+}
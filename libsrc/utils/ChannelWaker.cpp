@@ -0,0 +1,74 @@
+#include <utils/ChannelWaker.h>
+
+// qt
+#include <QSocketNotifier>
+
+#ifdef Q_OS_UNIX
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+ChannelWaker::ChannelWaker(QObject* parent)
+	: QObject(parent)
+	, _notifier(nullptr)
+	, _pending(false)
+{
+	_pipe[0] = _pipe[1] = -1;
+
+#ifdef Q_OS_UNIX
+	if (pipe(_pipe) == 0)
+	{
+		for (int fd : _pipe)
+		{
+			fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+			fcntl(fd, F_SETFD, FD_CLOEXEC);
+		}
+
+		_notifier = new QSocketNotifier(_pipe[0], QSocketNotifier::Read, this);
+		connect(_notifier, SIGNAL(activated(int)), this, SLOT(handleWakeUp()));
+	}
+#endif
+}
+
+ChannelWaker::~ChannelWaker()
+{
+	delete _notifier;
+
+#ifdef Q_OS_UNIX
+	for (int fd : _pipe)
+	{
+		if (fd != -1)
+			close(fd);
+	}
+#endif
+}
+
+void ChannelWaker::wake()
+{
+	if (_pending.exchange(true, std::memory_order_acq_rel))
+		return;
+
+#ifdef Q_OS_UNIX
+	if (_notifier != nullptr)
+	{
+		const char byte = 1;
+		if (write(_pipe[1], &byte, 1) == 1)
+			return;
+	}
+#endif
+
+	// no pipe available, fall back to a queued call
+	QMetaObject::invokeMethod(this, "handleWakeUp", Qt::QueuedConnection);
+}
+
+void ChannelWaker::handleWakeUp()
+{
+#ifdef Q_OS_UNIX
+	char buffer[16];
+	while (_pipe[0] != -1 && read(_pipe[0], buffer, sizeof(buffer)) > 0);
+#endif
+
+	// clear before the consumer drains, a value pushed meanwhile triggers the next wake-up
+	_pending.store(false, std::memory_order_release);
+	emit woken();
+}
@@ -1,6 +1,57 @@
 #include "utils/ImageResampler.h"
 #include <utils/Logger.h>
 
+// stl includes
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+///
+/// @brief Run a row kernel for every sampled source row, the kernel gets the source row index and the destination row
+///
+template <typename Pixel_T, typename RowKernel>
+static inline void forEachRow(Image<Pixel_T>& outputImage, int yStart, int yStep, RowKernel kernel)
+{
+	int ySource = yStart;
+	for (unsigned yDest = 0; yDest < outputImage.height(); ++yDest, ySource += yStep)
+		kernel(ySource, outputImage.row(yDest));
+}
+
+///
+/// @brief Average blocks of xStep x yStep source pixels into one output pixel, the blocks at the right and bottom edge may be smaller.
+/// The reader adds the three channels of a run of pixels within a source row to a sum, the writer converts the averaged channels to the output pixel
+///
+template <typename Pixel_T, typename RunReader, typename PixelWriter>
+static void averageBlocks(Image<Pixel_T>& outputImage, int xStart, int yStart, int xEnd, int yEnd, int xStep, int yStep, RunReader read, PixelWriter write)
+{
+	const unsigned outputWidth = outputImage.width();
+	std::vector<uint32_t> sums(outputWidth * 3);
+
+	for (unsigned yDest = 0; yDest < outputImage.height(); ++yDest)
+	{
+		const int yFirst = yStart + int(yDest) * yStep;
+		const int yLast  = std::min(yFirst + yStep, yEnd);
+
+		std::fill(sums.begin(), sums.end(), 0);
+		for (int ySource = yFirst; ySource < yLast; ++ySource)
+		{
+			uint32_t* sum = sums.data();
+			for (int xFirst = xStart; sum != sums.data() + sums.size(); xFirst += xStep, sum += 3)
+				read(ySource, xFirst, std::min(xFirst + xStep, xEnd), sum);
+		}
+
+		Pixel_T* dest = outputImage.row(yDest);
+		const uint32_t* sum = sums.data();
+		for (unsigned xDest = 0; xDest < outputWidth; ++xDest, sum += 3)
+		{
+			const int xFirst = xStart + int(xDest) * xStep;
+			const uint32_t count = uint32_t((std::min(xFirst + xStep, xEnd) - xFirst) * (yLast - yFirst));
+			const uint32_t half = count >> 1;
+			write(uint8_t((sum[0] + half) / count), uint8_t((sum[1] + half) / count), uint8_t((sum[2] + half) / count), dest[xDest]);
+		}
+	}
+}
+
 ImageResampler::ImageResampler()
 	: _horizontalDecimation(1)
 	, _verticalDecimation(1)
@@ -9,6 +60,7 @@ ImageResampler::ImageResampler()
 	, _cropTop(0)
 	, _cropBottom(0)
 	, _videoMode(VIDEO_2D)
+	, _decimationMode(DECIMATION_SAMPLE)
 {
 }
 
@@ -39,10 +91,12 @@ void ImageResampler::setVideoMode(VideoMode mode)
 	_videoMode = mode;
 }
 
-void ImageResampler::processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgb> &outputImage) const
+void ImageResampler::getCropping(int width, int height, int & cropLeft, int & cropRight, int & cropTop, int & cropBottom) const
 {
-	int cropRight  = _cropRight;
-	int cropBottom = _cropBottom;
+	cropLeft   = _cropLeft;
+	cropRight  = _cropRight;
+	cropTop    = _cropTop;
+	cropBottom = _cropBottom;
 
 	// handle 3D mode
 	switch (_videoMode)
@@ -51,101 +105,365 @@ void ImageResampler::processImage(const uint8_t * data, int width, int height, i
 		cropRight = width >> 1;
 		break;
 	case VIDEO_3DTAB:
-		cropBottom = width >> 1;
+		cropBottom = height >> 1;
 		break;
 	default:
 		break;
 	}
+}
+
+void ImageResampler::setDecimationMode(DecimationMode mode)
+{
+	_decimationMode = mode;
+}
+
+ImageResampler::DecimationMode ImageResampler::parseDecimationMode(const QString& mode)
+{
+	return (mode.toLower() == "average") ? DECIMATION_AVERAGE : DECIMATION_SAMPLE;
+}
+
+void ImageResampler::processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgb> &outputImage) const
+{
+	resample(data, width, height, lineLength, pixelFormat, outputImage);
+}
+
+void ImageResampler::processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgbx> &outputImage) const
+{
+	resample(data, width, height, lineLength, pixelFormat, outputImage);
+}
+
+template <typename Pixel_T>
+void ImageResampler::resample(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<Pixel_T> &outputImage) const
+{
+	int cropLeft, cropRight, cropTop, cropBottom;
+	getCropping(width, height, cropLeft, cropRight, cropTop, cropBottom);
 
 	// calculate the output size
-	int outputWidth = (width - _cropLeft - cropRight - (_horizontalDecimation >> 1) + _horizontalDecimation - 1) / _horizontalDecimation;
-	int outputHeight = (height - _cropTop - cropBottom - (_verticalDecimation >> 1) + _verticalDecimation - 1) / _verticalDecimation;
-	if ((outputImage.height() != unsigned(outputHeight)) && (outputImage.width() != unsigned(outputWidth)))
+	int outputWidth = (width - cropLeft - cropRight - (_horizontalDecimation >> 1) + _horizontalDecimation - 1) / _horizontalDecimation;
+	int outputHeight = (height - cropTop - cropBottom - (_verticalDecimation >> 1) + _verticalDecimation - 1) / _verticalDecimation;
+	if ((outputImage.height() != unsigned(outputHeight)) || (outputImage.width() != unsigned(outputWidth)))
 		outputImage.resize(outputWidth, outputHeight);
 
-	for (int yDest = 0, ySource = _cropTop + (_verticalDecimation >> 1); yDest < outputHeight; ySource += _verticalDecimation, ++yDest)
+	if (_decimationMode == DECIMATION_AVERAGE && (_horizontalDecimation > 1 || _verticalDecimation > 1))
+	{
+		average(data, height, lineLength, pixelFormat, cropLeft, cropTop, width - cropRight, height - cropBottom, outputImage);
+		return;
+	}
+
+	// the center pixel of each block
+	sample(data, height, lineLength, pixelFormat, cropLeft + (_horizontalDecimation >> 1), cropTop + (_verticalDecimation >> 1), _horizontalDecimation, _verticalDecimation, outputImage);
+}
+
+void ImageResampler::processSamples(const uint8_t * data, int height, int lineLength, PixelFormat pixelFormat, int xStart, int yStart, int xStep, int yStep, Image<ColorRgb> &outputImage) const
+{
+	sample(data, height, lineLength, pixelFormat, xStart, yStart, xStep, yStep, outputImage);
+}
+
+template <typename Pixel_T>
+void ImageResampler::sample(const uint8_t * data, int height, int lineLength, PixelFormat pixelFormat, int xStart, int yStart, int xStep, int yStep, Image<Pixel_T> &outputImage) const
+{
+	// the sampled source pixels, every kernel reads just the bytes of these pixels
+	const int outputWidth = int(outputImage.width());
+
+	switch (pixelFormat)
 	{
-		for (int xDest = 0, xSource = _cropLeft + (_horizontalDecimation >> 1); xDest < outputWidth; xSource += _horizontalDecimation, ++xDest)
+		case PIXELFORMAT_UYVY:
 		{
-			ColorRgb & rgb = outputImage(xDest, yDest);
-			
-			switch (pixelFormat)
+			forEachRow(outputImage, yStart, yStep, [&](int ySource, Pixel_T* dest)
 			{
-				case PIXELFORMAT_UYVY:
+				// a macro pixel holds u, y0, v, y1
+				const uint8_t* row = data + lineLength * ySource;
+				for (int xDest = 0, xSource = xStart; xDest < outputWidth; xSource += xStep, ++xDest)
 				{
-					int index = lineLength * ySource + (xSource << 1);
-					uint8_t y = data[index+1];
-					uint8_t u = ((xSource&1) == 0) ? data[index  ] : data[index-2];
-					uint8_t v = ((xSource&1) == 0) ? data[index+2] : data[index  ];
-					yuv2rgb(y, u, v, rgb.red, rgb.green, rgb.blue);
+					const uint8_t* macroPixel = row + ((xSource & ~1) << 1);
+					yuv2rgb(row[(xSource << 1) + 1], macroPixel[0], macroPixel[2], dest[xDest].red, dest[xDest].green, dest[xDest].blue);
 				}
-				break;
-				case PIXELFORMAT_YUYV:
+			});
+		}
+		break;
+
+		case PIXELFORMAT_YUYV:
+		{
+			forEachRow(outputImage, yStart, yStep, [&](int ySource, Pixel_T* dest)
+			{
+				// a macro pixel holds y0, u, y1, v
+				const uint8_t* row = data + lineLength * ySource;
+				for (int xDest = 0, xSource = xStart; xDest < outputWidth; xSource += xStep, ++xDest)
 				{
-					int index = lineLength * ySource + (xSource << 1);
-					uint8_t y = data[index];
-					uint8_t u = ((xSource&1) == 0) ? data[index+1] : data[index-1];
-					uint8_t v = ((xSource&1) == 0) ? data[index+3] : data[index+1];
-					yuv2rgb(y, u, v, rgb.red, rgb.green, rgb.blue);
+					const uint8_t* macroPixel = row + ((xSource & ~1) << 1);
+					yuv2rgb(row[xSource << 1], macroPixel[1], macroPixel[3], dest[xDest].red, dest[xDest].green, dest[xDest].blue);
 				}
-				break;
-				case PIXELFORMAT_BGR16:
+			});
+		}
+		break;
+
+		case PIXELFORMAT_NV12:
+		case PIXELFORMAT_NV21:
+		{
+			// full resolution luma plane followed by one interleaved chroma plane with half the rows
+			const uint8_t* chromaPlane = data + lineLength * height;
+			const int uOffset = (pixelFormat == PIXELFORMAT_NV12) ? 0 : 1;
+			const int vOffset = 1 - uOffset;
+
+			forEachRow(outputImage, yStart, yStep, [&](int ySource, Pixel_T* dest)
+			{
+				const uint8_t* lumaRow   = data + lineLength * ySource;
+				const uint8_t* chromaRow = chromaPlane + lineLength * (ySource >> 1);
+				for (int xDest = 0, xSource = xStart; xDest < outputWidth; xSource += xStep, ++xDest)
 				{
-					int index = lineLength * ySource + (xSource << 1);
-					rgb.blue  = (data[index] & 0x1f) << 3;
-					rgb.green = (((data[index+1] & 0x7) << 3) | (data[index] & 0xE0) >> 5) << 2;
-					rgb.red   = (data[index+1] & 0xF8);
+					const uint8_t* chroma = chromaRow + (xSource & ~1);
+					yuv2rgb(lumaRow[xSource], chroma[uOffset], chroma[vOffset], dest[xDest].red, dest[xDest].green, dest[xDest].blue);
 				}
-				break;
-				case PIXELFORMAT_BGR24:
+			});
+		}
+		break;
+
+		case PIXELFORMAT_I420:
+		case PIXELFORMAT_YV12:
+		{
+			// full resolution luma plane followed by two chroma planes with half the rows and columns, u first for I420 and v first for YV12
+			const int chromaLineLength = lineLength >> 1;
+			const uint8_t* uPlane = data + lineLength * height;
+			const uint8_t* vPlane = uPlane + chromaLineLength * (height >> 1);
+			if (pixelFormat == PIXELFORMAT_YV12)
+				std::swap(uPlane, vPlane);
+
+			forEachRow(outputImage, yStart, yStep, [&](int ySource, Pixel_T* dest)
+			{
+				const uint8_t* lumaRow = data + lineLength * ySource;
+				const uint8_t* uRow    = uPlane + chromaLineLength * (ySource >> 1);
+				const uint8_t* vRow    = vPlane + chromaLineLength * (ySource >> 1);
+				for (int xDest = 0, xSource = xStart; xDest < outputWidth; xSource += xStep, ++xDest)
 				{
-					int index = lineLength * ySource + (xSource << 1) + xSource;
-					rgb.blue  = data[index  ];
-					rgb.green = data[index+1];
-					rgb.red   = data[index+2];
+					yuv2rgb(lumaRow[xSource], uRow[xSource >> 1], vRow[xSource >> 1], dest[xDest].red, dest[xDest].green, dest[xDest].blue);
 				}
-				break;
-				case PIXELFORMAT_RGB32:
+			});
+		}
+		break;
+
+		case PIXELFORMAT_GREY:
+		{
+			forEachRow(outputImage, yStart, yStep, [&](int ySource, Pixel_T* dest)
+			{
+				const uint8_t* row = data + lineLength * ySource;
+				for (int xDest = 0, xSource = xStart; xDest < outputWidth; xSource += xStep, ++xDest)
 				{
-					int index = lineLength * ySource + (xSource << 2);
-					rgb.red   = data[index  ];
-					rgb.green = data[index+1];
-					rgb.blue  = data[index+2];
+					dest[xDest].red   = row[xSource];
+					dest[xDest].green = row[xSource];
+					dest[xDest].blue  = row[xSource];
 				}
-				break;
-				case PIXELFORMAT_BGR32:
+			});
+		}
+		break;
+
+		case PIXELFORMAT_BGR16:
+		{
+			forEachRow(outputImage, yStart, yStep, [&](int ySource, Pixel_T* dest)
+			{
+				const uint8_t* row = data + lineLength * ySource;
+				for (int xDest = 0, xSource = xStart; xDest < outputWidth; xSource += xStep, ++xDest)
 				{
-					int index = lineLength * ySource + (xSource << 2);
-					rgb.blue  = data[index  ];
-					rgb.green = data[index+1];
-					rgb.red   = data[index+2];
+					const uint8_t* pixel = row + (xSource << 1);
+					dest[xDest].blue  = (pixel[0] & 0x1f) << 3;
+					dest[xDest].green = (((pixel[1] & 0x7) << 3) | (pixel[0] & 0xE0) >> 5) << 2;
+					dest[xDest].red   = (pixel[1] & 0xF8);
 				}
-				break;
+			});
+		}
+		break;
+
+		case PIXELFORMAT_BGR24:
+		case PIXELFORMAT_RGB24:
+		{
+			const int redOffset  = (pixelFormat == PIXELFORMAT_RGB24) ? 0 : 2;
+			const int blueOffset = 2 - redOffset;
+
+			forEachRow(outputImage, yStart, yStep, [&](int ySource, Pixel_T* dest)
+			{
+				const uint8_t* row = data + lineLength * ySource;
+				for (int xDest = 0, xSource = xStart; xDest < outputWidth; xSource += xStep, ++xDest)
+				{
+					const uint8_t* pixel = row + (xSource << 1) + xSource;
+					dest[xDest].red   = pixel[redOffset];
+					dest[xDest].green = pixel[1];
+					dest[xDest].blue  = pixel[blueOffset];
+				}
+			});
+		}
+		break;
+
+		case PIXELFORMAT_RGB32:
+		case PIXELFORMAT_BGR32:
+		{
+			const int redOffset  = (pixelFormat == PIXELFORMAT_RGB32) ? 0 : 2;
+			const int blueOffset = 2 - redOffset;
+
+			forEachRow(outputImage, yStart, yStep, [&](int ySource, Pixel_T* dest)
+			{
+				const uint8_t* row = data + lineLength * ySource;
+				for (int xDest = 0, xSource = xStart; xDest < outputWidth; xSource += xStep, ++xDest)
+				{
+					const uint8_t* pixel = row + (xSource << 2);
+					dest[xDest].red   = pixel[redOffset];
+					dest[xDest].green = pixel[1];
+					dest[xDest].blue  = pixel[blueOffset];
+				}
+			});
+		}
+		break;
+
 #ifdef HAVE_JPEG
-				case PIXELFORMAT_MJPEG:
-					break;
+		case PIXELFORMAT_MJPEG:
+			break;
 #endif
-				case PIXELFORMAT_NO_CHANGE:
-					Error(Logger::getInstance("ImageResampler"), "Invalid pixel format given");
-				break;
-			}
-		}
+		case PIXELFORMAT_NO_CHANGE:
+			Error(Logger::getInstance("ImageResampler"), "Invalid pixel format given");
+		break;
 	}
 }
 
-uint8_t ImageResampler::clamp(int x)
+template <typename Pixel_T>
+void ImageResampler::average(const uint8_t * data, int height, int lineLength, PixelFormat pixelFormat, int xStart, int yStart, int xEnd, int yEnd, Image<Pixel_T> &outputImage) const
 {
-	return (x<0) ? 0 : ((x>255) ? 255 : uint8_t(x));
-}
+	const int xStep = _horizontalDecimation;
+	const int yStep = _verticalDecimation;
 
-void ImageResampler::yuv2rgb(uint8_t y, uint8_t u, uint8_t v, uint8_t &r, uint8_t &g, uint8_t &b)
-{
-	// see: http://en.wikipedia.org/wiki/YUV#Y.27UV444_to_RGB888_conversion
-	int c = y - 16;
-	int d = u - 128;
-	int e = v - 128;
-	
-	r = clamp((298 * c + 409 * e + 128) >> 8);
-	g = clamp((298 * c - 100 * d - 208 * e + 128) >> 8);
-	b = clamp((298 * c + 516 * d + 128) >> 8);
+	// yuv is averaged as it is and converted once per block, the conversion is affine apart from the clamping
+	const auto writeYuv = [](uint8_t y, uint8_t u, uint8_t v, Pixel_T& dest) { yuv2rgb(y, u, v, dest.red, dest.green, dest.blue); };
+	const auto writeRgb = [](uint8_t r, uint8_t g, uint8_t b, Pixel_T& dest) { dest.red = r; dest.green = g; dest.blue = b; };
+
+	switch (pixelFormat)
+	{
+		case PIXELFORMAT_UYVY:
+		case PIXELFORMAT_YUYV:
+		{
+			// a macro pixel holds u, y0, v, y1 (UYVY) or y0, u, y1, v (YUYV)
+			const int yOffset = (pixelFormat == PIXELFORMAT_YUYV) ? 0 : 1;
+			const int uOffset = 1 - yOffset;
+			const int vOffset = uOffset + 2;
+
+			averageBlocks(outputImage, xStart, yStart, xEnd, yEnd, xStep, yStep, [&](int ySource, int xFirst, int xLast, uint32_t* sum)
+			{
+				const uint8_t* row = data + lineLength * ySource;
+				for (int xSource = xFirst; xSource < xLast; ++xSource)
+				{
+					const uint8_t* macroPixel = row + ((xSource & ~1) << 1);
+					sum[0] += row[(xSource << 1) + yOffset];
+					sum[1] += macroPixel[uOffset];
+					sum[2] += macroPixel[vOffset];
+				}
+			}, writeYuv);
+		}
+		break;
+
+		case PIXELFORMAT_NV12:
+		case PIXELFORMAT_NV21:
+		{
+			const uint8_t* chromaPlane = data + lineLength * height;
+			const int uOffset = (pixelFormat == PIXELFORMAT_NV12) ? 0 : 1;
+			const int vOffset = 1 - uOffset;
+
+			averageBlocks(outputImage, xStart, yStart, xEnd, yEnd, xStep, yStep, [&](int ySource, int xFirst, int xLast, uint32_t* sum)
+			{
+				const uint8_t* lumaRow   = data + lineLength * ySource;
+				const uint8_t* chromaRow = chromaPlane + lineLength * (ySource >> 1);
+				for (int xSource = xFirst; xSource < xLast; ++xSource)
+				{
+					const uint8_t* chroma = chromaRow + (xSource & ~1);
+					sum[0] += lumaRow[xSource];
+					sum[1] += chroma[uOffset];
+					sum[2] += chroma[vOffset];
+				}
+			}, writeYuv);
+		}
+		break;
+
+		case PIXELFORMAT_I420:
+		case PIXELFORMAT_YV12:
+		{
+			const int chromaLineLength = lineLength >> 1;
+			const uint8_t* uPlane = data + lineLength * height;
+			const uint8_t* vPlane = uPlane + chromaLineLength * (height >> 1);
+			if (pixelFormat == PIXELFORMAT_YV12)
+				std::swap(uPlane, vPlane);
+
+			averageBlocks(outputImage, xStart, yStart, xEnd, yEnd, xStep, yStep, [&](int ySource, int xFirst, int xLast, uint32_t* sum)
+			{
+				const uint8_t* lumaRow = data + lineLength * ySource;
+				const uint8_t* uRow    = uPlane + chromaLineLength * (ySource >> 1);
+				const uint8_t* vRow    = vPlane + chromaLineLength * (ySource >> 1);
+				for (int xSource = xFirst; xSource < xLast; ++xSource)
+				{
+					sum[0] += lumaRow[xSource];
+					sum[1] += uRow[xSource >> 1];
+					sum[2] += vRow[xSource >> 1];
+				}
+			}, writeYuv);
+		}
+		break;
+
+		case PIXELFORMAT_GREY:
+		{
+			averageBlocks(outputImage, xStart, yStart, xEnd, yEnd, xStep, yStep, [&](int ySource, int xFirst, int xLast, uint32_t* sum)
+			{
+				const uint8_t* row = data + lineLength * ySource;
+				uint32_t grey = 0;
+				for (int xSource = xFirst; xSource < xLast; ++xSource)
+					grey += row[xSource];
+				sum[0] += grey;
+			}, [](uint8_t grey, uint8_t, uint8_t, Pixel_T& dest) { dest.red = grey; dest.green = grey; dest.blue = grey; });
+		}
+		break;
+
+		case PIXELFORMAT_BGR16:
+		{
+			averageBlocks(outputImage, xStart, yStart, xEnd, yEnd, xStep, yStep, [&](int ySource, int xFirst, int xLast, uint32_t* sum)
+			{
+				const uint8_t* row = data + lineLength * ySource;
+				for (int xSource = xFirst; xSource < xLast; ++xSource)
+				{
+					const uint8_t* pixel = row + (xSource << 1);
+					sum[0] += (pixel[1] & 0xF8);
+					sum[1] += (((pixel[1] & 0x7) << 3) | (pixel[0] & 0xE0) >> 5) << 2;
+					sum[2] += (pixel[0] & 0x1f) << 3;
+				}
+			}, writeRgb);
+		}
+		break;
+
+		case PIXELFORMAT_BGR24:
+		case PIXELFORMAT_RGB24:
+		case PIXELFORMAT_RGB32:
+		case PIXELFORMAT_BGR32:
+		{
+			const int bytesPerPixel = (pixelFormat == PIXELFORMAT_RGB24 || pixelFormat == PIXELFORMAT_BGR24) ? 3 : 4;
+			const bool redFirst = (pixelFormat == PIXELFORMAT_RGB24 || pixelFormat == PIXELFORMAT_RGB32);
+
+			averageBlocks(outputImage, xStart, yStart, xEnd, yEnd, xStep, yStep, [&](int ySource, int xFirst, int xLast, uint32_t* sum)
+			{
+				// plain channel sums over a contiguous run of bytes
+				const uint8_t* pixel = data + lineLength * ySource + xFirst * bytesPerPixel;
+				const uint8_t* end   = pixel + (xLast - xFirst) * bytesPerPixel;
+				uint32_t first = 0, green = 0, last = 0;
+				for (; pixel != end; pixel += bytesPerPixel)
+				{
+					first += pixel[0];
+					green += pixel[1];
+					last  += pixel[2];
+				}
+				sum[0] += redFirst ? first : last;
+				sum[1] += green;
+				sum[2] += redFirst ? last : first;
+			}, writeRgb);
+		}
+		break;
+
+#ifdef HAVE_JPEG
+		case PIXELFORMAT_MJPEG:
+			break;
+#endif
+		case PIXELFORMAT_NO_CHANGE:
+			Error(Logger::getInstance("ImageResampler"), "Invalid pixel format given");
+		break;
+	}
 }
@@ -1,8 +1,17 @@
 #include <utils/Logger.h>
 #include <utils/FileUtils.h>
+#include <utils/SpscChannel.h>
 
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdlib>
 #include <syslog.h>
 
 #include <QFileInfo>
@@ -16,10 +25,308 @@ static unsigned int loggerId            = 0;
 std::map<QString,Logger*> *Logger::LoggerMap = nullptr;
 Logger::LogLevel Logger::GLOBAL_MIN_LOG_LEVEL = Logger::UNSET;
 LoggerManager* LoggerManager::_instance = nullptr;
-int _repeatCount = 0;
-Logger::T_LOG_MESSAGE _repeatMessage;
+
+namespace {
+
+const size_t max_msg_length = 1024;
+// records per thread which may wait for the writer, they are preallocated per logging thread
+const size_t threadRingSize = 64;
 const int _maxRepeatCountSize = 200;
 
+///
+/// A log message as handed over from the logging thread to the writer thread
+///
+struct LogRecord
+{
+	uint64_t         sequence;
+	QString          appName;
+	QString          loggerName;
+	const char*      sourceFile;
+	const char*      function;
+	unsigned int     line;
+	time_t           utime;
+	Logger::LogLevel level;
+	bool             syslogEnabled;
+	char             message[max_msg_length];
+};
+
+///
+/// Lock free ring of log records with a single producer (the logging thread) and a single consumer (the writer thread).
+/// The slots are allocated once, a message is formatted right into a slot, so logging doesn't allocate memory
+///
+struct ThreadLogRing
+{
+	ThreadLogRing()
+		: records(SpscChannel<LogRecord>::QUEUE, threadRingSize)
+		, closed(false)
+	{
+	}
+
+	SpscChannel<LogRecord> records;
+
+	/// the owning thread has been finished, the ring is removed once it's empty
+	std::atomic<bool> closed;
+};
+
+///
+/// Marks the ring of a thread as closed when the thread exits
+///
+struct ThreadRingHandle
+{
+	std::shared_ptr<ThreadLogRing> ring;
+
+	~ThreadRingHandle()
+	{
+		if (ring)
+			ring->closed = true;
+	}
+};
+
+thread_local ThreadRingHandle threadRingHandle;
+
+///
+/// Background thread which drains the rings of all threads and does the actual (blocking) output
+///
+class LogWriter
+{
+public:
+	static LogWriter* getInstance()
+	{
+		static LogWriter* writer = new LogWriter();
+		return writer;
+	}
+
+	///
+	/// @brief Queue a record, called from the logging thread. Writes synchronously if the writer has been stopped already
+	/// @param level  The level of the record
+	/// @param fill   Callable which gets the record (LogRecord&) to fill, it's a free slot of the ring of the thread
+	///
+	template <typename Fill>
+	void post(const Logger::LogLevel level, Fill fill)
+	{
+		if (!_running)
+		{
+			LogRecord record;
+			fill(record);
+			record.sequence = _sequence++;
+
+			std::lock_guard<std::mutex> lock(_outputMutex);
+			write(record, false);
+			std::cout.flush();
+			return;
+		}
+
+		if (!threadRingHandle.ring)
+		{
+			threadRingHandle.ring = std::make_shared<ThreadLogRing>();
+			std::lock_guard<std::mutex> lock(_ringsMutex);
+			_rings.push_back(threadRingHandle.ring);
+		}
+
+		const bool queued = threadRingHandle.ring->records.write([&](LogRecord& record)
+		{
+			fill(record);
+			record.sequence = _sequence++;
+		});
+
+		if (!queued)
+		{
+			// the writer can't keep up, don't block the logging thread
+			_dropped++;
+		}
+
+		// errors and warnings are written as soon as possible, others are collected for a while
+		if (level >= Logger::WARNING)
+			_wakeup.notify_one();
+	}
+
+	///
+	/// @brief Stop the writer thread and write all pending messages
+	///
+	static void stop()
+	{
+		LogWriter* writer = getInstance();
+		if (!writer->_running.exchange(false))
+			return;
+
+		writer->_wakeup.notify_one();
+		writer->_thread.join();
+
+		// at this point the application may be gone, just write the console/syslog output
+		writer->drain(false);
+	}
+
+private:
+	LogWriter()
+		: _running(true)
+		, _sequence(0)
+		, _dropped(0)
+		, _repeatCount(0)
+	{
+		_repeatMessage.line = 0;
+		_repeatMessage.level = Logger::UNSET;
+		_thread = std::thread(&LogWriter::run, this);
+		std::atexit(&LogWriter::stop);
+	}
+
+	void run()
+	{
+		while (_running)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_wakeMutex);
+				_wakeup.wait_for(lock, std::chrono::milliseconds(20));
+			}
+			drain(true);
+		}
+	}
+
+	///
+	/// @brief Collect the records of all threads, write them in the order they have been logged
+	///
+	void drain(bool notify)
+	{
+		// the records are swapped out of the rings into the batch, which keeps its memory between the drains
+		_batch.clear();
+		{
+			std::lock_guard<std::mutex> lock(_ringsMutex);
+			for (auto it = _rings.begin(); it != _rings.end();)
+			{
+				// read closed first, a record pushed before the thread finished is still collected
+				const bool closed = (*it)->closed;
+				while (true)
+				{
+					_batch.emplace_back();
+					if (!(*it)->records.pop(_batch.back()))
+					{
+						_batch.pop_back();
+						break;
+					}
+				}
+
+				if (closed)
+					it = _rings.erase(it);
+				else
+					++it;
+			}
+		}
+
+		if (_batch.empty() && _dropped == 0)
+			return;
+
+		std::vector<const LogRecord*> records;
+		records.reserve(_batch.size());
+		for (const LogRecord& record : _batch)
+			records.push_back(&record);
+
+		std::sort(records.begin(), records.end(), [](const LogRecord* a, const LogRecord* b) { return a->sequence < b->sequence; });
+
+		std::lock_guard<std::mutex> lock(_outputMutex);
+		for (const LogRecord* record : records)
+		{
+			write(*record, notify);
+		}
+
+		const unsigned dropped = _dropped.exchange(0);
+		if (dropped > 0)
+			std::cout << QString("[" + _repeatMessage.appName + " LOGGER] <WARNING> " + QString::number(dropped) + " log messages dropped").toStdString() << '\n';
+
+		// flush once per batch
+		std::cout.flush();
+	}
+
+	void write(const LogRecord& record, bool notify)
+	{
+		auto repeatedSummary = [=]
+		{
+			Logger::T_LOG_MESSAGE repMsg = _repeatMessage;
+			repMsg.message = "Previous line repeats " + QString::number(_repeatCount) + " times";
+
+			if (notify)
+				LoggerManager::getInstance()->handleNewLogMessage(repMsg);
+
+			std::cout << QString("[" + repMsg.appName + " " + repMsg.loggerName + "] <" + LogLevelStrings[repMsg.level] + "> " + repMsg.message).toStdString() << '\n';
+
+			if ( _repeatSyslogEnabled && repMsg.level >= Logger::WARNING )
+				syslog (LogLevelSysLog[repMsg.level], "Previous line repeats %d times", _repeatCount);
+
+			_repeatCount = 0;
+		};
+
+		const QString msg(record.message);
+
+		if (_repeatMessage.loggerName == record.loggerName
+			&& _repeatMessage.line == record.line
+			&& _repeatMessage.function == record.function
+			&& _repeatMessage.message == msg)
+		{
+			if (_repeatCount >= _maxRepeatCountSize)
+				repeatedSummary();
+			else
+				_repeatCount++;
+
+			return;
+		}
+
+		if (_repeatCount) repeatedSummary();
+
+		Logger::T_LOG_MESSAGE logMsg;
+
+		logMsg.appName     = record.appName;
+		logMsg.loggerName  = record.loggerName;
+		logMsg.function    = QString(record.function);
+		logMsg.line        = record.line;
+		logMsg.fileName    = FileUtils::getBaseName(record.sourceFile);
+		logMsg.utime       = record.utime;
+		logMsg.message     = msg;
+		logMsg.level       = record.level;
+		logMsg.levelString = LogLevelStrings[record.level];
+
+		if (notify)
+			LoggerManager::getInstance()->handleNewLogMessage(logMsg);
+
+		QString location;
+		if ( record.level == Logger::DEBUG )
+		{
+			location = "<" + logMsg.fileName + ":" + QString::number(record.line)+":"+ logMsg.function + "()> ";
+		}
+
+		std::cout << QString("[" + logMsg.appName + " " + logMsg.loggerName + "] <" + logMsg.levelString + "> " + location + msg).toStdString() << '\n';
+
+		if ( record.syslogEnabled && record.level >= Logger::WARNING )
+			syslog (LogLevelSysLog[record.level], "%s", record.message);
+
+		_repeatMessage = logMsg;
+		_repeatSyslogEnabled = record.syslogEnabled;
+	}
+
+	std::atomic<bool> _running;
+	std::atomic<uint64_t> _sequence;
+	std::atomic<unsigned> _dropped;
+
+	/// all registered thread rings
+	std::mutex _ringsMutex;
+	std::vector<std::shared_ptr<ThreadLogRing>> _rings;
+
+	/// the records of the running drain, accessed by the writer thread only (or stop() after it ended)
+	std::vector<LogRecord> _batch;
+
+	std::mutex _wakeMutex;
+	std::condition_variable _wakeup;
+
+	/// serializes the output of the writer thread and synchronous writes after stop()
+	std::mutex _outputMutex;
+
+	/// repeat detection, accessed by the output only
+	int _repeatCount;
+	Logger::T_LOG_MESSAGE _repeatMessage;
+	bool _repeatSyslogEnabled = false;
+
+	std::thread _thread;
+};
+
+}
+
 Logger* Logger::getInstance(QString name, Logger::LogLevel minLevel)
 {
 	qRegisterMetaType<Logger::T_LOG_MESSAGE>();
@@ -34,7 +341,9 @@ Logger* Logger::getInstance(QString name, Logger::LogLevel minLevel)
 		log = new Logger(name,minLevel);
 		LoggerMap->insert(std::pair<QString,Logger*>(name,log)); // compat version, replace it with following line if we have 100% c++11
 		//LoggerMap->emplace(name,log);  // not compat with older linux distro's e.g. wheezy
-		connect(log, &Logger::newLogMessage, LoggerManager::getInstance(), &LoggerManager::handleNewLogMessage);
+
+		// create the manager in the calling (usually main) thread, it's fed from the writer thread
+		LoggerManager::getInstance();
 	}
 	else
 	{
@@ -122,94 +431,70 @@ Logger::~Logger()
 
 void Logger::Message(LogLevel level, const char* sourceFile, const char* func, unsigned int line, const char* fmt, ...)
 {
-	if ( (GLOBAL_MIN_LOG_LEVEL == Logger::UNSET && level < _minLevel) // no global level, use level from logger
-	  || (GLOBAL_MIN_LOG_LEVEL > Logger::UNSET && level < GLOBAL_MIN_LOG_LEVEL) ) // global level set, use global level
+	if (!isLevelEnabled(level))
 		return;
 
-	const size_t max_msg_length = 1024;
-	char msg[max_msg_length];
 	va_list args;
 	va_start (args, fmt);
-	vsnprintf (msg, max_msg_length, fmt, args);
-	va_end (args);
 
-	auto repeatedSummary = [=]
+	// the message is formatted right into a preallocated record
+	LogWriter::getInstance()->post(level, [&](LogRecord& record)
 	{
-		Logger::T_LOG_MESSAGE repMsg = _repeatMessage;
-		repMsg.message = "Previous line repeats " + QString::number(_repeatCount) + " times";
-
-		emit newLogMessage(repMsg);
-
-		std::cout << QString("[" + repMsg.appName + " " + repMsg.loggerName + "] <" + LogLevelStrings[repMsg.level] + "> " + repMsg.message).toStdString() << std::endl;
-
-		if ( _syslogEnabled && repMsg.level >= Logger::WARNING )
-			syslog (LogLevelSysLog[repMsg.level], "Previous line repeats %d times", _repeatCount);
-
-		_repeatCount = 0;
-	};
+		vsnprintf (record.message, max_msg_length, fmt, args);
+
+		record.appName       = _appname;
+		record.loggerName    = _name;
+		record.sourceFile    = sourceFile;
+		record.function      = func;
+		record.line          = line;
+		time(&(record.utime));
+		record.level         = level;
+		record.syslogEnabled = _syslogEnabled;
+	});
 
-	if (_repeatMessage.loggerName == _name
-		&& _repeatMessage.function == QString(func)
-		&& _repeatMessage.line == line
-		&& _repeatMessage.message == QString(msg))
-	{
-		if (_repeatCount >= _maxRepeatCountSize)
-			repeatedSummary();
-		else
-			_repeatCount++;
-
-		return;
-	}
-	else
-	{
-		if (_repeatCount) repeatedSummary();
-
-		Logger::T_LOG_MESSAGE logMsg;
-
-		logMsg.appName     = _appname;
-		logMsg.loggerName  = _name;
-		logMsg.function    = QString(func);
-		logMsg.line        = line;
-		logMsg.fileName    = FileUtils::getBaseName(sourceFile);
-		time(&(logMsg.utime));
-		logMsg.message     = QString(msg);
-		logMsg.level       = level;
-		logMsg.levelString = LogLevelStrings[level];
-
-		emit newLogMessage(logMsg);
-
-		QString location;
-		if ( level == Logger::DEBUG )
-		{
-			location = "<" + logMsg.fileName + ":" + QString::number(line)+":"+ logMsg.function + "()> ";
-		}
-
-		std::cout << QString("[" + _appname + " " + _name + "] <" + LogLevelStrings[level] + "> " + location + msg).toStdString() << std::endl;
-
-		if ( _syslogEnabled && level >= Logger::WARNING )
-			syslog (LogLevelSysLog[level], "%s", msg);
-
-		_repeatMessage = logMsg;
-	}
+	va_end (args);
 }
 
 LoggerManager::LoggerManager()
 	: QObject()
+	, _logMessageBufferPos(0)
 	, _loggerMaxMsgBufferSize(200)
 {
+	_logMessageBuffer.reserve(_loggerMaxMsgBufferSize);
 }
 
 void LoggerManager::handleNewLogMessage(const Logger::T_LOG_MESSAGE &msg)
 {
-	_logMessageBuffer.append(msg);
-	if (_logMessageBuffer.length() > _loggerMaxMsgBufferSize)
 	{
-		_logMessageBuffer.erase(_logMessageBuffer.begin());
+		QMutexLocker lock(&_logMessageBufferMutex);
+		if (_logMessageBuffer.length() < _loggerMaxMsgBufferSize)
+		{
+			_logMessageBuffer.append(msg);
+		}
+		else
+		{
+			// overwrite the oldest entry
+			_logMessageBuffer[_logMessageBufferPos] = msg;
+			_logMessageBufferPos = (_logMessageBufferPos + 1) % _loggerMaxMsgBufferSize;
+		}
 	}
 
 	emit newLogMessage(msg);
 }
 
+QVector<Logger::T_LOG_MESSAGE> LoggerManager::getLogMessageBuffer()
+{
+	QMutexLocker lock(&_logMessageBufferMutex);
+
+	QVector<Logger::T_LOG_MESSAGE> messages;
+	messages.reserve(_logMessageBuffer.length());
+	for (int i = 0; i < _logMessageBuffer.length(); i++)
+	{
+		messages.append(_logMessageBuffer.at((_logMessageBufferPos + i) % _logMessageBuffer.length()));
+	}
+	return messages;
+}
+
 LoggerManager* LoggerManager::getInstance()
 {
 	if ( _instance == nullptr )
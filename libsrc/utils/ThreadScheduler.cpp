@@ -0,0 +1,225 @@
+#include <utils/ThreadScheduler.h>
+#include <utils/Logger.h>
+
+// qt
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <QStringList>
+
+#ifdef Q_OS_UNIX
+	#include <pthread.h>
+	#include <sched.h>
+	#include <errno.h>
+	#include <string.h>
+#endif
+
+#ifdef Q_OS_LINUX
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+namespace {
+
+///
+/// A registered thread with the scheduling state it was started with, used to restore it when a setting is reset
+///
+struct ManagedThread
+{
+	ThreadScheduler::Role role;
+	Qt::HANDLE threadId;
+	long tid;
+#ifdef Q_OS_UNIX
+	pthread_t handle;
+	int initialPolicy;
+	sched_param initialParam;
+#endif
+#ifdef Q_OS_LINUX
+	int initialNice;
+	cpu_set_t initialCpus;
+#endif
+};
+
+QMutex _threadsMutex;
+QJsonObject _config;
+QVector<ManagedThread> _threads;
+
+Logger* schedulerLog()
+{
+	return Logger::getInstance("SCHEDULER");
+}
+
+///
+/// @brief Parse a cpu list like "0,2-3" into cpu indexes
+/// @param list  The cpu list
+/// @param cpus  The parsed indexes
+/// @return      False if the list is malformed
+///
+bool parseCpuList(const QString& list, QVector<int>& cpus)
+{
+	for (const QString& part : list.split(',', QString::SkipEmptyParts))
+	{
+		const QStringList range = part.trimmed().split('-');
+		bool okFirst = false, okLast = true;
+		const int first = range.first().toInt(&okFirst);
+		const int last = (range.size() == 2) ? range.last().toInt(&okLast) : first;
+
+		if (!okFirst || !okLast || range.size() > 2 || first < 0 || last < first)
+			return false;
+
+		for (int cpu = first; cpu <= last; ++cpu)
+			cpus.append(cpu);
+	}
+	return true;
+}
+
+void applySettings(const ManagedThread& thread, const QJsonObject& config)
+{
+	Logger* log = schedulerLog();
+	const QString name = ThreadScheduler::roleToString(thread.role);
+	const QJsonObject roleConfig = config[name].toObject();
+
+	const QString policy = roleConfig["policy"].toString("default");
+	const int priority   = roleConfig["priority"].toInt(1);
+	const int niceness   = roleConfig["nice"].toInt(0);
+	const QString cpus   = roleConfig["cpus"].toString("").trimmed();
+
+#ifdef Q_OS_UNIX
+	int schedPolicy = thread.initialPolicy;
+	sched_param param = thread.initialParam;
+	if (policy == "fifo" || policy == "rr")
+	{
+		schedPolicy = (policy == "fifo") ? SCHED_FIFO : SCHED_RR;
+		param.sched_priority = qBound(sched_get_priority_min(schedPolicy), priority, sched_get_priority_max(schedPolicy));
+	}
+
+	int err = pthread_setschedparam(thread.handle, schedPolicy, &param);
+	if (err != 0)
+	{
+		Warning(log, "Thread '%s': Failed to set scheduling policy '%s' (priority %d), keep the current one: %s%s",
+			QSTRING_CSTR(name), QSTRING_CSTR(policy), priority, strerror(err),
+			(err == EPERM) ? ". Realtime scheduling requires CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO" : "");
+	}
+#endif
+
+#ifdef Q_OS_LINUX
+	// the niceness is a per thread attribute on linux when addressed by thread id, 0 keeps the value we were started with
+	const int targetNice = (niceness != 0) ? niceness : thread.initialNice;
+	if (setpriority(PRIO_PROCESS, id_t(thread.tid), targetNice) != 0)
+	{
+		err = errno;
+		Warning(log, "Thread '%s': Failed to set niceness %d, keep the current one: %s%s",
+			QSTRING_CSTR(name), targetNice, strerror(err),
+			(err == EACCES || err == EPERM) ? ". Lowering the niceness requires CAP_SYS_NICE or a sufficient RLIMIT_NICE" : "");
+	}
+
+	cpu_set_t cpuSet = thread.initialCpus;
+	if (!cpus.isEmpty())
+	{
+		QVector<int> cpuList;
+		const long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+		if (!parseCpuList(cpus, cpuList))
+		{
+			Warning(log, "Thread '%s': Invalid cpu list '%s', keep the current affinity", QSTRING_CSTR(name), QSTRING_CSTR(cpus));
+		}
+		else
+		{
+			CPU_ZERO(&cpuSet);
+			for (int cpu : cpuList)
+			{
+				if (cpu < cpuCount && cpu < CPU_SETSIZE)
+					CPU_SET(cpu, &cpuSet);
+				else
+					Warning(log, "Thread '%s': Ignore cpu %d, the system has %ld cpus", QSTRING_CSTR(name), cpu, cpuCount);
+			}
+			if (CPU_COUNT(&cpuSet) == 0)
+				cpuSet = thread.initialCpus;
+		}
+	}
+
+	err = pthread_setaffinity_np(thread.handle, sizeof(cpu_set_t), &cpuSet);
+	if (err != 0)
+	{
+		Warning(log, "Thread '%s': Failed to set cpu affinity '%s', keep the current one: %s", QSTRING_CSTR(name), QSTRING_CSTR(cpus), strerror(err));
+	}
+#else
+	if (niceness != 0 || !cpus.isEmpty())
+	{
+		Warning(log, "Thread '%s': Niceness and cpu affinity are not supported on this platform", QSTRING_CSTR(name));
+	}
+#endif
+
+	Debug(log, "Thread '%s' (%ld): policy %s, priority %d, nice %d, cpus '%s'", QSTRING_CSTR(name), thread.tid, QSTRING_CSTR(policy), priority, niceness, QSTRING_CSTR(cpus));
+}
+
+}
+
+void ThreadScheduler::setConfig(const QJsonObject& config)
+{
+	QMutexLocker lock(&_threadsMutex);
+	_config = config;
+
+	for (const ManagedThread& thread : _threads)
+		applySettings(thread, _config);
+}
+
+void ThreadScheduler::manageThread(QThread* thread, const Role& role)
+{
+	// functor connections without context are direct, so both run inside the managed thread
+	QObject::connect(thread, &QThread::started, [role]() { ThreadScheduler::registerCurrentThread(role); });
+	QObject::connect(thread, &QThread::finished, []() { ThreadScheduler::unregisterCurrentThread(); });
+}
+
+QString ThreadScheduler::roleToString(const Role& role)
+{
+	switch (role)
+	{
+		case CAPTURE:  return "capture";
+		case INSTANCE: return "instance";
+		case DEVICE:   return "device";
+		default:       return "invalid";
+	}
+}
+
+void ThreadScheduler::registerCurrentThread(const Role& role)
+{
+	ManagedThread thread;
+	thread.role = role;
+	thread.threadId = QThread::currentThreadId();
+	thread.tid = 0;
+
+#ifdef Q_OS_UNIX
+	thread.handle = pthread_self();
+	pthread_getschedparam(thread.handle, &thread.initialPolicy, &thread.initialParam);
+#endif
+
+#ifdef Q_OS_LINUX
+	thread.tid = syscall(SYS_gettid);
+	errno = 0;
+	thread.initialNice = getpriority(PRIO_PROCESS, id_t(thread.tid));
+	if (errno != 0)
+		thread.initialNice = 0;
+	CPU_ZERO(&thread.initialCpus);
+	pthread_getaffinity_np(thread.handle, sizeof(cpu_set_t), &thread.initialCpus);
+#endif
+
+	QMutexLocker lock(&_threadsMutex);
+	_threads.append(thread);
+	applySettings(thread, _config);
+}
+
+void ThreadScheduler::unregisterCurrentThread()
+{
+	QMutexLocker lock(&_threadsMutex);
+
+	for (int i = 0; i < _threads.size(); ++i)
+	{
+		if (_threads[i].threadId == QThread::currentThreadId())
+		{
+			_threads.removeAt(i);
+			return;
+		}
+	}
+}
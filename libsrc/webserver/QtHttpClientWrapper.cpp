@@ -162,7 +162,9 @@ void QtHttpClientWrapper::onClientDataReceived (void)
 							// disabling packet bunching
 							m_sockClient->setSocketOption(QAbstractSocket::LowDelayOption, 1);
 							m_sockClient->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
-							m_websocketClient = new WebSocketClient(m_currentRequest, m_sockClient, m_localConnection, this);
+							// negotiate the compression, the websocket client takes the ownership
+							WebSocketDeflate * deflate = WebSocketDeflate::negotiate(m_currentRequest->getHeader(QtHttpHeader::SecWebSocketExtensions), m_serverHandle->getWebSocketCompression());
+							m_websocketClient = new WebSocketClient(m_currentRequest, m_sockClient, m_localConnection, deflate, this);
 						}
 
 						break;
@@ -35,3 +35,4 @@ const QByteArray & QtHttpHeader::Upgrade              = QByteArrayLiteral ("Upgr
 const QByteArray & QtHttpHeader::SecWebSocketKey      = QByteArrayLiteral ("Sec-WebSocket-Key");
 const QByteArray & QtHttpHeader::SecWebSocketProtocol = QByteArrayLiteral ("Sec-WebSocket-Protocol");
 const QByteArray & QtHttpHeader::SecWebSocketVersion  = QByteArrayLiteral ("Sec-WebSocket-Version");
+const QByteArray & QtHttpHeader::SecWebSocketExtensions = QByteArrayLiteral ("Sec-WebSocket-Extensions");
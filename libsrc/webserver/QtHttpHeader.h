@@ -39,6 +39,7 @@ public:
 	static const QByteArray & SecWebSocketKey;
 	static const QByteArray & SecWebSocketProtocol;
 	static const QByteArray & SecWebSocketVersion;
+	static const QByteArray & SecWebSocketExtensions;
 };
 
 #endif // QTHTTPHEADER_H
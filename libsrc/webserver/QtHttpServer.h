@@ -11,6 +11,8 @@
 #include <QSslSocket>
 #include <QHostAddress>
 
+#include "WebSocketDeflate.h"
+
 class QTcpSocket;
 class QTcpServer;
 class QtHttpRequest;
@@ -52,6 +54,8 @@ public:
 	QString getErrorString (void) const { return m_sockServer->errorString(); };
 	bool    isListening()               { return m_sockServer->isListening(); };
 
+	const WebSocketDeflate::Settings & getWebSocketCompression (void) const { return m_wsCompression; };
+
 public slots:
 	void start           (quint16 port = 0);
 	void stop            (void);
@@ -59,6 +63,7 @@ public slots:
 	void setServerName   (const QString & serverName)           { m_serverName = serverName; };
 	void setPrivateKey   (const QSslKey & key)                  { m_sslKey = key; };
 	void setCertificates (const QList<QSslCertificate> & certs) { m_sslCerts = certs; };
+	void setWebSocketCompression (const WebSocketDeflate::Settings & settings) { m_wsCompression = settings; };
 
 signals:
 	void started            (quint16 port);
@@ -81,6 +86,7 @@ private:
 	QSslKey                                    m_sslKey;
 	QList<QSslCertificate>                     m_sslCerts;
 	QString                                    m_serverName;
+	WebSocketDeflate::Settings                 m_wsCompression;
 	NetOrigin*                                 m_netOrigin;
 	QtHttpServerWrapper *                      m_sockServer;
 	QHash<QTcpSocket *, QtHttpClientWrapper *> m_socksClientsHash;
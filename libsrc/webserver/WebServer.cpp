@@ -98,6 +98,13 @@ void WebServer::handleSettingsUpdate(const settings::type& type, const QJsonDocu
 		Debug(_log, "Set document root to: %s", _baseUrl.toUtf8().constData());
 		_staticFileServing->setBaseUrl(_baseUrl);
 
+		// websocket compression, applies to new connections
+		WebSocketDeflate::Settings compression;
+		compression.enabled         = obj["wsCompression"].toBool(compression.enabled);
+		compression.threshold       = obj["wsCompressionThreshold"].toInt(compression.threshold);
+		compression.contextTakeover = obj["wsCompressionContextTakeover"].toBool(compression.contextTakeover);
+		_server->setWebSocketCompression(compression);
+
 		if(_port != obj["port"].toInt(WEBSERVER_DEFAULT_PORT))
 		{
 			_port = obj["port"].toInt(WEBSERVER_DEFAULT_PORT);
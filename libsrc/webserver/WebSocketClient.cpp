@@ -5,15 +5,18 @@
 #include <hyperion/Hyperion.h>
 #include <api/JsonAPI.h>
 
+#include <cstring>
+
 #include <QTcpSocket>
 #include <QtEndian>
 #include <QCryptographicHash>
 #include <QJsonObject>
 
-WebSocketClient::WebSocketClient(QtHttpRequest* request, QTcpSocket* sock, const bool& localConnection, QObject* parent)
+WebSocketClient::WebSocketClient(QtHttpRequest* request, QTcpSocket* sock, const bool& localConnection, WebSocketDeflate* deflate, QObject* parent)
 	: QObject(parent)
 	, _socket(sock)
 	, _log(Logger::getInstance("WEBSOCKET"))
+	, _deflate(deflate)
 {
 	// connect socket; disconnect handled from QtHttpServer
 	connect(_socket, &QTcpSocket::readyRead , this, &WebSocketClient::handleWebSocketFrame);
@@ -25,6 +28,7 @@ WebSocketClient::WebSocketClient(QtHttpRequest* request, QTcpSocket* sock, const
 	// Json processor
 	_jsonAPI = new JsonAPI(client, _log, localConnection, this);
 	connect(_jsonAPI, &JsonAPI::callbackMessage, this, &WebSocketClient::sendMessage);
+	connect(_jsonAPI, &JsonAPI::callbackData, this, &WebSocketClient::sendData);
 
 	Debug(_log, "New connection from %s", QSTRING_CSTR(client));
 
@@ -36,7 +40,14 @@ WebSocketClient::WebSocketClient(QtHttpRequest* request, QTcpSocket* sock, const
 		= QString("HTTP/1.1 101 Switching Protocols\r\n")
 		+ QString("Upgrade: websocket\r\n")
 		+ QString("Connection: Upgrade\r\n")
-		+ QString("Sec-WebSocket-Accept: ")+QString(hash.data()) + "\r\n\r\n";
+		+ QString("Sec-WebSocket-Accept: ")+QString(hash.data()) + "\r\n";
+
+	if (_deflate)
+	{
+		Debug(_log, "Compression negotiated: %s", _deflate->getResponse().constData());
+		data += QString("Sec-WebSocket-Extensions: ") + QString(_deflate->getResponse()) + "\r\n";
+	}
+	data += "\r\n";
 
 	_socket->write(QSTRING_CSTR(data), data.size());
 	_socket->flush();
@@ -94,10 +105,21 @@ void WebSocketClient::handleWebSocketFrame(void)
 					return;
 				}
 
+				// only the first frame of a compressed message has RSV1 set
+				if (_wsh.rsv1 && (!_deflate || isContinuation))
+				{
+					sendClose(CLOSECODE::VIOLATION, "protocol violation, unexpected RSV1 bit");
+					return;
+				}
+				if (!isContinuation)
+				{
+					_compressedMessage = _wsh.rsv1;
+				}
+
 				// unmask data
-				for (int i=0; i < buf.size(); i++)
+				if (_wsh.masked)
 				{
-					buf[i] = buf[i] ^ _wsh.key[i % 4];
+					unmask(buf.data(), buf.size(), _wsh.key);
 				}
 
 				_onContinuation = !_wsh.fin || isContinuation;
@@ -113,10 +135,26 @@ void WebSocketClient::handleWebSocketFrame(void)
 				if (_wsh.fin)
 				{
 					_onContinuation = false;
+					if (_compressedMessage)
+					{
+						const WebSocketDeflate::DecompressResult result = _deflate->decompress(_wsReceiveBuffer, _deflateBuffer);
+						if (result == WebSocketDeflate::DECOMPRESS_TOO_LARGE)
+						{
+							sendClose(CLOSECODE::BIG_MSG, "decompressed message too big");
+							return;
+						}
+						if (result != WebSocketDeflate::DECOMPRESS_OK)
+						{
+							sendClose(CLOSECODE::INV_DATA, "invalid compressed data");
+							return;
+						}
+						_wsReceiveBuffer.swap(_deflateBuffer);
+						_compressedMessage = false;
+					}
 				if (_wsh.opCode == OPCODE::TEXT)
 				{
 
-						_jsonAPI->handleMessage(QString(_wsReceiveBuffer));
+						_jsonAPI->handleMessage(_wsReceiveBuffer);
 				}
 				else
 				{
@@ -136,9 +174,10 @@ void WebSocketClient::handleWebSocketFrame(void)
 
 			case OPCODE::PING:
 				{
-					// ping received, send pong
-					quint8 pong[] = {OPCODE::PONG, 0};
-					_socket->write((const char*)pong, 2);
+					// ping received, send pong with the application data of the ping behind the pending messages (RFC 6455 5.5.3)
+					appendFrameHeader(_sendBuffer, OPCODE::PONG, buf.size(), true);
+					_sendBuffer.append(buf);
+					flushSendBuffer();
 					_socket->flush();
 				}
 				break;
@@ -161,6 +200,7 @@ void WebSocketClient::getWsFrameHeader(WebSocketHeader* header)
 	_socket->getChar(&mask_length);
 
 	header->fin    = (fin_rsv_opcode & BHB0_FIN) == BHB0_FIN;
+	header->rsv1   = (fin_rsv_opcode & BHB0_RSV1) == BHB0_RSV1;
 	header->opCode = fin_rsv_opcode  & BHB0_OPCODE;
 	header->masked = (mask_length & BHB1_MASK) == BHB1_MASK;
 	header->payloadLength = mask_length  & BHB1_PAYLOAD;
@@ -200,6 +240,10 @@ void WebSocketClient::sendClose(int status, QString reason)
 	Debug(_log, "send close: %d %s", status, QSTRING_CSTR(reason));
 	ErrorIf(!reason.isEmpty(), _log, QSTRING_CSTR(reason));
 	_receiveBuffer.clear();
+
+	// the close frame is the last one
+	flushSendBuffer();
+
 	QByteArray sendBuffer;
 
 	sendBuffer.append(136+(status-1000));
@@ -244,7 +288,7 @@ void WebSocketClient::handleBinaryMessage(QByteArray &data)
 	Image<ColorRgb> image;
 	image.resize(width, height);
 
-	memcpy(image.memptr(), data.data()+4, imgSize);
+	image.copyFrom(data.data()+4);
 	//_hyperion->registerInput();
 	//_hyperion->setInputImage(priority, image, duration_s*1000);
 }
@@ -252,46 +296,70 @@ void WebSocketClient::handleBinaryMessage(QByteArray &data)
 
 qint64 WebSocketClient::sendMessage(QJsonObject obj)
 {
+	if (!_socket || (_socket->state() != QAbstractSocket::ConnectedState)) return 0;
+
 	QJsonDocument writer(obj);
-	QByteArray data = writer.toJson(QJsonDocument::Compact) + "\n";
+	return sendData(writer.toJson(QJsonDocument::Compact) + "\n");
+}
 
+qint64 WebSocketClient::sendData(const QByteArray& data)
+{
 	if (!_socket || (_socket->state() != QAbstractSocket::ConnectedState)) return 0;
 
-	qint64 payloadWritten = 0;
-	quint32 payloadSize   = data.size();
-	const char * payload  = data.data();
+	// small messages aren't worth the compression
+	const bool compressed = _deflate && _deflate->shouldCompress(data.size()) && _deflate->compress(data, _deflateBuffer);
+	const QByteArray& message = compressed ? _deflateBuffer : data;
+
+	const quint64 payloadSize = message.size();
+	const char * payload      = message.constData();
 
-	qint32 numFrames = payloadSize / FRAME_SIZE_IN_BYTES + ((quint64(payloadSize) % FRAME_SIZE_IN_BYTES) > 0 ? 1 : 0);
+	// header and payload of all frames are gathered into the send buffer, all messages of this event loop turn are written at once
+	const quint64 numFrames = payloadSize / FRAME_SIZE_IN_BYTES + ((payloadSize % FRAME_SIZE_IN_BYTES) > 0 ? 1 : 0);
+	_sendBuffer.reserve(_sendBuffer.size() + int(payloadSize + numFrames * 10));
 
-	for (int i = 0; i < numFrames; ++i)
+	for (quint64 i = 0; i < numFrames; ++i)
 	{
 		const bool isLastFrame = (i == (numFrames - 1));
 
-		quint64 position  = i * FRAME_SIZE_IN_BYTES;
-		quint32 frameSize = (payloadSize-position >= FRAME_SIZE_IN_BYTES) ? FRAME_SIZE_IN_BYTES : (payloadSize-position);
+		const quint64 position  = i * FRAME_SIZE_IN_BYTES;
+		const quint64 frameSize = (payloadSize - position >= FRAME_SIZE_IN_BYTES) ? FRAME_SIZE_IN_BYTES : (payloadSize - position);
 
-		QByteArray buf = makeFrameHeader(OPCODE::TEXT, frameSize, isLastFrame);
-		sendMessage_Raw(buf);
+		// only the first frame carries the opcode, the others are continuations
+		appendFrameHeader(_sendBuffer, (i == 0) ? OPCODE::TEXT : OPCODE::CONTINUATION, frameSize, isLastFrame, compressed && i == 0);
+		_sendBuffer.append(payload + position, int(frameSize));
+	}
 
-		qint64 written = sendMessage_Raw(payload+position,frameSize);
-		if (written > 0)
-		{
-			payloadWritten += written;
-		}
-		else
-		{
-			_socket->flush();
-			Error(_log, "Error writing bytes to socket: %s", QSTRING_CSTR(_socket->errorString()));
-			break;
-		}
+	if (!_flushPending)
+	{
+		_flushPending = true;
+		QMetaObject::invokeMethod(this, "flushSendBuffer", Qt::QueuedConnection);
+	}
+
+	return payloadSize;
+}
+
+void WebSocketClient::flushSendBuffer()
+{
+	_flushPending = false;
+	if (_sendBuffer.isEmpty())
+	{
+		return;
+	}
+
+	if (!_socket || (_socket->state() != QAbstractSocket::ConnectedState))
+	{
+		_sendBuffer.clear();
+		return;
 	}
 
-	if (payloadSize != payloadWritten)
+	const qint64 written = sendMessage_Raw(_sendBuffer);
+	if (written != _sendBuffer.size())
 	{
-		Error(_log, "Error writing bytes to socket %d bytes from %d written", payloadWritten, payloadSize);
-		return -1;
+		Error(_log, "Error writing bytes to socket %lld bytes from %d written: %s", written, _sendBuffer.size(), QSTRING_CSTR(_socket->errorString()));
 	}
-	return payloadWritten;
+
+	// keeps the capacity for the next turn
+	_sendBuffer.resize(0);
 }
 
 qint64 WebSocketClient::sendMessage_Raw(const char* data, quint64 size)
@@ -305,41 +373,60 @@ qint64 WebSocketClient::sendMessage_Raw(QByteArray &data)
 }
 
 
-QByteArray WebSocketClient::makeFrameHeader(quint8 opCode, quint64 payloadLength, bool lastFrame)
+void WebSocketClient::appendFrameHeader(QByteArray& buffer, quint8 opCode, quint64 payloadLength, bool lastFrame, bool compressed)
 {
-	QByteArray header;
-
 	if (payloadLength <= 0x7FFFFFFFFFFFFFFFULL)
 	{
-		//FIN, RSV1-3, opcode (RSV-1, RSV-2 and RSV-3 are zero)
-		quint8 byte = static_cast<quint8>((opCode & 0x0F) | (lastFrame ? 0x80 : 0x00));
-		header.append(static_cast<char>(byte));
+		//FIN, RSV1-3, opcode (RSV-1 marks a compressed message, RSV-2 and RSV-3 are zero)
+		quint8 byte = static_cast<quint8>((opCode & 0x0F) | (lastFrame ? 0x80 : 0x00) | (compressed ? BHB0_RSV1 : 0x00));
+		buffer.append(static_cast<char>(byte));
 
 		byte = 0x00;
 		if (payloadLength <= 125)
 		{
 			byte |= static_cast<quint8>(payloadLength);
-			header.append(static_cast<char>(byte));
+			buffer.append(static_cast<char>(byte));
 		}
 		else if (payloadLength <= 0xFFFFU)
 		{
 			byte |= 126;
-			header.append(static_cast<char>(byte));
+			buffer.append(static_cast<char>(byte));
 			quint16 swapped = qToBigEndian<quint16>(static_cast<quint16>(payloadLength));
-			header.append(static_cast<const char *>(static_cast<const void *>(&swapped)), 2);
+			buffer.append(static_cast<const char *>(static_cast<const void *>(&swapped)), 2);
 		}
 		else
 		{
 			byte |= 127;
-			header.append(static_cast<char>(byte));
+			buffer.append(static_cast<char>(byte));
 			quint64 swapped = qToBigEndian<quint64>(payloadLength);
-			header.append(static_cast<const char *>(static_cast<const void *>(&swapped)), 8);
+			buffer.append(static_cast<const char *>(static_cast<const void *>(&swapped)), 8);
 		}
 	}
 	else
 	{
 		Error(_log, "Payload too big!");
 	}
+}
 
-	return header;
+void WebSocketClient::unmask(char* data, quint64 size, const char key[4])
+{
+	// the key repeats every 4 bytes from the start of the payload, so it's applied to 8 bytes at once.
+	// memcpy keeps the byte order of the key and avoids unaligned access, the compiler turns it into plain loads
+	quint64 wideKey;
+	memcpy(&wideKey, key, 4);
+	memcpy(reinterpret_cast<char*>(&wideKey) + 4, key, 4);
+
+	quint64 i = 0;
+	for (; i + sizeof(wideKey) <= size; i += sizeof(wideKey))
+	{
+		quint64 word;
+		memcpy(&word, data + i, sizeof(word));
+		word ^= wideKey;
+		memcpy(data + i, &word, sizeof(word));
+	}
+
+	for (; i < size; ++i)
+	{
+		data[i] ^= key[i % 4];
+	}
 }
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <memory>
+
 #include <utils/Logger.h>
 #include "WebSocketUtils.h"
+#include "WebSocketDeflate.h"
 
 class QTcpSocket;
 
@@ -12,11 +15,19 @@ class JsonAPI;
 class WebSocketClient : public QObject {
 	Q_OBJECT
 public:
-	WebSocketClient(QtHttpRequest* request, QTcpSocket* sock, const bool& localConnection, QObject* parent);
+	///
+	/// @param request          The upgrade request
+	/// @param sock             The socket of the connection
+	/// @param localConnection  True if the client is in the local network
+	/// @param deflate          The negotiated permessage-deflate extension, nullptr if messages aren't compressed. The client takes the ownership
+	/// @param parent           The parent
+	///
+	WebSocketClient(QtHttpRequest* request, QTcpSocket* sock, const bool& localConnection, WebSocketDeflate* deflate, QObject* parent);
 
 	struct WebSocketHeader
 	{
 		bool          fin;
+		bool          rsv1;
 		quint8        opCode;
 		bool          masked;
 		quint64       payloadLength;
@@ -34,7 +45,21 @@ private:
 	void handleBinaryMessage(QByteArray &data);
 	qint64 sendMessage_Raw(const char* data, quint64 size);
 	qint64 sendMessage_Raw(QByteArray &data);
-	QByteArray makeFrameHeader(quint8 opCode, quint64 payloadLength, bool lastFrame);
+	void appendFrameHeader(QByteArray& buffer, quint8 opCode, quint64 payloadLength, bool lastFrame, bool compressed = false);
+
+	///
+	/// @brief Unmask the payload of a frame in place, a machine word at a time
+	///
+	/// @param data  The payload
+	/// @param size  The size of the payload in bytes
+	/// @param key   The masking key of the frame
+	///
+	static void unmask(char* data, quint64 size, const char key[4]);
+
+	/// The frames of all messages sent within the current event loop turn, they are written to the socket at once
+	QByteArray _sendBuffer;
+	/// True if a write of _sendBuffer is scheduled
+	bool _flushPending = false;
 
 	/// The buffer used for reading data from the socket
 	QByteArray _receiveBuffer;
@@ -45,6 +70,13 @@ private:
 
 	bool _onContinuation = false;
 
+	/// The permessage-deflate extension, empty if it wasn't negotiated
+	std::unique_ptr<WebSocketDeflate> _deflate;
+	/// True if the message being received is compressed
+	bool _compressedMessage = false;
+	/// The buffer for compressed messages
+	QByteArray _deflateBuffer;
+
 	// true when data is missing for parsing
 	bool _notEnoughData = false;
 
@@ -68,5 +100,23 @@ private:
 
 private slots:
 	void handleWebSocketFrame(void);
+
+	///
+	/// @brief Send a message as text message
+	/// @param obj  The message
+	/// @return The size of the queued payload, it's written with the next flush of the send buffer, so write errors aren't reported
+	///
 	qint64 sendMessage(QJsonObject obj);
+
+	///
+	/// @brief Send a serialized message as text message
+	/// @param data  The message
+	/// @return The size of the queued payload, it's written with the next flush of the send buffer, so write errors aren't reported
+	///
+	qint64 sendData(const QByteArray& data);
+
+	///
+	/// @brief Write the pending frames to the socket
+	///
+	void flushSendBuffer();
 };
@@ -0,0 +1,252 @@
+#include "WebSocketDeflate.h"
+
+#include <QList>
+
+const int WebSocketDeflate::MAX_MESSAGE_SIZE;
+
+#ifdef HAVE_ZLIB
+namespace
+{
+	/// The empty deflate block which terminates every message, it's removed by the sender and restored by the receiver
+	const char EMPTY_BLOCK[] = { '\x00', '\x00', '\xff', '\xff' };
+
+	/// Parse the value of a window bits parameter, returns false if it is invalid
+	bool parseWindowBits(const QByteArray& value, const bool optional, const int minimum, int& bits)
+	{
+		QByteArray raw = value.trimmed();
+		if (raw.startsWith('"') && raw.endsWith('"') && raw.size() >= 2)
+		{
+			raw = raw.mid(1, raw.size() - 2);
+		}
+
+		if (raw.isEmpty())
+		{
+			return optional;
+		}
+
+		bool ok = false;
+		bits = raw.toInt(&ok);
+		return ok && bits >= minimum && bits <= 15;
+	}
+}
+#endif
+
+WebSocketDeflate* WebSocketDeflate::negotiate(const QByteArray& offers, const Settings& settings)
+{
+#ifdef HAVE_ZLIB
+	if (!settings.enabled)
+	{
+		return nullptr;
+	}
+
+	// the client lists its offers by preference, accept the first one which is valid
+	for (const QByteArray& offer : offers.split(','))
+	{
+		QList<QByteArray> params = offer.split(';');
+		if (params.takeFirst().trimmed() != "permessage-deflate")
+		{
+			continue;
+		}
+
+		bool valid = true;
+		bool serverNoContextTakeover = !settings.contextTakeover;
+		bool clientNoContextTakeover = !settings.contextTakeover;
+		int serverWindowBits = 0;
+
+		for (const QByteArray& param : params)
+		{
+			const int pos = param.indexOf('=');
+			const QByteArray name  = param.left(pos).trimmed();
+			const QByteArray value = (pos < 0) ? QByteArray() : param.mid(pos + 1);
+			int bits = 0;
+
+			if (name == "server_no_context_takeover" && pos < 0)
+			{
+				serverNoContextTakeover = true;
+			}
+			else if (name == "client_no_context_takeover" && pos < 0)
+			{
+				clientNoContextTakeover = true;
+			}
+			else if (name == "server_max_window_bits" && parseWindowBits(value, false, 9, bits))
+			{
+				// zlib doesn't support a raw deflate window of 8 bits, so such an offer is declined
+				serverWindowBits = bits;
+			}
+			else if (name == "client_max_window_bits" && parseWindowBits(value, true, 8, bits))
+			{
+				// the decompression works with any window of the client
+			}
+			else
+			{
+				valid = false;
+				break;
+			}
+		}
+
+		if (!valid)
+		{
+			continue;
+		}
+
+		WebSocketDeflate* deflate = new WebSocketDeflate(settings.threshold, !serverNoContextTakeover, (serverWindowBits > 0) ? serverWindowBits : 15);
+		if (!deflate->_deflateReady || !deflate->_inflateReady)
+		{
+			delete deflate;
+			return nullptr;
+		}
+
+		deflate->_response = "permessage-deflate";
+		if (serverNoContextTakeover)
+		{
+			deflate->_response += "; server_no_context_takeover";
+		}
+		if (clientNoContextTakeover)
+		{
+			deflate->_response += "; client_no_context_takeover";
+		}
+		if (serverWindowBits > 0)
+		{
+			deflate->_response += "; server_max_window_bits=" + QByteArray::number(serverWindowBits);
+		}
+
+		return deflate;
+	}
+#else
+	Q_UNUSED(offers);
+	Q_UNUSED(settings);
+#endif
+
+	return nullptr;
+}
+
+WebSocketDeflate::WebSocketDeflate(int threshold, bool serverContextTakeover, int serverWindowBits)
+	: _response()
+	, _threshold(threshold)
+	, _serverContextTakeover(serverContextTakeover)
+{
+#ifdef HAVE_ZLIB
+	_deflate = z_stream();
+	_inflate = z_stream();
+
+	// negative window bits select raw deflate data without zlib header and checksum
+	_deflateReady = deflateInit2(&_deflate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -serverWindowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+	_inflateReady = inflateInit2(&_inflate, -15) == Z_OK;
+#else
+	Q_UNUSED(serverWindowBits);
+#endif
+}
+
+WebSocketDeflate::~WebSocketDeflate()
+{
+#ifdef HAVE_ZLIB
+	if (_deflateReady)
+	{
+		deflateEnd(&_deflate);
+	}
+	if (_inflateReady)
+	{
+		inflateEnd(&_inflate);
+	}
+#endif
+}
+
+bool WebSocketDeflate::compress(const QByteArray& data, QByteArray& out)
+{
+#ifdef HAVE_ZLIB
+	_deflate.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+	_deflate.avail_in = uInt(data.size());
+
+	// the sync flush ends the output at a byte boundary with an empty block, so the message is complete
+	int written = 0;
+	out.resize(int(deflateBound(&_deflate, uLong(data.size()))) + 16);
+	do
+	{
+		if (written == out.size())
+		{
+			out.resize(out.size() * 2);
+		}
+
+		_deflate.next_out  = reinterpret_cast<Bytef*>(out.data() + written);
+		_deflate.avail_out = uInt(out.size() - written);
+		if (deflate(&_deflate, Z_SYNC_FLUSH) == Z_STREAM_ERROR)
+		{
+			return false;
+		}
+		written = out.size() - int(_deflate.avail_out);
+	}
+	while (_deflate.avail_out == 0);
+
+	out.resize(written);
+	if (out.endsWith(QByteArray::fromRawData(EMPTY_BLOCK, sizeof(EMPTY_BLOCK))))
+	{
+		out.chop(sizeof(EMPTY_BLOCK));
+	}
+
+	if (!_serverContextTakeover)
+	{
+		deflateReset(&_deflate);
+	}
+
+	return true;
+#else
+	Q_UNUSED(data);
+	Q_UNUSED(out);
+	return false;
+#endif
+}
+
+WebSocketDeflate::DecompressResult WebSocketDeflate::decompress(QByteArray& data, QByteArray& out)
+{
+#ifdef HAVE_ZLIB
+	data.append(EMPTY_BLOCK, sizeof(EMPTY_BLOCK));
+	_inflate.next_in  = reinterpret_cast<Bytef*>(data.data());
+	_inflate.avail_in = uInt(data.size());
+
+	// the buffer holds one byte more than allowed, so a message which fills it is too large
+	int written = 0;
+	out.resize(qMin(qMax(qMin(data.size(), MAX_MESSAGE_SIZE / 4) * 4, 4096), MAX_MESSAGE_SIZE + 1));
+	do
+	{
+		if (written == out.size())
+		{
+			if (written > MAX_MESSAGE_SIZE)
+			{
+				out.clear();
+				return DECOMPRESS_TOO_LARGE;
+			}
+			out.resize(qMin(out.size() * 2, MAX_MESSAGE_SIZE + 1));
+		}
+
+		_inflate.next_out  = reinterpret_cast<Bytef*>(out.data() + written);
+		_inflate.avail_out = uInt(out.size() - written);
+		const int result = inflate(&_inflate, Z_SYNC_FLUSH);
+		written = out.size() - int(_inflate.avail_out);
+
+		if (result == Z_STREAM_END)
+		{
+			// the client finished the stream with a final block, the next message starts a new one
+			inflateReset(&_inflate);
+			break;
+		}
+		if (result != Z_OK && result != Z_BUF_ERROR)
+		{
+			return DECOMPRESS_INVALID;
+		}
+	}
+	while (_inflate.avail_out == 0);
+
+	if (written > MAX_MESSAGE_SIZE)
+	{
+		out.clear();
+		return DECOMPRESS_TOO_LARGE;
+	}
+
+	out.resize(written);
+	return DECOMPRESS_OK;
+#else
+	Q_UNUSED(data);
+	Q_UNUSED(out);
+	return DECOMPRESS_INVALID;
+#endif
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QByteArray>
+
+#ifdef HAVE_ZLIB
+	#include <zlib.h>
+#endif
+
+///
+/// @brief The permessage-deflate extension (RFC 7692) of a websocket connection.
+/// It's negotiated during the upgrade and compresses the outgoing and decompresses the incoming messages.
+/// Without zlib at build time the extension is never negotiated.
+///
+class WebSocketDeflate
+{
+public:
+	///
+	/// The compression settings of the webserver
+	///
+	struct Settings
+	{
+		/// Offer the compression to the clients
+		bool enabled = true;
+		/// Messages smaller than this (in bytes) are sent uncompressed
+		int threshold = 1024;
+		/// Keep the compression context between messages, which compresses better but keeps 256KB per connection
+		bool contextTakeover = true;
+	};
+
+	///
+	/// The result of a decompression
+	///
+	enum DecompressResult
+	{
+		DECOMPRESS_OK,
+		/// the data isn't valid deflate data
+		DECOMPRESS_INVALID,
+		/// the message exceeds MAX_MESSAGE_SIZE
+		DECOMPRESS_TOO_LARGE
+	};
+
+	/// The maximum size of a decompressed message, a few KB of deflate data could inflate to gigabytes otherwise.
+	/// It's enough for a base64 encoded 1080p image command
+	static const int MAX_MESSAGE_SIZE = 32 * 1024 * 1024;
+
+	///
+	/// @brief Negotiate the extension with the offers of a client
+	///
+	/// @param offers    The value of the Sec-WebSocket-Extensions request header
+	/// @param settings  The compression settings
+	///
+	/// @return The extension of the connection, nullptr if no offer was accepted. The caller takes the ownership
+	///
+	static WebSocketDeflate* negotiate(const QByteArray& offers, const Settings& settings);
+
+	~WebSocketDeflate();
+
+	///
+	/// @return The value of the Sec-WebSocket-Extensions response header
+	///
+	const QByteArray& getResponse() const { return _response; }
+
+	///
+	/// @brief Check if a message should be compressed
+	///
+	/// @param size  The size of the message in bytes
+	///
+	bool shouldCompress(int size) const { return size >= _threshold; }
+
+	///
+	/// @brief Compress the payload of an outgoing message
+	///
+	/// @param data        The payload
+	/// @param[out] out    The compressed payload
+	///
+	/// @return True on success
+	///
+	bool compress(const QByteArray& data, QByteArray& out);
+
+	///
+	/// @brief Decompress the payload of an incoming message, which has the RSV1 bit set
+	///
+	/// @param data        The compressed payload, the empty deflate block is appended to it
+	/// @param[out] out    The payload
+	///
+	/// @return DECOMPRESS_OK on success
+	///
+	DecompressResult decompress(QByteArray& data, QByteArray& out);
+
+private:
+	WebSocketDeflate(int threshold, bool serverContextTakeover, int serverWindowBits);
+
+	/// The value of the Sec-WebSocket-Extensions response header
+	QByteArray _response;
+	/// Messages smaller than this are sent uncompressed
+	int _threshold;
+	/// Keep the compression context between outgoing messages
+	bool _serverContextTakeover;
+
+#ifdef HAVE_ZLIB
+	z_stream _deflate;
+	z_stream _inflate;
+	bool _deflateReady = false;
+	bool _inflateReady = false;
+#endif
+};
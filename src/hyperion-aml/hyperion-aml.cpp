@@ -19,7 +19,7 @@ using namespace commandline;
 void saveScreenshot(QString filename, const Image<ColorRgb> & image)
 {
 	// store as PNG
-	QImage pngImage((const uint8_t *) image.memptr(), image.width(), image.height(), 3*image.width(), QImage::Format_RGB888);
+	QImage pngImage((const uint8_t *) image.memptr(), image.width(), image.height(), image.stride(), QImage::Format_RGB888);
 	pngImage.save(filename);
 }
 
@@ -21,7 +21,7 @@ void ScreenshotHandler::receiveImage(const Image<ColorRgb> & image)
 {
 	findNoSignalSettings(image);
 	// store as PNG
-	QImage pngImage((const uint8_t *) image.memptr(), image.width(), image.height(), 3*image.width(), QImage::Format_RGB888);
+	QImage pngImage((const uint8_t *) image.memptr(), image.width(), image.height(), image.stride(), QImage::Format_RGB888);
 	pngImage.save(_filename);
 
 	// Quit the application after the first image
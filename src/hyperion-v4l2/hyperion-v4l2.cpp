@@ -52,7 +52,7 @@ int main(int argc, char** argv)
 
 		Option             & argDevice              = parser.add<Option>       ('d', "device", "The device to use, can be /dev/video0 [default: %1 (auto detected)]", "auto");
 		SwitchOption<VideoStandard> & argVideoStandard= parser.add<SwitchOption<VideoStandard>>('v', "video-standard", "The used video standard. Valid values are PAL, NTSC, SECAM or no-change. [default: %1]", "no-change");
-		SwitchOption<PixelFormat> & argPixelFormat    = parser.add<SwitchOption<PixelFormat>>  (0x0, "pixel-format", "The use pixel format. Valid values are YUYV, UYVY, RGB32, MJPEG or no-change. [default: %1]", "no-change");
+		SwitchOption<PixelFormat> & argPixelFormat    = parser.add<SwitchOption<PixelFormat>>  (0x0, "pixel-format", "The use pixel format. Valid values are YUYV, UYVY, NV12, NV21, I420, YV12, GREY, RGB565, RGB24, BGR24, RGB32, MJPEG or no-change. [default: %1]", "no-change");
 		IntOption          & argCropWidth           = parser.add<IntOption>    (0x0, "crop-width", "Number of pixels to crop from the left and right sides of the picture before decimation [default: %1]", "0");
 		IntOption          & argCropHeight          = parser.add<IntOption>    (0x0, "crop-height", "Number of pixels to crop from the top and the bottom of the picture before decimation [default: %1]", "0");
 		IntOption          & argCropLeft            = parser.add<IntOption>    (0x0, "crop-left", "Number of pixels to crop from the left of the picture before decimation (overrides --crop-width)");
@@ -87,6 +87,14 @@ int main(int argc, char** argv)
 
 		argPixelFormat.addSwitch("yuyv", PIXELFORMAT_YUYV);
 		argPixelFormat.addSwitch("uyvy", PIXELFORMAT_UYVY);
+		argPixelFormat.addSwitch("nv12", PIXELFORMAT_NV12);
+		argPixelFormat.addSwitch("nv21", PIXELFORMAT_NV21);
+		argPixelFormat.addSwitch("i420", PIXELFORMAT_I420);
+		argPixelFormat.addSwitch("yv12", PIXELFORMAT_YV12);
+		argPixelFormat.addSwitch("grey", PIXELFORMAT_GREY);
+		argPixelFormat.addSwitch("rgb565", PIXELFORMAT_BGR16);
+		argPixelFormat.addSwitch("rgb24", PIXELFORMAT_RGB24);
+		argPixelFormat.addSwitch("bgr24", PIXELFORMAT_BGR24);
 		argPixelFormat.addSwitch("rgb32", PIXELFORMAT_RGB32);
 #ifdef HAVE_JPEG
 		argPixelFormat.addSwitch("mjpeg", PIXELFORMAT_MJPEG);
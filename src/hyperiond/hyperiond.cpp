@@ -17,6 +17,10 @@
 
 #include <utils/Components.h>
 #include <utils/JsonUtils.h>
+#include <utils/ThreadScheduler.h>
+#include <utils/hyperion.h>
+
+#include <hyperion/GrabberWrapper.h>
 
 // bonjour browser
 #include <bonjour/bonjourbrowserwrapper.h>
@@ -73,6 +77,8 @@ HyperionDaemon::HyperionDaemon(const QString rootPath, QObject *parent, const bo
 	, _osxGrabber(nullptr)
 	, _qtGrabber(nullptr)
 	, _ssdp(nullptr)
+	, _flatBufferServer(nullptr)
+	, _protoServer(nullptr)
 	, _currVideoMode(VIDEO_2D)
 {
 	HyperionDaemon::daemon = this;
@@ -92,6 +98,9 @@ HyperionDaemon::HyperionDaemon(const QString rootPath, QObject *parent, const bo
 	if(!logLvlOverwrite)
 		handleSettingsUpdate(settings::LOGGER, getSetting(settings::LOGGER));
 
+	// apply the thread scheduling before any pipeline thread is started
+	handleSettingsUpdate(settings::SCHEDULING, getSetting(settings::SCHEDULING));
+
 	// init EffectFileHandler
 	EffectFileHandler* efh = new EffectFileHandler(rootPath, getSetting(settings::EFFECTS), this);
 	connect(this, &HyperionDaemon::settingsChanged, efh, &EffectFileHandler::handleSettingsUpdate);
@@ -175,17 +184,19 @@ void HyperionDaemon::freeObjects()
 	_instanceManager->stopAll();
 
 	delete _bonjourBrowserWrapper;
-	delete _amlGrabber;
-	delete _dispmanx;
-	delete _fbGrabber;
-	delete _osxGrabber;
-	delete _qtGrabber;
-	delete _v4l2Grabber;
+	stopGrabberThread(_amlGrabber);
+	stopGrabberThread(_dispmanx);
+	stopGrabberThread(_fbGrabber);
+	stopGrabberThread(_osxGrabber);
+	stopGrabberThread(_x11Grabber);
+	stopGrabberThread(_qtGrabber);
+	stopGrabberThread(_v4l2Grabber);
 
 	_v4l2Grabber           = nullptr;
 	_bonjourBrowserWrapper = nullptr;
 	_amlGrabber            = nullptr;
 	_dispmanx              = nullptr;
+	_x11Grabber            = nullptr;
 	_fbGrabber             = nullptr;
 	_osxGrabber            = nullptr;
 	_qtGrabber             = nullptr;
@@ -210,6 +221,7 @@ void HyperionDaemon::startNetworkServices()
 	connect( fbThread, &QThread::finished, _flatBufferServer, &QObject::deleteLater );
 	connect( fbThread, &QThread::finished, fbThread, &QObject::deleteLater );
 	connect(this, &HyperionDaemon::settingsChanged, _flatBufferServer, &FlatBufferServer::handleSettingsUpdate);
+	updateRemoteImageTarget();
 	fbThread->start();
 
 	// Create Proto server in thread
@@ -257,6 +269,11 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 		else if (level == "debug")   Logger::setLogLevel(Logger::DEBUG);
 	}
 
+	if(settingsType == settings::SCHEDULING)
+	{
+		ThreadScheduler::setConfig(config.object());
+	}
+
 	if(settingsType == settings::SYSTEMCAPTURE)
 	{
 		const QJsonObject & grabberConfig = config.object();
@@ -270,6 +287,8 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 		_grabber_cropTop    = grabberConfig["cropTop"].toInt(0);
 		_grabber_cropBottom = grabberConfig["cropBottom"].toInt(0);
 
+		_grabber_decimationMode = grabberConfig["decimationMode"].toString("sample");
+
 		_grabber_ge2d_mode  = grabberConfig["ge2d_mode"].toInt(0);
 		_grabber_device     = grabberConfig["amlogic_grabber"].toString("amvideocap0");
 
@@ -313,22 +332,22 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 
 			// stop all capture interfaces
 			#ifdef ENABLE_FB
-			if(_fbGrabber != nullptr)  _fbGrabber->stop();
+			if(_fbGrabber != nullptr)  QMetaObject::invokeMethod(_fbGrabber, "stop");
 			#endif
 			#ifdef ENABLE_DISPMANX
-			if(_dispmanx != nullptr)   _dispmanx->stop();
+			if(_dispmanx != nullptr)   QMetaObject::invokeMethod(_dispmanx, "stop");
 			#endif
 			#ifdef ENABLE_AMLOGIC
-			if(_amlGrabber != nullptr) _amlGrabber->stop();
+			if(_amlGrabber != nullptr) QMetaObject::invokeMethod(_amlGrabber, "stop");
 			#endif
 			#ifdef ENABLE_OSX
-			if(_osxGrabber != nullptr) _osxGrabber->stop();
+			if(_osxGrabber != nullptr) QMetaObject::invokeMethod(_osxGrabber, "stop");
 			#endif
 			#ifdef ENABLE_X11
-			if(_x11Grabber != nullptr) _x11Grabber->stop();
+			if(_x11Grabber != nullptr) QMetaObject::invokeMethod(_x11Grabber, "stop");
 			#endif
 			#ifdef ENABLE_QT
-			if(_qtGrabber != nullptr) _qtGrabber->stop();
+			if(_qtGrabber != nullptr) QMetaObject::invokeMethod(_qtGrabber, "stop");
 			#endif
 
 			// create/start capture interface
@@ -337,7 +356,7 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 				if(_fbGrabber == nullptr)
 					createGrabberFramebuffer(grabberConfig);
 				#ifdef ENABLE_FB
-				_fbGrabber->start();
+				QMetaObject::invokeMethod(_fbGrabber, "start");
 				#endif
 			}
 			else if(type == "dispmanx")
@@ -345,7 +364,7 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 				if(_dispmanx == nullptr)
 					createGrabberDispmanx();
 				#ifdef ENABLE_DISPMANX
-				_dispmanx->start();
+				QMetaObject::invokeMethod(_dispmanx, "start");
 				#endif
 			}
 			else if(type == "amlogic")
@@ -353,7 +372,7 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 				if(_amlGrabber == nullptr)
 					createGrabberAmlogic();
 				#ifdef ENABLE_AMLOGIC
-				_amlGrabber->start();
+				QMetaObject::invokeMethod(_amlGrabber, "start");
 				#endif
 			}
 			else if(type == "osx")
@@ -361,7 +380,7 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 				if(_osxGrabber == nullptr)
 					createGrabberOsx(grabberConfig);
 				#ifdef ENABLE_OSX
-				_osxGrabber->start();
+				QMetaObject::invokeMethod(_osxGrabber, "start");
 				#endif
 			}
 			else if(type == "x11")
@@ -369,7 +388,7 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 				if(_x11Grabber == nullptr)
 					createGrabberX11(grabberConfig);
 				#ifdef ENABLE_X11
-				_x11Grabber->start();
+				QMetaObject::invokeMethod(_x11Grabber, "start");
 				#endif
 			}
 			else if(type == "qt")
@@ -377,7 +396,7 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 				if(_qtGrabber == nullptr)
 					createGrabberQt(grabberConfig);
 				#ifdef ENABLE_QT
-				_qtGrabber->start();
+				QMetaObject::invokeMethod(_qtGrabber, "start");
 				#endif
 			}
 			else
@@ -417,16 +436,82 @@ void HyperionDaemon::handleSettingsUpdate(const settings::type& settingsType, co
 				grabberConfig["sDVOffsetMin"].toDouble(0.25),
 				grabberConfig["sDHOffsetMax"].toDouble(0.75),
 				grabberConfig["sDVOffsetMax"].toDouble(0.75));
+			_v4l2Grabber->setSignalDetectionStep(grabberConfig["sDStep"].toInt(1));
+			_v4l2Grabber->setModeNegotiation(grabberConfig["modeNegotiation"].toBool(true), grabberConfig["fps"].toInt(25));
+			_v4l2Grabber->setFusedMapping(grabberConfig["fusedMapping"].toBool(true));
+			_v4l2Grabber->setDecimationMode(grabberConfig["decimationMode"].toString("sample"));
+			_v4l2Grabber->setLedGridSize(hyperion::getLedLayoutGridSize(getSetting(settings::LEDS).array()));
 			Debug(_log, "V4L2 grabber created");
 
 			// connect to HyperionDaemon signal
 			connect(this, &HyperionDaemon::videoMode, _v4l2Grabber, &V4L2Wrapper::setVideoMode);
 			connect(this, &HyperionDaemon::settingsChanged, _v4l2Grabber, &V4L2Wrapper::handleSettingsUpdate);
 			connect(this, &HyperionDaemon::componentStateChanged, _v4l2Grabber, &V4L2Wrapper::componentStateChanged);
+
+			startGrabberThread(_v4l2Grabber);
 #else
 		Error(_log, "The v4l2 grabber can not be instantiated, because it has been left out from the build");
 #endif
 	}
+	else if(settingsType == settings::LEDS || settingsType == settings::SMOOTHING)
+	{
+		updateRemoteImageTarget();
+
+#ifdef ENABLE_V4L2
+		// the v4l2 capture mode is negotiated for the led layout of the main instance
+		if(settingsType == settings::LEDS && _v4l2Grabber != nullptr)
+		{
+			QMetaObject::invokeMethod(_v4l2Grabber, "setLedGridSize", Qt::QueuedConnection,
+				Q_ARG(QSize, hyperion::getLedLayoutGridSize(getSetting(settings::LEDS).array())));
+		}
+#endif
+	}
+}
+
+void HyperionDaemon::updateRemoteImageTarget()
+{
+	// the flatbuffer clients are asked for the image size and frame rate of the main instance
+	if(_flatBufferServer != nullptr)
+	{
+		QMetaObject::invokeMethod(_flatBufferServer, "setImageTarget", Qt::QueuedConnection,
+			Q_ARG(QSize, hyperion::getRemoteImageTargetSize(getSetting(settings::LEDS).array())),
+			Q_ARG(int, hyperion::getRemoteImageTargetFps(getSetting(settings::SMOOTHING).object())));
+	}
+}
+
+void HyperionDaemon::startGrabberThread(GrabberWrapper* grabber)
+{
+	grabber->handleSettingsUpdate(settings::CAPTUREGOVERNOR, getSetting(settings::CAPTUREGOVERNOR));
+
+	QThread* thread = new QThread(this);
+	grabber->moveToCaptureThread(thread);
+	ThreadScheduler::manageThread(thread, ThreadScheduler::CAPTURE);
+	connect(thread, &QThread::finished, grabber, &QObject::deleteLater);
+	connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+	thread->start();
+}
+
+void HyperionDaemon::stopGrabberThread(QObject* grabber)
+{
+	if(grabber == nullptr)
+		return;
+
+	// grabbers in a capture thread are deleted by the thread, the others live here
+	if(grabber->thread() != thread())
+	{
+		// stop grabbing before the thread ends, so no frame is published while the receivers are destroyed
+		QThread* captureThread = grabber->thread();
+		QMetaObject::invokeMethod(grabber, "stop", Qt::BlockingQueuedConnection);
+		captureThread->quit();
+		if(!captureThread->wait(5000))
+		{
+			// the objects it uses are freed next, so shutting down without the thread isn't an option
+			Error(_log, "Capture thread of %s didn't stop within 5s, still waiting", grabber->metaObject()->className());
+			captureThread->wait();
+		}
+	}
+	else
+		delete grabber;
 }
 
 void HyperionDaemon::createGrabberDispmanx()
@@ -438,6 +523,7 @@ void HyperionDaemon::createGrabberDispmanx()
 	// connect to HyperionDaemon signal
 	connect(this, &HyperionDaemon::videoMode, _dispmanx, &DispmanxWrapper::setVideoMode);
 	connect(this, &HyperionDaemon::settingsChanged, _dispmanx, &DispmanxWrapper::handleSettingsUpdate);
+	startGrabberThread(_dispmanx);
 
 	Info(_log, "DISPMANX frame grabber created");
 #else
@@ -451,10 +537,12 @@ void HyperionDaemon::createGrabberAmlogic()
 #ifdef ENABLE_AMLOGIC
 	_amlGrabber = new AmlogicWrapper(_grabber_width, _grabber_height);
 	_amlGrabber->setCropping(_grabber_cropLeft, _grabber_cropRight, _grabber_cropTop, _grabber_cropBottom);
+	_amlGrabber->setDecimationMode(_grabber_decimationMode);
 
 	// connect to HyperionDaemon signal
 	connect(this, &HyperionDaemon::videoMode, _amlGrabber, &AmlogicWrapper::setVideoMode);
 	connect(this, &HyperionDaemon::settingsChanged, _amlGrabber, &AmlogicWrapper::handleSettingsUpdate);
+	startGrabberThread(_amlGrabber);
 
 	Info(_log, "AMLOGIC grabber created");
 #else
@@ -470,10 +558,12 @@ void HyperionDaemon::createGrabberX11(const QJsonObject & grabberConfig)
 				grabberConfig["pixelDecimation"].toInt(8),
 				_grabber_frequency );
 	_x11Grabber->setCropping(_grabber_cropLeft, _grabber_cropRight, _grabber_cropTop, _grabber_cropBottom);
+	_x11Grabber->setDecimationMode(_grabber_decimationMode);
 
 	// connect to HyperionDaemon signal
 	connect(this, &HyperionDaemon::videoMode, _x11Grabber, &X11Wrapper::setVideoMode);
 	connect(this, &HyperionDaemon::settingsChanged, _x11Grabber, &X11Wrapper::handleSettingsUpdate);
+	startGrabberThread(_x11Grabber);
 
 	Info(_log, "X11 grabber created");
 #else
@@ -493,6 +583,8 @@ void HyperionDaemon::createGrabberQt(const QJsonObject & grabberConfig)
 	// connect to HyperionDaemon signal
 	connect(this, &HyperionDaemon::videoMode, _qtGrabber, &QtWrapper::setVideoMode);
 	connect(this, &HyperionDaemon::settingsChanged, _qtGrabber, &QtWrapper::handleSettingsUpdate);
+	_qtGrabber->handleSettingsUpdate(settings::CAPTUREGOVERNOR, getSetting(settings::CAPTUREGOVERNOR));
+	// screen grabs through QScreen are bound to the gui thread, the Qt grabber can't move to a capture thread
 
 	Info(_log, "Qt grabber created");
 #else
@@ -508,9 +600,11 @@ void HyperionDaemon::createGrabberFramebuffer(const QJsonObject & grabberConfig)
 				grabberConfig["device"].toString("/dev/fb0"),
 				_grabber_width, _grabber_height, _grabber_frequency);
 	_fbGrabber->setCropping(_grabber_cropLeft, _grabber_cropRight, _grabber_cropTop, _grabber_cropBottom);
+	_fbGrabber->setDecimationMode(_grabber_decimationMode);
 	// connect to HyperionDaemon signal
 	connect(this, &HyperionDaemon::videoMode, _fbGrabber, &FramebufferWrapper::setVideoMode);
 	connect(this, &HyperionDaemon::settingsChanged, _fbGrabber, &FramebufferWrapper::handleSettingsUpdate);
+	startGrabberThread(_fbGrabber);
 
 	Info(_log, "Framebuffer grabber created");
 #else
@@ -526,10 +620,12 @@ void HyperionDaemon::createGrabberOsx(const QJsonObject & grabberConfig)
 	_osxGrabber = new OsxWrapper(
 				grabberConfig["display"].toInt(0),
 				_grabber_width, _grabber_height, _grabber_frequency);
+	_osxGrabber->setDecimationMode(_grabber_decimationMode);
 
 	// connect to HyperionDaemon signal
 	connect(this, &HyperionDaemon::videoMode, _osxGrabber, &OsxWrapper::setVideoMode);
 	connect(this, &HyperionDaemon::settingsChanged, _osxGrabber, &OsxWrapper::handleSettingsUpdate);
+	startGrabberThread(_osxGrabber);
 
 	Info(_log, "OSX grabber created");
 #else
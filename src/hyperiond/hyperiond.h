@@ -64,6 +64,7 @@ class FlatBufferServer;
 class ProtoServer;
 class AuthManager;
 class NetOrigin;
+class GrabberWrapper;
 
 class HyperionDaemon : public QObject
 {
@@ -137,6 +138,23 @@ private slots:
 	void setVideoMode(const VideoMode& mode);
 
 private:
+	///
+	/// @brief Run a grabber in its own capture thread, the thread takes the ownership
+	/// @param grabber  The grabber to move
+	///
+	void startGrabberThread(GrabberWrapper* grabber);
+
+	///
+	/// @brief Stop a grabber and its capture thread (if any) and delete it
+	/// @param grabber  The grabber to stop, might be nullptr
+	///
+	void stopGrabberThread(QObject* grabber);
+
+	///
+	/// @brief Pass the image size and frame rate of the main instance to the flatbuffer server, which asks its clients for them
+	///
+	void updateRemoteImageTarget();
+
 	void createGrabberDispmanx();
 	void createGrabberAmlogic();
 	void createGrabberFramebuffer(const QJsonObject & grabberConfig);
@@ -170,6 +188,7 @@ private:
 	unsigned                   _grabber_cropRight;
 	unsigned                   _grabber_cropTop;
 	unsigned                   _grabber_cropBottom;
+	QString                    _grabber_decimationMode;
 	int                        _grabber_ge2d_mode;
 	QString                    _grabber_device;
 
@@ -0,0 +1,106 @@
+// STL includes
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Utils includes
+#include <utils/Base64.h>
+
+///
+/// Decode into a buffer with a guard byte behind the decoded size, which must not be touched
+///
+bool decodeChecked(const std::string& encoded, std::string& decoded)
+{
+	const size_t size = Base64::decodedSize(encoded.data(), encoded.size());
+	std::vector<uint8_t> buffer(size + 1, 0xAA);
+	if (!Base64::decode(encoded.data(), encoded.size(), buffer.data()) || buffer[size] != 0xAA)
+	{
+		return false;
+	}
+
+	decoded.assign(reinterpret_cast<const char*>(buffer.data()), size);
+	return true;
+}
+
+int TC_DECODE_PADDING()
+{
+	int result = 0;
+
+	// the test vectors of RFC 4648 and some binary data
+	const std::pair<std::string, std::string> vectors[] = {
+		{ "", "" },
+		{ "Zg==", "f" },
+		{ "Zm8=", "fo" },
+		{ "Zm9v", "foo" },
+		{ "Zm9vYg==", "foob" },
+		{ "Zm9vYmE=", "fooba" },
+		{ "Zm9vYmFy", "foobar" },
+		{ "//79AIA=", std::string("\xFF\xFE\xFD\x00\x80", 5) }
+	};
+
+	for (const auto& vector : vectors)
+	{
+		const std::string& encoded = vector.first;
+		const std::string& expected = vector.second;
+
+		std::string decoded;
+		if (!decodeChecked(encoded, decoded) || decoded != expected)
+		{
+			std::cerr << "Failed to decode '" << encoded << "'" << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly decoded '" << encoded << "'" << std::endl;
+	}
+
+	return result;
+}
+
+int TC_DECODE_INVALID()
+{
+	int result = 0;
+
+	// whitespace, the url alphabet, misplaced padding and lengths which aren't a multiple of 4
+	const char* invalid[] = { "Zm9", "Zm9vY", "Zm 9", "Zm9v\n", "Zm9\n", "Zm-v", "Zm_v", "Zm9vYmF*", "Z=9v", "=m9v", "Zg=a", "Z===", "====", "Zg==Zm9v" };
+
+	for (const char* data : invalid)
+	{
+		std::vector<uint8_t> buffer(16, 0xAA);
+		if (Base64::decode(data, strlen(data), buffer.data()))
+		{
+			std::cerr << "Failed to reject '" << data << "'" << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly rejected '" << data << "'" << std::endl;
+	}
+
+	return result;
+}
+
+int TC_DECODED_SIZE()
+{
+	int result = 0;
+
+	if (Base64::decodedSize("Zm9v", 4) != 3 || Base64::decodedSize("Zm8=", 4) != 2 || Base64::decodedSize("Zg==", 4) != 1
+		|| Base64::decodedSize("Zm9vYmFy", 8) != 6 || Base64::decodedSize("", 0) != 0
+		|| Base64::decodedSize("Zm9", 3) != 0 || Base64::decodedSize("Zm9vY", 5) != 0)
+	{
+		std::cerr << "Failed to calculate the decoded size" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly calculated the decoded size" << std::endl;
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_DECODE_PADDING();
+	result |= TC_DECODE_INVALID();
+	result |= TC_DECODED_SIZE();
+
+	return result;
+}
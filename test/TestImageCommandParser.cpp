@@ -0,0 +1,140 @@
+// STL includes
+#include <cstring>
+#include <iostream>
+
+// Qt includes
+#include <QByteArray>
+
+// Api includes
+#include <api/ImageCommandParser.h>
+
+/// A 2x3 image in RGB
+static const char IMAGE_DATA[] = "AAECAwQFBgcICQoLDA0ODxAR";
+
+QByteArray imageMessage(const char* fields)
+{
+	return QByteArray("{\"command\":\"image\",") + fields + ",\"imagewidth\":2,\"imageheight\":3,\"imagedata\":\"" + IMAGE_DATA + "\"}";
+}
+
+bool pointsToImageData(const QByteArray& message, const ImageCommand& command)
+{
+	return command.imageData >= message.constData() && command.imageData + command.imageDataLength <= message.constData() + message.size()
+		&& command.imageDataLength == strlen(IMAGE_DATA) && memcmp(command.imageData, IMAGE_DATA, command.imageDataLength) == 0;
+}
+
+int TC_ACCEPT()
+{
+	int result = 0;
+
+	{
+		const QByteArray message = imageMessage("\"priority\":50,\"origin\":\"Hyperion\"");
+		ImageCommand command;
+		if (!ImageCommandParser::parse(message, command) || command.priority != 50 || command.origin != "Hyperion"
+			|| command.width != 2 || command.height != 3 || command.tan != 0 || command.duration != -1 || !pointsToImageData(message, command))
+		{
+			std::cerr << "Failed to parse an image command" << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly parsed an image command" << std::endl;
+	}
+
+	{
+		// any order of the fields, the optional ones and whitespace between the tokens
+		const QByteArray message = QByteArray(" {\n\t\"imagedata\" : \"") + IMAGE_DATA + "\" , \"imageheight\":3, \"imagewidth\" :2,\r\n"
+			"\"tan\":7, \"duration\": -1000, \"origin\":\"\", \"priority\":253, \"command\":\"image\" }\n";
+		ImageCommand command;
+		if (!ImageCommandParser::parse(message, command) || command.priority != 253 || command.origin != ""
+			|| command.tan != 7 || command.duration != -1000 || !pointsToImageData(message, command))
+		{
+			std::cerr << "Failed to parse a reordered image command with whitespace" << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly parsed a reordered image command with whitespace" << std::endl;
+	}
+
+	return result;
+}
+
+///
+/// Every rejected message has to take the generic path, which parses it completely and creates the error replies
+///
+int testReject(const char* description, const QByteArray& message)
+{
+	ImageCommand command;
+	if (ImageCommandParser::parse(message, command))
+	{
+		std::cerr << "Failed to leave " << description << " to the generic path" << std::endl;
+		return -1;
+	}
+
+	std::cout << "Correctly left " << description << " to the generic path" << std::endl;
+	return 0;
+}
+
+int TC_ESCAPES()
+{
+	int result = 0;
+
+	result |= testReject("an escaped quote in a value", imageMessage("\"priority\":50,\"origin\":\"Hyper\\\"ion\""));
+	result |= testReject("an escaped unicode character in a value", imageMessage("\"priority\":50,\"origin\":\"Hyper\\u0069on\""));
+	result |= testReject("an escaped character in a key", imageMessage("\"priority\":50,\"\\u006frigin\":\"Hyperion\""));
+	result |= testReject("an escaped slash in the image data", QByteArray("{\"command\":\"image\",\"priority\":50,\"origin\":\"Hyperion\",\"imagewidth\":2,\"imageheight\":3,\"imagedata\":\"AAECAwQFBgcICQoLDA0ODxA\\/\"}"));
+
+	return result;
+}
+
+int TC_DUPLICATE_KEYS()
+{
+	int result = 0;
+
+	result |= testReject("a duplicated priority", imageMessage("\"priority\":50,\"priority\":60,\"origin\":\"Hyperion\""));
+	result |= testReject("a duplicated command", imageMessage("\"command\":\"image\",\"priority\":50,\"origin\":\"Hyperion\""));
+	result |= testReject("a duplicated optional field", imageMessage("\"priority\":50,\"tan\":1,\"origin\":\"Hyperion\",\"tan\":2"));
+
+	return result;
+}
+
+int TC_FLOATS()
+{
+	int result = 0;
+
+	result |= testReject("a float priority", imageMessage("\"priority\":50.0,\"origin\":\"Hyperion\""));
+	result |= testReject("a priority with an exponent", imageMessage("\"priority\":5e1,\"origin\":\"Hyperion\""));
+	result |= testReject("a float duration", imageMessage("\"priority\":50,\"duration\":-1.5,\"origin\":\"Hyperion\""));
+	result |= testReject("a duration with an exponent", imageMessage("\"priority\":50,\"duration\":1E3,\"origin\":\"Hyperion\""));
+	result |= testReject("an integer beyond the int range", imageMessage("\"priority\":50,\"tan\":99999999999,\"origin\":\"Hyperion\""));
+
+	return result;
+}
+
+int TC_FALLBACK()
+{
+	int result = 0;
+
+	result |= testReject("another command", QByteArray("{\"command\":\"color\",\"priority\":50,\"origin\":\"Hyperion\",\"color\":[255,0,0]}"));
+	result |= testReject("an unknown field", imageMessage("\"priority\":50,\"origin\":\"Hyperion\",\"format\":\"auto\""));
+	result |= testReject("a missing origin", imageMessage("\"priority\":50"));
+	result |= testReject("a priority out of range", imageMessage("\"priority\":254,\"origin\":\"Hyperion\""));
+	result |= testReject("a string priority", imageMessage("\"priority\":\"50\",\"origin\":\"Hyperion\""));
+	result |= testReject("a nested value", imageMessage("\"priority\":50,\"origin\":{\"name\":\"Hyperion\"}"));
+	result |= testReject("a negative width", QByteArray("{\"command\":\"image\",\"priority\":50,\"origin\":\"Hyperion\",\"imagewidth\":-2,\"imageheight\":3,\"imagedata\":\"\"}"));
+	result |= testReject("trailing data", imageMessage("\"priority\":50,\"origin\":\"Hyperion\"") + " {}");
+	result |= testReject("a truncated message", imageMessage("\"priority\":50,\"origin\":\"Hyperion\"").left(60));
+	result |= testReject("an empty object", QByteArray("{}"));
+	result |= testReject("an empty message", QByteArray());
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_ACCEPT();
+	result |= TC_ESCAPES();
+	result |= TC_DUPLICATE_KEYS();
+	result |= TC_FLOATS();
+	result |= TC_FALLBACK();
+
+	return result;
+}
@@ -0,0 +1,317 @@
+// STL includes
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Utils includes
+#include <utils/ColorRgb.h>
+#include <utils/ColorRgba.h>
+#include <utils/Image.h>
+#include <utils/ImageView.h>
+#include <utils/ImageReduce.h>
+
+// Blackborder includes
+#include <blackborder/BlackBorderDetector.h>
+
+using namespace hyperion;
+
+bool isBlack(const ColorRgb& color, uint8_t threshold)
+{
+	return color.red < threshold && color.green < threshold && color.blue < threshold;
+}
+
+///
+/// The default detection mode as it has been done before the lines were scanned by ImageReduce::firstNonBlack
+///
+template <typename Image_T>
+BlackBorder referenceProcess(const Image_T& image, uint8_t threshold)
+{
+	int width = image.width();
+	int height = image.height();
+	int width33percent = width / 3;
+	int height33percent = height / 3;
+	int width66percent = width33percent * 2;
+	int height66percent = height33percent * 2;
+	int xCenter = width / 2;
+	int yCenter = height / 2;
+
+	int firstNonBlackXPixelIndex = -1;
+	int firstNonBlackYPixelIndex = -1;
+
+	width--;
+	height--;
+
+	for (int x = 0; x < width33percent; ++x)
+	{
+		if (!isBlack(image((width - x), yCenter), threshold)
+			|| !isBlack(image(x, height33percent), threshold)
+			|| !isBlack(image(x, height66percent), threshold))
+		{
+			firstNonBlackXPixelIndex = x;
+			break;
+		}
+	}
+
+	for (int y = 0; y < height33percent; ++y)
+	{
+		if (!isBlack(image(xCenter, (height - y)), threshold)
+			|| !isBlack(image(width33percent, y), threshold)
+			|| !isBlack(image(width66percent, y), threshold))
+		{
+			firstNonBlackYPixelIndex = y;
+			break;
+		}
+	}
+
+	BlackBorder detectedBorder;
+	detectedBorder.unknown = firstNonBlackXPixelIndex == -1 || firstNonBlackYPixelIndex == -1;
+	detectedBorder.horizontalSize = firstNonBlackYPixelIndex;
+	detectedBorder.verticalSize = firstNonBlackXPixelIndex;
+	return detectedBorder;
+}
+
+///
+/// The osd detection mode as it has been done before the lines were scanned by ImageReduce::firstNonBlack
+///
+template <typename Image_T>
+BlackBorder referenceProcessOsd(const Image_T& image, uint8_t threshold)
+{
+	int width = image.width();
+	int height = image.height();
+	int width33percent = width / 3;
+	int height33percent = height / 3;
+	int height66percent = height33percent * 2;
+	int yCenter = height / 2;
+
+	int firstNonBlackXPixelIndex = -1;
+	int firstNonBlackYPixelIndex = -1;
+
+	width--;
+	height--;
+
+	int x;
+	for (x = 0; x < width33percent; ++x)
+	{
+		if (!isBlack(image((width - x), yCenter), threshold)
+			|| !isBlack(image(x, height33percent), threshold)
+			|| !isBlack(image(x, height66percent), threshold))
+		{
+			firstNonBlackXPixelIndex = x;
+			break;
+		}
+	}
+
+	for (int y = 0; y < height33percent; ++y)
+	{
+		if (!isBlack(image(x, y), threshold)
+			|| !isBlack(image(x, (height - y)), threshold)
+			|| !isBlack(image((width - x), y), threshold)
+			|| !isBlack(image((width - x), (height - y)), threshold))
+		{
+			firstNonBlackYPixelIndex = y;
+			break;
+		}
+	}
+
+	BlackBorder detectedBorder;
+	detectedBorder.unknown = firstNonBlackXPixelIndex == -1 || firstNonBlackYPixelIndex == -1;
+	detectedBorder.horizontalSize = firstNonBlackYPixelIndex;
+	detectedBorder.verticalSize = firstNonBlackXPixelIndex;
+	return detectedBorder;
+}
+
+uint8_t randomBelow(int limit)
+{
+	return uint8_t(limit > 0 ? rand() % limit : 0);
+}
+
+///
+/// An image with dark borders of a random size on every side. The borders are just below the threshold and the
+/// content has some dark pixels as well, so the scanned lines hit at different positions
+///
+Image<ColorRgb> createBorderedImage(unsigned width, unsigned height, uint8_t threshold)
+{
+	const unsigned top    = unsigned(rand()) % (height / 3 + 3);
+	const unsigned bottom = unsigned(rand()) % (height / 3 + 3);
+	const unsigned left   = unsigned(rand()) % (width / 3 + 3);
+	const unsigned right  = unsigned(rand()) % (width / 3 + 3);
+
+	Image<ColorRgb> image(width, height);
+	for (unsigned y = 0; y < height; ++y)
+	{
+		for (unsigned x = 0; x < width; ++x)
+		{
+			const bool border = y < top || y >= height - bottom || x < left || x >= width - right;
+			if (border || rand() % 4 == 0)
+			{
+				image(x, y) = ColorRgb{randomBelow(threshold), randomBelow(threshold), randomBelow(threshold)};
+			}
+			else
+			{
+				// at least one channel reaches the threshold
+				ColorRgb color{randomBelow(threshold), randomBelow(threshold), randomBelow(threshold)};
+				uint8_t& channel = (rand() % 3 == 0) ? color.red : (rand() % 2 == 0) ? color.green : color.blue;
+				channel = uint8_t(threshold + rand() % (256 - threshold));
+				image(x, y) = color;
+			}
+		}
+	}
+	return image;
+}
+
+bool equalBorders(const BlackBorder& a, const BlackBorder& b)
+{
+	return a.unknown == b.unknown && a.horizontalSize == b.horizontalSize && a.verticalSize == b.verticalSize;
+}
+
+int TC_DETECTOR_PARITY()
+{
+	int result = 0;
+
+	const double thresholds[3] = { 0.0, 0.05, 0.2 };
+	const unsigned sizes[4][2] = { { 64, 36 }, { 100, 100 }, { 7, 5 }, { 161, 91 } };
+
+	for (const double threshold : thresholds)
+	{
+		BlackBorderDetector detector(threshold);
+		const uint8_t rgbThreshold = detector.calculateThreshold(threshold);
+
+		bool equal = true;
+		for (const auto& size : sizes)
+		{
+			for (int i = 0; i < 50; ++i)
+			{
+				const Image<ColorRgb> image = createBorderedImage(size[0], size[1], rgbThreshold);
+				equal &= equalBorders(detector.process(image), referenceProcess(image, rgbThreshold));
+				equal &= equalBorders(detector.process_osd(image), referenceProcessOsd(image, rgbThreshold));
+			}
+		}
+
+		if (!equal)
+		{
+			std::cerr << "Failed to detect the same borders as before with the threshold " << threshold << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly detected the same borders as before with the threshold " << threshold << std::endl;
+	}
+
+	return result;
+}
+
+int TC_DETECTOR_VIEW_PARITY()
+{
+	int result = 0;
+
+	BlackBorderDetector detector(0.1);
+	const uint8_t rgbThreshold = detector.calculateThreshold(0.1);
+
+	// a view on a region of a larger image, so the rows are further apart than the width
+	bool equal = true;
+	for (int i = 0; i < 50; ++i)
+	{
+		const Image<ColorRgb> image = createBorderedImage(90, 60, rgbThreshold);
+		const ImageView<ColorRgb> view(&image(5, 3), 70, 50, image.stride());
+		equal &= equalBorders(detector.process(view), referenceProcess(view, rgbThreshold));
+		equal &= equalBorders(detector.process_osd(view), referenceProcessOsd(view, rgbThreshold));
+	}
+
+	if (!equal)
+	{
+		std::cerr << "Failed to detect the same borders as before on a view with a stride" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly detected the same borders as before on a view with a stride" << std::endl;
+
+	return result;
+}
+
+int TC_FIRST_NON_BLACK()
+{
+	int result = 0;
+
+	const Image<ColorRgb> image = createBorderedImage(100, 80, 20);
+
+	// forward and backward along rows and columns, with lines shorter and longer than a block
+	bool equal = true;
+	const int steps[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+	for (const auto& step : steps)
+	{
+		for (const int count : { 0, 1, 15, 16, 17, 40 })
+		{
+			const int x = step[0] < 0 ? 99 : 10;
+			const int y = step[1] < 0 ? 79 : 10;
+
+			int expected = count;
+			for (int i = 0; i < count; ++i)
+			{
+				if (!isBlack(image(unsigned(x + i * step[0]), unsigned(y + i * step[1])), 20))
+				{
+					expected = i;
+					break;
+				}
+			}
+
+			const ptrdiff_t byteStep = step[0] * ptrdiff_t(sizeof(ColorRgb)) + step[1] * ptrdiff_t(image.stride());
+			equal &= ImageReduce::firstNonBlack(&image(unsigned(x), unsigned(y)), count, byteStep, 20) == expected;
+		}
+	}
+
+	if (!equal)
+	{
+		std::cerr << "Failed to find the first non black pixel along a line" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly found the first non black pixel along a line" << std::endl;
+
+	return result;
+}
+
+int TC_SUM_CHANNELS()
+{
+	int result = 0;
+
+	for (const size_t count : { size_t(0), size_t(1), size_t(31), size_t(1000) })
+	{
+		std::vector<ColorRgb> rgb(count);
+		std::vector<ColorRgba> rgba(count);
+		uint64_t red = 0, green = 0, blue = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			rgb[i] = ColorRgb{uint8_t(rand() % 256), uint8_t(rand() % 256), uint8_t(rand() % 256)};
+			rgba[i] = ColorRgba{rgb[i].red, rgb[i].green, rgb[i].blue, uint8_t(rand() % 256)};
+			red   += rgb[i].red;
+			green += rgb[i].green;
+			blue  += rgb[i].blue;
+		}
+
+		// the sums are added to the given ones
+		ImageReduce::ChannelSums rgbSums;
+		rgbSums.red = 1;
+		ImageReduce::sumChannels(rgb.data(), count, rgbSums);
+
+		ImageReduce::ChannelSums rgbaSums;
+		ImageReduce::sumChannels(rgba.data(), count, rgbaSums);
+
+		if (rgbSums.red != red + 1 || rgbSums.green != green || rgbSums.blue != blue
+			|| rgbaSums.red != red || rgbaSums.green != green || rgbaSums.blue != blue)
+		{
+			std::cerr << "Failed to sum the channels of " << count << " pixels" << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly summed the channels of " << count << " pixels" << std::endl;
+	}
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_DETECTOR_PARITY();
+	result |= TC_DETECTOR_VIEW_PARITY();
+	result |= TC_FIRST_NON_BLACK();
+	result |= TC_SUM_CHANNELS();
+
+	return result;
+}
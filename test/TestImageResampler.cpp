@@ -0,0 +1,379 @@
+// STL includes
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Utils includes
+#include <utils/ColorRgb.h>
+#include <utils/ColorRgbx.h>
+#include <utils/Image.h>
+#include <utils/ImageResampler.h>
+
+///
+/// A 4:2:0 frame with one chroma sample per 2x2 block, which can be written in the planar and semi planar layouts
+///
+struct YuvFrame
+{
+	int width;
+	int height;
+	std::vector<uint8_t> y;
+	std::vector<uint8_t> u;
+	std::vector<uint8_t> v;
+
+	YuvFrame(int width, int height)
+		: width(width)
+		, height(height)
+		, y(size_t(width * height))
+		, u(size_t(width * height / 4))
+		, v(size_t(width * height / 4))
+	{
+		for (uint8_t& value : y) value = uint8_t(16 + rand() % 220);
+		for (uint8_t& value : u) value = uint8_t(16 + rand() % 225);
+		for (uint8_t& value : v) value = uint8_t(16 + rand() % 225);
+	}
+
+	uint8_t luma(int x, int row) const { return y[size_t(row * width + x)]; }
+	uint8_t chromaU(int x, int row) const { return u[size_t((row >> 1) * (width >> 1) + (x >> 1))]; }
+	uint8_t chromaV(int x, int row) const { return v[size_t((row >> 1) * (width >> 1) + (x >> 1))]; }
+
+	/// NV12 (u first) or NV21 (v first), the rows are lineLength bytes apart in both planes
+	std::vector<uint8_t> semiPlanar(int lineLength, bool vFirst) const
+	{
+		std::vector<uint8_t> data(size_t(lineLength * height * 3 / 2), 0xAA);
+		for (int row = 0; row < height; ++row)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				data[size_t(row * lineLength + x)] = luma(x, row);
+				uint8_t* chroma = &data[size_t(lineLength * height + (row >> 1) * lineLength + (x & ~1))];
+				chroma[vFirst ? 1 : 0] = chromaU(x, row);
+				chroma[vFirst ? 0 : 1] = chromaV(x, row);
+			}
+		}
+		return data;
+	}
+
+	/// I420 (u plane first) or YV12 (v plane first), the chroma rows are lineLength/2 bytes apart
+	std::vector<uint8_t> planar(int lineLength, bool vFirst) const
+	{
+		const int chromaLineLength = lineLength / 2;
+		std::vector<uint8_t> data(size_t(lineLength * height * 3 / 2), 0xAA);
+		uint8_t* first  = &data[size_t(lineLength * height)];
+		uint8_t* second = first + chromaLineLength * (height / 2);
+		for (int row = 0; row < height; ++row)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				data[size_t(row * lineLength + x)] = luma(x, row);
+				const size_t chroma = size_t((row >> 1) * chromaLineLength + (x >> 1));
+				(vFirst ? second : first)[chroma] = chromaU(x, row);
+				(vFirst ? first : second)[chroma] = chromaV(x, row);
+			}
+		}
+		return data;
+	}
+};
+
+///
+/// The BT.601 conversion of the ImageResampler, computed independently of it
+///
+void yuv2rgb(uint8_t y, uint8_t u, uint8_t v, uint8_t& r, uint8_t& g, uint8_t& b)
+{
+	const int c = y - 16;
+	const int d = u - 128;
+	const int e = v - 128;
+
+	r = uint8_t(std::min(255, std::max(0, (298 * c + 409 * e + 128) >> 8)));
+	g = uint8_t(std::min(255, std::max(0, (298 * c - 100 * d - 208 * e + 128) >> 8)));
+	b = uint8_t(std::min(255, std::max(0, (298 * c + 516 * d + 128) >> 8)));
+}
+
+///
+/// The expected output of the sample decimation: the center pixel of each block of the cropped region
+///
+Image<ColorRgb> referenceSample(const YuvFrame& frame, int cropLeft, int cropRight, int cropTop, int cropBottom, int decimation)
+{
+	const int outputWidth  = (frame.width - cropLeft - cropRight - (decimation >> 1) + decimation - 1) / decimation;
+	const int outputHeight = (frame.height - cropTop - cropBottom - (decimation >> 1) + decimation - 1) / decimation;
+
+	Image<ColorRgb> image(outputWidth, outputHeight);
+	for (int yDest = 0; yDest < outputHeight; ++yDest)
+	{
+		for (int xDest = 0; xDest < outputWidth; ++xDest)
+		{
+			const int x = cropLeft + (decimation >> 1) + xDest * decimation;
+			const int y = cropTop + (decimation >> 1) + yDest * decimation;
+			ColorRgb& pixel = image(unsigned(xDest), unsigned(yDest));
+			yuv2rgb(frame.luma(x, y), frame.chromaU(x, y), frame.chromaV(x, y), pixel.red, pixel.green, pixel.blue);
+		}
+	}
+	return image;
+}
+
+///
+/// The expected output of the average decimation: the rounded mean of each block of the cropped region, the blocks at the
+/// right and bottom edge may be smaller. YUV is averaged per channel and converted once per block
+///
+Image<ColorRgb> referenceAverage(const YuvFrame& frame, int cropLeft, int cropRight, int cropTop, int cropBottom, int decimation)
+{
+	const int xEnd = frame.width - cropRight;
+	const int yEnd = frame.height - cropBottom;
+	const int outputWidth  = (xEnd - cropLeft - (decimation >> 1) + decimation - 1) / decimation;
+	const int outputHeight = (yEnd - cropTop - (decimation >> 1) + decimation - 1) / decimation;
+
+	Image<ColorRgb> image(outputWidth, outputHeight);
+	for (int yDest = 0; yDest < outputHeight; ++yDest)
+	{
+		for (int xDest = 0; xDest < outputWidth; ++xDest)
+		{
+			const int xFirst = cropLeft + xDest * decimation;
+			const int yFirst = cropTop + yDest * decimation;
+			uint32_t sumY = 0, sumU = 0, sumV = 0, count = 0;
+			for (int y = yFirst; y < std::min(yFirst + decimation, yEnd); ++y)
+			{
+				for (int x = xFirst; x < std::min(xFirst + decimation, xEnd); ++x)
+				{
+					sumY += frame.luma(x, y);
+					sumU += frame.chromaU(x, y);
+					sumV += frame.chromaV(x, y);
+					++count;
+				}
+			}
+
+			ColorRgb& pixel = image(unsigned(xDest), unsigned(yDest));
+			yuv2rgb(uint8_t((sumY + count / 2) / count), uint8_t((sumU + count / 2) / count), uint8_t((sumV + count / 2) / count),
+				pixel.red, pixel.green, pixel.blue);
+		}
+	}
+	return image;
+}
+
+bool equalImages(const Image<ColorRgb>& a, const Image<ColorRgb>& b)
+{
+	if (a.width() != b.width() || a.height() != b.height())
+	{
+		return false;
+	}
+
+	for (unsigned y = 0; y < a.height(); ++y)
+	{
+		for (unsigned x = 0; x < a.width(); ++x)
+		{
+			if (a(x, y).red != b(x, y).red || a(x, y).green != b(x, y).green || a(x, y).blue != b(x, y).blue)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+int testFormat(const char* name, PixelFormat pixelFormat, const YuvFrame& frame, const std::vector<uint8_t>& data, int lineLength)
+{
+	int result = 0;
+
+	// plain conversion, and a cropped and decimated one
+	const int cases[2][5] = { { 0, 0, 0, 0, 1 }, { 6, 2, 4, 2, 3 } };
+	for (const auto& c : cases)
+	{
+		ImageResampler resampler;
+		resampler.setCropping(c[0], c[1], c[2], c[3]);
+		resampler.setHorizontalPixelDecimation(c[4]);
+		resampler.setVerticalPixelDecimation(c[4]);
+
+		Image<ColorRgb> image;
+		resampler.processImage(data.data(), frame.width, frame.height, lineLength, pixelFormat, image);
+
+		if (!equalImages(image, referenceSample(frame, c[0], c[1], c[2], c[3], c[4])))
+		{
+			std::cerr << "Failed to convert " << name << " with decimation " << c[4] << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly converted " << name << " with decimation " << c[4] << std::endl;
+
+		resampler.setDecimationMode(ImageResampler::DECIMATION_AVERAGE);
+		resampler.processImage(data.data(), frame.width, frame.height, lineLength, pixelFormat, image);
+
+		if (!equalImages(image, referenceAverage(frame, c[0], c[1], c[2], c[3], c[4])))
+		{
+			std::cerr << "Failed to average " << name << " with decimation " << c[4] << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly averaged " << name << " with decimation " << c[4] << std::endl;
+	}
+
+	return result;
+}
+
+int TC_SEMI_PLANAR()
+{
+	int result = 0;
+
+	const YuvFrame frame(64, 36);
+	const int lineLength = 80;
+
+	result |= testFormat("NV12", PIXELFORMAT_NV12, frame, frame.semiPlanar(lineLength, false), lineLength);
+	result |= testFormat("NV21", PIXELFORMAT_NV21, frame, frame.semiPlanar(lineLength, true), lineLength);
+
+	return result;
+}
+
+int TC_PLANAR()
+{
+	int result = 0;
+
+	const YuvFrame frame(64, 36);
+	const int lineLength = 80;
+
+	result |= testFormat("I420", PIXELFORMAT_I420, frame, frame.planar(lineLength, false), lineLength);
+	result |= testFormat("YV12", PIXELFORMAT_YV12, frame, frame.planar(lineLength, true), lineLength);
+
+	return result;
+}
+
+int TC_AVERAGE_RGB()
+{
+	int result = 0;
+
+	const int width = 50;
+	const int height = 30;
+	const int lineLength = width * 3 + 4;
+	std::vector<uint8_t> data(size_t(lineLength * height));
+	for (uint8_t& value : data) value = uint8_t(rand() % 256);
+
+	// the region isn't a multiple of the decimation, so the blocks at the edges are smaller
+	const int decimation = 4;
+	const int cropLeft = 1, cropRight = 2, cropTop = 3, cropBottom = 0;
+
+	ImageResampler resampler;
+	resampler.setCropping(cropLeft, cropRight, cropTop, cropBottom);
+	resampler.setHorizontalPixelDecimation(decimation);
+	resampler.setVerticalPixelDecimation(decimation);
+	resampler.setDecimationMode(ImageResampler::DECIMATION_AVERAGE);
+
+	Image<ColorRgb> image;
+	resampler.processImage(data.data(), width, height, lineLength, PIXELFORMAT_RGB24, image);
+
+	const int xEnd = width - cropRight;
+	const int yEnd = height - cropBottom;
+	bool averaged = (image.width() == unsigned((xEnd - cropLeft - (decimation >> 1) + decimation - 1) / decimation))
+		&& (image.height() == unsigned((yEnd - cropTop - (decimation >> 1) + decimation - 1) / decimation));
+
+	for (unsigned yDest = 0; averaged && yDest < image.height(); ++yDest)
+	{
+		for (unsigned xDest = 0; xDest < image.width(); ++xDest)
+		{
+			const int xFirst = cropLeft + int(xDest) * decimation;
+			const int yFirst = cropTop + int(yDest) * decimation;
+			uint32_t sum[3] = { 0, 0, 0 };
+			uint32_t count = 0;
+			for (int y = yFirst; y < std::min(yFirst + decimation, yEnd); ++y)
+			{
+				for (int x = xFirst; x < std::min(xFirst + decimation, xEnd); ++x)
+				{
+					const uint8_t* pixel = &data[size_t(y * lineLength + x * 3)];
+					sum[0] += pixel[0];
+					sum[1] += pixel[1];
+					sum[2] += pixel[2];
+					++count;
+				}
+			}
+
+			const ColorRgb& pixel = image(xDest, yDest);
+			averaged &= pixel.red   == (sum[0] + count / 2) / count
+					 && pixel.green == (sum[1] + count / 2) / count
+					 && pixel.blue  == (sum[2] + count / 2) / count;
+		}
+	}
+
+	if (!averaged)
+	{
+		std::cerr << "Failed to average RGB24 blocks" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly averaged RGB24 blocks" << std::endl;
+
+	return result;
+}
+
+int TC_3D_MODES()
+{
+	int result = 0;
+
+	const YuvFrame frame(64, 36);
+	const int lineLength = 80;
+	const std::vector<uint8_t> data = frame.semiPlanar(lineLength, false);
+
+	// only the left or the top half of a 3D frame is used
+	ImageResampler resampler;
+	Image<ColorRgb> image;
+
+	resampler.setVideoMode(VIDEO_3DSBS);
+	resampler.processImage(data.data(), frame.width, frame.height, lineLength, PIXELFORMAT_NV12, image);
+	const bool sideBySide = equalImages(image, referenceSample(frame, 0, frame.width / 2, 0, 0, 1));
+
+	resampler.setVideoMode(VIDEO_3DTAB);
+	resampler.processImage(data.data(), frame.width, frame.height, lineLength, PIXELFORMAT_NV12, image);
+	const bool topAndBottom = equalImages(image, referenceSample(frame, 0, 0, 0, frame.height / 2, 1));
+
+	if (!sideBySide || !topAndBottom)
+	{
+		std::cerr << "Failed to crop the half of a 3D frame" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly cropped the half of a 3D frame" << std::endl;
+
+	return result;
+}
+
+int TC_RGBX()
+{
+	int result = 0;
+
+	const YuvFrame frame(64, 36);
+	const int lineLength = 80;
+	const std::vector<uint8_t> data = frame.semiPlanar(lineLength, false);
+
+	ImageResampler resampler;
+	resampler.setHorizontalPixelDecimation(3);
+	resampler.setVerticalPixelDecimation(3);
+
+	Image<ColorRgb> rgb;
+	resampler.processImage(data.data(), frame.width, frame.height, lineLength, PIXELFORMAT_NV12, rgb);
+
+	// the image keeps its padded layout, the rows start at 64 byte boundaries
+	Image<ColorRgbx> rgbx(1, 1, Image<ColorRgbx>::PADDED);
+	resampler.processImage(data.data(), frame.width, frame.height, lineLength, PIXELFORMAT_NV12, rgbx);
+
+	bool equal = rgbx.width() == rgb.width() && rgbx.height() == rgb.height() && rgbx.stride() % 64 == 0;
+	for (unsigned y = 0; equal && y < rgb.height(); ++y)
+	{
+		for (unsigned x = 0; x < rgb.width(); ++x)
+		{
+			equal &= rgbx(x, y).red == rgb(x, y).red && rgbx(x, y).green == rgb(x, y).green && rgbx(x, y).blue == rgb(x, y).blue;
+		}
+	}
+
+	if (!equal)
+	{
+		std::cerr << "Failed to convert into a padded RGBX image" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly converted into a padded RGBX image" << std::endl;
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_SEMI_PLANAR();
+	result |= TC_PLANAR();
+	result |= TC_3D_MODES();
+	result |= TC_AVERAGE_RGB();
+	result |= TC_RGBX();
+
+	return result;
+}
@@ -0,0 +1,379 @@
+// STL includes
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Utils includes
+#include <utils/ColorRgb.h>
+#include <utils/Image.h>
+#include <utils/ImageResampler.h>
+#include <utils/RawImage.h>
+
+// Hyperion includes
+#include <hyperion/ImageToLedsMap.h>
+
+using namespace hyperion;
+
+Led createLed(double minX, double maxX, double minY, double maxY)
+{
+	Led led;
+	led.index = 0;
+	led.minX_frac = minX;
+	led.maxX_frac = maxX;
+	led.minY_frac = minY;
+	led.maxY_frac = maxY;
+	led.clone = -1;
+	led.colorOrder = ORDER_RGB;
+	return led;
+}
+
+///
+/// A classic layout: leds along the four edges of the screen and one led covering the whole screen
+///
+std::vector<Led> createLeds()
+{
+	std::vector<Led> leds;
+	for (int i = 0; i < 10; ++i)
+	{
+		leds.push_back(createLed(i / 10.0, (i + 1) / 10.0, 0.0, 0.1));
+		leds.push_back(createLed(i / 10.0, (i + 1) / 10.0, 0.9, 1.0));
+	}
+	for (int i = 0; i < 6; ++i)
+	{
+		leds.push_back(createLed(0.0, 0.1, i / 6.0, (i + 1) / 6.0));
+		leds.push_back(createLed(0.9, 1.0, i / 6.0, (i + 1) / 6.0));
+	}
+	leds.push_back(createLed(0.0, 1.0, 0.0, 1.0));
+	return leds;
+}
+
+///
+/// A captured frame in one of the YUV layouts. The chroma is shared by 2x2 pixels and follows a gradient, so the leds get
+/// different colors. The values stay in a range which doesn't clip in the RGB conversion
+///
+struct YuvCapture
+{
+	int width;
+	int height;
+	int lineLength;
+	std::vector<uint8_t> data;
+
+	YuvCapture(PixelFormat pixelFormat, int width, int height)
+		: width(width)
+		, height(height)
+		, lineLength(0)
+	{
+		std::vector<uint8_t> y(size_t(width * height)), u, v;
+		for (uint8_t& value : y) value = uint8_t(60 + rand() % 120);
+		for (int row = 0; row < height / 2; ++row)
+		{
+			for (int x = 0; x < width / 2; ++x)
+			{
+				u.push_back(uint8_t(100 + 56 * x / (width / 2) + rand() % 8));
+				v.push_back(uint8_t(156 - 56 * row / (height / 2) - rand() % 8));
+			}
+		}
+
+		const auto chroma = [&](const std::vector<uint8_t>& plane, int x, int row) { return plane[size_t((row >> 1) * (width >> 1) + (x >> 1))]; };
+
+		switch (pixelFormat)
+		{
+			case PIXELFORMAT_YUYV:
+			case PIXELFORMAT_UYVY:
+			{
+				const bool lumaFirst = (pixelFormat == PIXELFORMAT_YUYV);
+				lineLength = width * 2 + 8;
+				data.assign(size_t(lineLength * height), 0);
+				for (int row = 0; row < height; ++row)
+				{
+					for (int x = 0; x < width; x += 2)
+					{
+						uint8_t* group = &data[size_t(row * lineLength + x * 2)];
+						group[lumaFirst ? 0 : 1] = y[size_t(row * width + x)];
+						group[lumaFirst ? 2 : 3] = y[size_t(row * width + x + 1)];
+						group[lumaFirst ? 1 : 0] = chroma(u, x, row);
+						group[lumaFirst ? 3 : 2] = chroma(v, x, row);
+					}
+				}
+			}
+			break;
+
+			case PIXELFORMAT_NV12:
+			case PIXELFORMAT_NV21:
+			{
+				const bool uFirst = (pixelFormat == PIXELFORMAT_NV12);
+				lineLength = width + 16;
+				data.assign(size_t(lineLength * height * 3 / 2), 0);
+				for (int row = 0; row < height; ++row)
+				{
+					for (int x = 0; x < width; ++x)
+					{
+						data[size_t(row * lineLength + x)] = y[size_t(row * width + x)];
+						uint8_t* pair = &data[size_t(lineLength * height + (row >> 1) * lineLength + (x & ~1))];
+						pair[uFirst ? 0 : 1] = chroma(u, x, row);
+						pair[uFirst ? 1 : 0] = chroma(v, x, row);
+					}
+				}
+			}
+			break;
+
+			default:
+			{
+				// I420 and YV12
+				const bool uFirst = (pixelFormat == PIXELFORMAT_I420);
+				lineLength = width + 16;
+				const int chromaLineLength = lineLength / 2;
+				data.assign(size_t(lineLength * height * 3 / 2), 0);
+				uint8_t* first  = &data[size_t(lineLength * height)];
+				uint8_t* second = first + chromaLineLength * (height / 2);
+				for (int row = 0; row < height; ++row)
+				{
+					for (int x = 0; x < width; ++x)
+					{
+						data[size_t(row * lineLength + x)] = y[size_t(row * width + x)];
+						const size_t offset = size_t((row >> 1) * chromaLineLength + (x >> 1));
+						(uFirst ? first : second)[offset] = chroma(u, x, row);
+						(uFirst ? second : first)[offset] = chroma(v, x, row);
+					}
+				}
+			}
+			break;
+		}
+	}
+};
+
+Image<ColorRgb> createNoise(unsigned width, unsigned height)
+{
+	Image<ColorRgb> image(width, height);
+	for (unsigned y = 0; y < height; ++y)
+	{
+		for (unsigned x = 0; x < width; ++x)
+		{
+			image(x, y) = ColorRgb{uint8_t(rand() % 256), uint8_t(rand() % 256), uint8_t(rand() % 256)};
+		}
+	}
+	return image;
+}
+
+bool closeColors(const std::vector<ColorRgb>& a, const std::vector<ColorRgb>& b, int tolerance)
+{
+	if (a.size() != b.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		if (std::abs(a[i].red - b[i].red) > tolerance || std::abs(a[i].green - b[i].green) > tolerance || std::abs(a[i].blue - b[i].blue) > tolerance)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+///
+/// Map the leds on a converted image and directly on the raw frame with the same cropping and decimation
+///
+int testRawParity(const char* name, PixelFormat pixelFormat, unsigned maxSamplesPerLed)
+{
+	int result = 0;
+
+	const YuvCapture capture(pixelFormat, 160, 90);
+	const std::vector<Led> leds = createLeds();
+
+	// plain, decimated and cropped with a decimation
+	const int cases[3][5] = { { 0, 0, 0, 0, 1 }, { 0, 0, 0, 0, 2 }, { 8, 4, 6, 2, 3 } };
+	for (const auto& c : cases)
+	{
+		ImageResampler resampler;
+		resampler.setCropping(c[0], c[1], c[2], c[3]);
+		resampler.setHorizontalPixelDecimation(c[4]);
+		resampler.setVerticalPixelDecimation(c[4]);
+
+		Image<ColorRgb> image;
+		resampler.processImage(capture.data.data(), capture.width, capture.height, capture.lineLength, pixelFormat, image);
+
+		RawImage raw;
+		raw.pixelFormat     = pixelFormat;
+		raw.width           = capture.width;
+		raw.height          = capture.height;
+		raw.lineLength      = capture.lineLength;
+		raw.cropLeft        = c[0];
+		raw.cropRight       = c[1];
+		raw.cropTop         = c[2];
+		raw.cropBottom      = c[3];
+		raw.pixelDecimation = c[4];
+		raw.data            = capture.data.data();
+		raw.size            = capture.data.size();
+
+		if (!raw.isValid() || unsigned(raw.sampledWidth()) != image.width() || unsigned(raw.sampledHeight()) != image.height())
+		{
+			std::cerr << "Failed to match the sampled grid of " << name << " with the converted image" << std::endl;
+			result = -1;
+			continue;
+		}
+
+		const ImageToLedsMap imageMap(image.width(), image.height(), 0, 0, leds, true, maxSamplesPerLed);
+		const ImageToLedsMap rawMap(image.width(), image.height(), 0, 0, leds, false, maxSamplesPerLed);
+
+		std::vector<ColorRgb> rawColors(leds.size());
+		rawMap.getMeanLedColor(raw, rawColors);
+
+		std::vector<ColorRgb> rawUniColors(leds.size());
+		rawMap.getUniLedColor(raw, rawUniColors);
+
+		// averaging before or after the conversion differs by the truncated averages, which the conversion amplifies up to 3.2 times
+		if (!closeColors(rawColors, imageMap.getMeanLedColor(image), 5) || !closeColors(rawUniColors, imageMap.getUniLedColor(image), 5))
+		{
+			std::cerr << "Failed to map the leds on raw " << name << " like on the converted image (decimation " << c[4] << ")" << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly mapped the leds on raw " << name << " like on the converted image (decimation " << c[4] << ")" << std::endl;
+	}
+
+	return result;
+}
+
+int TC_RAW_PARITY()
+{
+	int result = 0;
+
+	result |= testRawParity("YUYV", PIXELFORMAT_YUYV, 0);
+	result |= testRawParity("UYVY", PIXELFORMAT_UYVY, 0);
+	result |= testRawParity("NV12", PIXELFORMAT_NV12, 0);
+	result |= testRawParity("NV21", PIXELFORMAT_NV21, 0);
+	result |= testRawParity("I420", PIXELFORMAT_I420, 0);
+	result |= testRawParity("YV12", PIXELFORMAT_YV12, 0);
+
+	return result;
+}
+
+int TC_SPARSE_DETERMINISTIC()
+{
+	int result = 0;
+
+	const Image<ColorRgb> image = createNoise(320, 180);
+	const std::vector<Led> leds = createLeds();
+
+	// the samples are seeded per led, so a rebuilt map picks the same pixels
+	const ImageToLedsMap first(image.width(), image.height(), 0, 0, leds, true, 64);
+	const ImageToLedsMap second(image.width(), image.height(), 0, 0, leds, true, 64);
+
+	if (!closeColors(first.getMeanLedColor(image), second.getMeanLedColor(image), 0) || !closeColors(first.getUniLedColor(image), second.getUniLedColor(image), 0))
+	{
+		std::cerr << "Failed to sample the same pixels with a rebuilt map" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly sampled the same pixels with a rebuilt map" << std::endl;
+
+	return result;
+}
+
+int TC_SPARSE_INSIDE_AREA()
+{
+	int result = 0;
+
+	// the led edges fall on whole pixels of a 200x100 image
+	const double areas[3][4] = { { 0.25, 0.75, 0.2, 0.6 }, { 0.0, 0.05, 0.0, 1.0 }, { 0.9, 1.0, 0.9, 1.0 } };
+	for (const auto& a : areas)
+	{
+		Image<ColorRgb> image(200, 100);
+		for (unsigned y = 0; y < image.height(); ++y)
+		{
+			for (unsigned x = 0; x < image.width(); ++x)
+			{
+				const bool inside = x >= unsigned(a[0] * 200) && x < unsigned(a[1] * 200) && y >= unsigned(a[2] * 100) && y < unsigned(a[3] * 100);
+				image(x, y) = inside ? ColorRgb{200, 100, 50} : ColorRgb{0, 255, 255};
+			}
+		}
+
+		const ImageToLedsMap map(image.width(), image.height(), 0, 0, std::vector<Led>(1, createLed(a[0], a[1], a[2], a[3])), true, 16);
+		const ColorRgb color = map.getMeanLedColor(image)[0];
+
+		if (color.red != 200 || color.green != 100 || color.blue != 50)
+		{
+			std::cerr << "Failed to keep the samples inside the led area " << a[0] << "-" << a[1] << "x" << a[2] << "-" << a[3] << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly kept the samples inside the led area " << a[0] << "-" << a[1] << "x" << a[2] << "-" << a[3] << std::endl;
+	}
+
+	return result;
+}
+
+int TC_SPARSE_SMALL_LEDS()
+{
+	int result = 0;
+
+	// the edge leds cover 4x2 and 4x3 pixels, only the led covering the whole screen is sampled
+	const Image<ColorRgb> image = createNoise(40, 20);
+	std::vector<Led> leds = createLeds();
+
+	std::vector<ColorRgb> full = ImageToLedsMap(image.width(), image.height(), 0, 0, leds, true, 0).getMeanLedColor(image);
+	std::vector<ColorRgb> sparse = ImageToLedsMap(image.width(), image.height(), 0, 0, leds, true, 64).getMeanLedColor(image);
+	full.pop_back();
+	sparse.pop_back();
+
+	if (!closeColors(full, sparse, 0))
+	{
+		std::cerr << "Failed to use every pixel of leds below the sample limit" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly used every pixel of leds below the sample limit" << std::endl;
+
+	return result;
+}
+
+int TC_SPARSE_SMOOTH()
+{
+	int result = 0;
+
+	Image<ColorRgb> image(320, 180);
+	for (unsigned y = 0; y < image.height(); ++y)
+	{
+		for (unsigned x = 0; x < image.width(); ++x)
+		{
+			image(x, y) = ColorRgb{uint8_t(x * 255 / 319), uint8_t(y * 255 / 179), uint8_t((x + y) * 255 / 498)};
+		}
+	}
+
+	const std::vector<Led> leds = createLeds();
+	const ImageToLedsMap full(image.width(), image.height(), 0, 0, leds, true, 0);
+	const ImageToLedsMap sparse(image.width(), image.height(), 0, 0, leds, true, 64);
+
+	// on a gradient the jitter within the cells only shifts the mean by a fraction of a cell
+	if (!closeColors(full.getMeanLedColor(image), sparse.getMeanLedColor(image), 4))
+	{
+		std::cerr << "Failed to approximate the mean of a gradient with the samples" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly approximated the mean of a gradient with the samples" << std::endl;
+
+	return result;
+}
+
+int TC_SPARSE_RAW_PARITY()
+{
+	int result = 0;
+
+	result |= testRawParity("YUYV (64 samples per led)", PIXELFORMAT_YUYV, 64);
+	result |= testRawParity("NV12 (64 samples per led)", PIXELFORMAT_NV12, 64);
+	result |= testRawParity("I420 (64 samples per led)", PIXELFORMAT_I420, 64);
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_RAW_PARITY();
+	result |= TC_SPARSE_DETERMINISTIC();
+	result |= TC_SPARSE_INSIDE_AREA();
+	result |= TC_SPARSE_SMALL_LEDS();
+	result |= TC_SPARSE_SMOOTH();
+	result |= TC_SPARSE_RAW_PARITY();
+
+	return result;
+}
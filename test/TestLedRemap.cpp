@@ -0,0 +1,217 @@
+// STL includes
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Hyperion includes
+#include <hyperion/LedRemap.h>
+#include <hyperion/LedString.h>
+
+static const ColorOrder ALL_ORDERS[] = { ORDER_RGB, ORDER_RBG, ORDER_GRB, ORDER_BRG, ORDER_GBR, ORDER_BGR };
+
+Led createLed(unsigned index, ColorOrder colorOrder, int clone = -1)
+{
+	Led led;
+	led.index = index;
+	led.minX_frac = 0.0;
+	led.maxX_frac = 1.0;
+	led.minY_frac = 0.0;
+	led.maxY_frac = 1.0;
+	led.clone = clone;
+	led.colorOrder = colorOrder;
+	return led;
+}
+
+std::vector<ColorRgb> createColors(size_t count)
+{
+	std::vector<ColorRgb> colors;
+	for (size_t i = 0; i < count; ++i)
+	{
+		colors.push_back(ColorRgb{uint8_t(3 * i + 1), uint8_t(3 * i + 2), uint8_t(3 * i + 3)});
+	}
+	return colors;
+}
+
+///
+/// The output stage as it has been done before the remap was compiled: insert the clones, swap the channels, pad with black
+///
+std::vector<ColorRgb> referenceRemap(const LedString& ledString, const LedString& ledStringClone, unsigned hwLedCount, std::vector<ColorRgb> ledBuffer)
+{
+	std::vector<ColorOrder> colorOrders;
+	for (const Led& led : ledString.leds())
+	{
+		colorOrders.push_back(led.colorOrder);
+	}
+
+	for (const Led& led : ledStringClone.leds())
+	{
+		ledBuffer.insert(ledBuffer.begin() + led.index, ledBuffer.at(led.clone));
+		colorOrders.insert(colorOrders.begin() + led.index, led.colorOrder);
+	}
+
+	for (size_t i = 0; i < ledBuffer.size(); ++i)
+	{
+		ColorRgb& color = ledBuffer[i];
+		switch (colorOrders[i])
+		{
+		case ORDER_RGB:
+			break;
+		case ORDER_BGR:
+			std::swap(color.red, color.blue);
+			break;
+		case ORDER_RBG:
+			std::swap(color.green, color.blue);
+			break;
+		case ORDER_GRB:
+			std::swap(color.red, color.green);
+			break;
+		case ORDER_GBR:
+			std::swap(color.red, color.green);
+			std::swap(color.green, color.blue);
+			break;
+		case ORDER_BRG:
+			std::swap(color.red, color.blue);
+			std::swap(color.green, color.blue);
+			break;
+		}
+	}
+
+	if (hwLedCount > ledBuffer.size())
+	{
+		ledBuffer.resize(hwLedCount, ColorRgb::BLACK);
+	}
+
+	return ledBuffer;
+}
+
+bool equalColors(const std::vector<ColorRgb>& a, const std::vector<ColorRgb>& b)
+{
+	if (a.size() != b.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		if (a[i].red != b[i].red || a[i].green != b[i].green || a[i].blue != b[i].blue)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int TC_UNIFORM_ORDERS()
+{
+	int result = 0;
+
+	for (const ColorOrder order : ALL_ORDERS)
+	{
+		LedString ledString;
+		for (unsigned i = 0; i < 8; ++i)
+		{
+			ledString.leds().push_back(createLed(i, order));
+		}
+
+		const std::vector<ColorRgb> colors = createColors(8);
+		std::vector<ColorRgb> output;
+		LedRemap(ledString, LedString(), 8).apply(colors, output);
+
+		if (!equalColors(output, referenceRemap(ledString, LedString(), 8, colors)))
+		{
+			std::cerr << "Failed to remap the color order " << colorOrderToString(order).toStdString() << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly remapped the color order " << colorOrderToString(order).toStdString() << std::endl;
+	}
+
+	return result;
+}
+
+int TC_MIXED_ORDERS()
+{
+	int result = 0;
+
+	LedString ledString;
+	for (unsigned i = 0; i < 12; ++i)
+	{
+		ledString.leds().push_back(createLed(i, ALL_ORDERS[i % 6]));
+	}
+
+	const std::vector<ColorRgb> colors = createColors(12);
+	std::vector<ColorRgb> output;
+	LedRemap(ledString, LedString(), 12).apply(colors, output);
+
+	if (!equalColors(output, referenceRemap(ledString, LedString(), 12, colors)))
+	{
+		std::cerr << "Failed to remap leds with different color orders" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly remapped leds with different color orders" << std::endl;
+
+	return result;
+}
+
+int TC_CLONES_AND_PADDING()
+{
+	int result = 0;
+
+	for (const ColorOrder cloneOrder : ALL_ORDERS)
+	{
+		LedString ledString;
+		for (unsigned i = 0; i < 6; ++i)
+		{
+			ledString.leds().push_back(createLed(i, ORDER_GRB));
+		}
+
+		// clones at the start, in the middle, of an earlier clone and at the end
+		LedString ledStringClone;
+		ledStringClone.leds().push_back(createLed(0, cloneOrder, 5));
+		ledStringClone.leds().push_back(createLed(3, cloneOrder, 1));
+		ledStringClone.leds().push_back(createLed(4, ORDER_GRB, 0));
+		ledStringClone.leds().push_back(createLed(9, cloneOrder, 2));
+
+		const std::vector<ColorRgb> colors = createColors(6);
+		std::vector<ColorRgb> output;
+		LedRemap(ledString, ledStringClone, 14).apply(colors, output);
+
+		if (!equalColors(output, referenceRemap(ledString, ledStringClone, 14, colors)))
+		{
+			std::cerr << "Failed to insert clones with the color order " << colorOrderToString(cloneOrder).toStdString() << " and pad the hardware leds" << std::endl;
+			result = -1;
+		}
+		else std::cout << "Correctly inserted clones with the color order " << colorOrderToString(cloneOrder).toStdString() << " and padded the hardware leds" << std::endl;
+	}
+
+	return result;
+}
+
+int TC_PASS_THROUGH()
+{
+	int result = 0;
+
+	const std::vector<ColorRgb> colors = createColors(5);
+	std::vector<ColorRgb> output;
+	LedRemap().apply(colors, output);
+
+	if (!equalColors(output, colors))
+	{
+		std::cerr << "Failed to pass the leds through an unconfigured remap" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly passed the leds through an unconfigured remap" << std::endl;
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_UNIFORM_ORDERS();
+	result |= TC_MIXED_ORDERS();
+	result |= TC_CLONES_AND_PADDING();
+	result |= TC_PASS_THROUGH();
+
+	return result;
+}
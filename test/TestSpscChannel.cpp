@@ -0,0 +1,197 @@
+// STL includes
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Utils includes
+#include <utils/SpscChannel.h>
+
+int TC_QUEUE_ORDER()
+{
+	int result = 0;
+
+	// the capacity is rounded up to 4
+	SpscChannel<int> channel(SpscChannel<int>::QUEUE, 3);
+
+	bool pushed = true;
+	for (int i = 0; i < 4; ++i)
+	{
+		pushed &= channel.push(i);
+	}
+
+	if (!pushed || channel.push(4) || channel.takeDropped() != 1)
+	{
+		std::cerr << "Failed to queue up to the capacity and drop the next value" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly queued up to the capacity and dropped the next value" << std::endl;
+
+	int value = -1;
+	bool ordered = true;
+	for (int i = 0; i < 4; ++i)
+	{
+		ordered &= channel.pop(value) && value == i;
+	}
+
+	if (!ordered || channel.pop(value))
+	{
+		std::cerr << "Failed to deliver the queued values in order" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly delivered the queued values in order" << std::endl;
+
+	return result;
+}
+
+int TC_LATEST_OVERWRITE()
+{
+	int result = 0;
+
+	SpscChannel<int> channel(SpscChannel<int>::LATEST);
+
+	int value = -1;
+	if (channel.pop(value))
+	{
+		std::cerr << "Failed to report an empty channel" << std::endl;
+		result = -1;
+	}
+
+	channel.push(1);
+	channel.push(2);
+	channel.push(3);
+
+	if (!channel.pop(value) || value != 3 || channel.takeDropped() != 2 || channel.pop(value))
+	{
+		std::cerr << "Failed to deliver the newest value and count the overwritten ones" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly delivered the newest value and counted the overwritten ones" << std::endl;
+
+	return result;
+}
+
+int TC_BUFFER_RECYCLING()
+{
+	int result = 0;
+
+	SpscChannel<std::vector<int>> channel(SpscChannel<std::vector<int>>::QUEUE, 1);
+
+	// the consumer gets the value by swapping, its old buffer goes back into the slot
+	std::vector<int> consumed(16, 7);
+	const int* consumedBuffer = consumed.data();
+	channel.write([](std::vector<int>& slot) { slot.assign(4, 1); });
+	channel.pop(consumed);
+
+	bool recycled = false;
+	channel.write([&](std::vector<int>& slot) { recycled = (slot.data() == consumedBuffer); slot.assign(4, 2); });
+
+	if (consumed != std::vector<int>(4, 1) || !recycled)
+	{
+		std::cerr << "Failed to swap the value out and recycle the buffer of the consumer" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly swapped the value out and recycled the buffer of the consumer" << std::endl;
+
+	return result;
+}
+
+int TC_THREADED_QUEUE()
+{
+	int result = 0;
+
+	const int count = 1000000;
+	SpscChannel<int> channel(SpscChannel<int>::QUEUE, 64);
+
+	std::thread producer([&channel, count]
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			while (!channel.push(i))
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	int expected = 0;
+	bool ordered = true;
+	while (expected < count)
+	{
+		int value = -1;
+		if (channel.pop(value))
+		{
+			ordered &= (value == expected);
+			++expected;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	producer.join();
+
+	if (!ordered)
+	{
+		std::cerr << "Failed to hand over the values between two threads in order" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly handed over the values between two threads in order" << std::endl;
+
+	return result;
+}
+
+int TC_THREADED_LATEST()
+{
+	int result = 0;
+
+	const int count = 1000000;
+	SpscChannel<int> channel(SpscChannel<int>::LATEST);
+
+	std::thread producer([&channel, count]
+	{
+		for (int i = 1; i <= count; ++i)
+		{
+			channel.push(i);
+		}
+	});
+
+	// the values may be skipped, but never go back
+	int last = 0;
+	bool increasing = true;
+	while (last < count)
+	{
+		int value = 0;
+		if (channel.pop(value))
+		{
+			increasing &= (value > last);
+			last = value;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	producer.join();
+
+	if (!increasing)
+	{
+		std::cerr << "Failed to deliver only newer values between two threads" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly delivered only newer values between two threads" << std::endl;
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_QUEUE_ORDER();
+	result |= TC_LATEST_OVERWRITE();
+	result |= TC_BUFFER_RECYCLING();
+	result |= TC_THREADED_QUEUE();
+	result |= TC_THREADED_LATEST();
+
+	return result;
+}
@@ -0,0 +1,214 @@
+// STL includes
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+// Qt includes
+#include <QByteArray>
+
+// Webserver includes
+#include <webserver/WebSocketDeflate.h>
+
+#ifdef HAVE_ZLIB
+
+int testNegotiate(const char* offers, const WebSocketDeflate::Settings& settings, const char* expected)
+{
+	std::unique_ptr<WebSocketDeflate> deflate(WebSocketDeflate::negotiate(QByteArray(offers), settings));
+	const bool negotiated = (deflate != nullptr);
+
+	if (negotiated != (expected != nullptr) || (negotiated && deflate->getResponse() != expected))
+	{
+		std::cerr << "Failed to negotiate '" << offers << "'" << std::endl;
+		return -1;
+	}
+
+	std::cout << "Correctly negotiated '" << offers << "' to '" << (negotiated ? expected : "none") << "'" << std::endl;
+	return 0;
+}
+
+int TC_NEGOTIATE()
+{
+	int result = 0;
+
+	WebSocketDeflate::Settings settings;
+
+	result |= testNegotiate("permessage-deflate", settings, "permessage-deflate");
+	result |= testNegotiate("permessage-deflate; client_max_window_bits", settings, "permessage-deflate");
+	result |= testNegotiate("permessage-deflate; server_no_context_takeover; client_no_context_takeover", settings,
+		"permessage-deflate; server_no_context_takeover; client_no_context_takeover");
+
+	// the first valid offer wins, a window of 8 bits isn't supported by zlib
+	result |= testNegotiate("x-webkit-deflate-frame, permessage-deflate; server_max_window_bits=8, permessage-deflate; server_max_window_bits=\"10\"", settings,
+		"permessage-deflate; server_max_window_bits=10");
+
+	result |= testNegotiate("permessage-deflate; unknown_parameter", settings, nullptr);
+	result |= testNegotiate("permessage-deflate; server_max_window_bits", settings, nullptr);
+	result |= testNegotiate("permessage-deflate; client_max_window_bits=16", settings, nullptr);
+	result |= testNegotiate("x-webkit-deflate-frame", settings, nullptr);
+	result |= testNegotiate("", settings, nullptr);
+
+	settings.contextTakeover = false;
+	result |= testNegotiate("permessage-deflate", settings, "permessage-deflate; server_no_context_takeover; client_no_context_takeover");
+
+	settings.enabled = false;
+	result |= testNegotiate("permessage-deflate", settings, nullptr);
+
+	return result;
+}
+
+///
+/// A json like message, which compresses well but not trivially
+///
+QByteArray createMessage(int size)
+{
+	const char alphabet[] = "{\"leds\":[0,12,255],}";
+	QByteArray message;
+	for (int i = 0; i < size; ++i)
+	{
+		message += char(alphabet[rand() % (sizeof(alphabet) - 1)] + ((rand() % 50 == 0) ? rand() % 20 : 0));
+	}
+	return message;
+}
+
+int testRoundTrip(const char* offers, bool contextTakeover)
+{
+	WebSocketDeflate::Settings settings;
+	settings.contextTakeover = contextTakeover;
+
+	// the second extension takes the part of the client, which decompresses the messages of the server
+	std::unique_ptr<WebSocketDeflate> server(WebSocketDeflate::negotiate(QByteArray(offers), settings));
+	std::unique_ptr<WebSocketDeflate> client(WebSocketDeflate::negotiate(QByteArray(offers), settings));
+	if (!server || !client)
+	{
+		std::cerr << "Failed to negotiate '" << offers << "' for a round trip" << std::endl;
+		return -1;
+	}
+
+	bool equal = true;
+	for (const int size : { 0, 1, 100, 5000, 300000, 17, 70000 })
+	{
+		const QByteArray message = createMessage(size);
+		QByteArray compressed, decompressed;
+		equal &= server->compress(message, compressed)
+			&& client->decompress(compressed, decompressed) == WebSocketDeflate::DECOMPRESS_OK
+			&& decompressed == message;
+	}
+
+	if (!equal)
+	{
+		std::cerr << "Failed to compress and decompress messages with '" << offers << "'" << (contextTakeover ? "" : " without context takeover") << std::endl;
+		return -1;
+	}
+
+	std::cout << "Correctly compressed and decompressed messages with '" << offers << "'" << (contextTakeover ? "" : " without context takeover") << std::endl;
+	return 0;
+}
+
+int TC_ROUND_TRIP()
+{
+	int result = 0;
+
+	result |= testRoundTrip("permessage-deflate", true);
+	result |= testRoundTrip("permessage-deflate", false);
+	result |= testRoundTrip("permessage-deflate; server_max_window_bits=9", true);
+
+	return result;
+}
+
+int TC_INVALID()
+{
+	int result = 0;
+
+	std::unique_ptr<WebSocketDeflate> deflate(WebSocketDeflate::negotiate(QByteArray("permessage-deflate"), WebSocketDeflate::Settings()));
+	QByteArray data("\xff\xff\xff\xff not deflate data");
+	QByteArray out;
+
+	if (deflate->decompress(data, out) != WebSocketDeflate::DECOMPRESS_INVALID)
+	{
+		std::cerr << "Failed to reject invalid deflate data" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly rejected invalid deflate data" << std::endl;
+
+	return result;
+}
+
+int TC_TOO_LARGE()
+{
+	int result = 0;
+
+	WebSocketDeflate::Settings settings;
+	settings.contextTakeover = false;
+	std::unique_ptr<WebSocketDeflate> server(WebSocketDeflate::negotiate(QByteArray("permessage-deflate"), settings));
+	std::unique_ptr<WebSocketDeflate> client(WebSocketDeflate::negotiate(QByteArray("permessage-deflate"), settings));
+
+	// zeros compress to a few KB, the limit holds regardless of the compressed size
+	QByteArray compressed, decompressed;
+	server->compress(QByteArray(WebSocketDeflate::MAX_MESSAGE_SIZE, '\0'), compressed);
+	const bool maxAccepted = client->decompress(compressed, decompressed) == WebSocketDeflate::DECOMPRESS_OK && decompressed.size() == WebSocketDeflate::MAX_MESSAGE_SIZE;
+
+	server->compress(QByteArray(WebSocketDeflate::MAX_MESSAGE_SIZE + 1, '\0'), compressed);
+	const bool largerRejected = client->decompress(compressed, decompressed) == WebSocketDeflate::DECOMPRESS_TOO_LARGE && decompressed.isEmpty();
+
+	if (!maxAccepted || !largerRejected)
+	{
+		std::cerr << "Failed to limit the size of a decompressed message" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly limited the size of a decompressed message" << std::endl;
+
+	return result;
+}
+
+int TC_THRESHOLD()
+{
+	int result = 0;
+
+	WebSocketDeflate::Settings settings;
+	settings.threshold = 100;
+	std::unique_ptr<WebSocketDeflate> deflate(WebSocketDeflate::negotiate(QByteArray("permessage-deflate"), settings));
+
+	if (deflate->shouldCompress(99) || !deflate->shouldCompress(100))
+	{
+		std::cerr << "Failed to apply the compression threshold" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly applied the compression threshold" << std::endl;
+
+	return result;
+}
+
+#else
+
+int TC_WITHOUT_ZLIB()
+{
+	int result = 0;
+
+	if (WebSocketDeflate::negotiate(QByteArray("permessage-deflate"), WebSocketDeflate::Settings()) != nullptr)
+	{
+		std::cerr << "Failed to decline the compression without zlib" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly declined the compression without zlib" << std::endl;
+
+	return result;
+}
+
+#endif
+
+int main()
+{
+	int result = 0;
+
+#ifdef HAVE_ZLIB
+	result |= TC_NEGOTIATE();
+	result |= TC_ROUND_TRIP();
+	result |= TC_INVALID();
+	result |= TC_TOO_LARGE();
+	result |= TC_THRESHOLD();
+#else
+	result |= TC_WITHOUT_ZLIB();
+#endif
+
+	return result;
+}